@@ -98,3 +98,391 @@ testF(FaceFixture, Face_InterestNack)
   }
   assertEqual(static_cast<int>(consumer.getResult()), static_cast<int>(ndn::SimpleConsumer::Result::NACK));
 }
+
+class LpCollector : public ndn::PacketHandler
+{
+private:
+  bool
+  processData(const ndn::DataLite& data, uint64_t endpointId) override
+  {
+    const ndn::BlobLite& content = data.getContent();
+    this->content.assign(content.buf(), content.buf() + content.size());
+    ++nData;
+    return true;
+  }
+
+  bool
+  processNack(const ndn::NetworkNackLite& nackHeader, const ndn::InterestLite& interest,
+              uint64_t endpointId) override
+  {
+    nackReason = nackHeader.getReason();
+    ++nNacks;
+    return true;
+  }
+
+public:
+  std::vector<uint8_t> content;
+  int nData = 0;
+  int nNacks = 0;
+  int nackReason = 0;
+};
+
+testF(FaceFixture, Face_VirtualClock)
+{
+  ndn::VirtualClock clock(0xFFFFFE00ULL * 1000); // millis wraps soon on 32-bit platforms
+  ClockGuard guard(clock);
+
+  ndn::Deadline unset;
+  assertFalse(unset.hasExpired());
+  ndn::Deadline deadline = ndn::Deadline::in(0x300);
+  assertFalse(deadline.hasExpired());
+  clock.advance(0x2FF * 1000);
+  assertFalse(deadline.hasExpired());
+  assertEqual(deadline.remaining(), 1L);
+  clock.advance(1000);
+  assertTrue(deadline.hasExpired());
+
+  ndn::InterestWCB<2, 0> interest;
+  interest.getName().append("B");
+  faceA->enableNack(false);
+  ndn::SimpleConsumer consumer(*faceB, interest, 1000);
+  consumer.sendInterest();
+  this->loops();
+  clock.advance(999 * 1000);
+  assertEqual(static_cast<int>(consumer.getResult()), static_cast<int>(ndn::SimpleConsumer::Result::NONE));
+  clock.advance(1000);
+  assertEqual(static_cast<int>(consumer.getResult()), static_cast<int>(ndn::SimpleConsumer::Result::TIMEOUT));
+}
+
+test(Face_LpFragmentation)
+{
+  ndn::DigestKey key;
+  FrameLink linkA, linkB;
+  linkA.mtu = 200;
+  ndn::Face faceA(linkA), faceB(linkB);
+  faceA.setSigningKey(key);
+  faceB.enableReassembly({});
+  LpCollector collector;
+  faceB.addHandler(&collector);
+
+  std::vector<uint8_t> payload(1000);
+  for (size_t i = 0; i < payload.size(); ++i) {
+    payload[i] = static_cast<uint8_t>(i * 5);
+  }
+  ndn::DataWCB<2, 0> data;
+  data.getName().append("A");
+  data.setContent(ndn::BlobLite(payload.data(), payload.size()));
+  assertEqual(faceA.sendData(data), NDN_ERROR_success);
+  assertEqual(linkA.txFrames.size(), 6U);
+  for (const auto& frame : linkA.txFrames) {
+    assertLessOrEqual(frame.second.size(), 200U);
+  }
+
+  // fragments arrive out of order, with a duplicate
+  linkA.deliverTo(linkB, {5, 3, 4, 3, 0, 2, 1});
+  faceB.loop();
+  assertEqual(collector.nData, 1);
+  assertTrue(collector.content == payload);
+  assertEqual(faceB.getReassembler()->getCounters().nReassembled, 1U);
+  assertEqual(faceB.getReassembler()->getCounters().nDupFrags, 1U);
+
+  // Nack header travels in the first fragment
+  linkA.txFrames.clear();
+  linkA.mtu = 60;
+  ndn::InterestWCB<2, 0> interest;
+  interest.getName().append("A");
+  interest.getName().append(payload.data(), 80);
+  ndn::NetworkNackLite nack;
+  nack.setReason(ndn_NetworkNackReason_CONGESTION);
+  assertEqual(faceA.sendNack(nack, interest), NDN_ERROR_success);
+  assertMore(linkA.txFrames.size(), 2U);
+  for (size_t i = linkA.txFrames.size(); i > 0; --i) {
+    linkA.deliverTo(linkB, {static_cast<int>(i - 1)});
+  }
+  faceB.loop();
+  assertEqual(collector.nNacks, 1);
+  assertEqual(collector.nackReason, static_cast<int>(ndn_NetworkNackReason_CONGESTION));
+
+  // without reassembly, fragments are dropped
+  ndn::Face faceC(linkB);
+  faceC.addHandler(&collector);
+  linkA.deliverTo(linkB, {0, 1, 2});
+  faceC.loop();
+  assertEqual(collector.nNacks, 1);
+  assertTrue(linkB.rxFrames.empty());
+}
+
+test(Face_TxQueue)
+{
+  ndn::VirtualClock clock(0);
+  ClockGuard guard(clock);
+  ndn::DigestKey key;
+  FrameLink linkA, linkB;
+  linkA.airtime = 100;
+  ndn::Face faceA(linkA), faceB(linkB);
+  faceA.setSigningKey(key);
+  faceA.enableTxQueue();
+  LpCollector collector;
+  faceB.addHandler(&collector);
+
+  ndn::NameWCB<1> prefix;
+  prefix.append("A");
+  ndn::SimpleProducer producer(faceA, prefix,
+    [] (ndn::SimpleProducer::Context& ctx, const ndn::InterestLite& interest) {
+      ndn::DataWCB<2, 0> data;
+      data.setName(interest.getName());
+      return ctx.sendData(data) == NDN_ERROR_success;
+    });
+
+  for (uint8_t i = 0; i < 4; ++i) {
+    ndn::InterestWCB<2, 0> interest;
+    interest.getName().append("A");
+    interest.getName().append(&i, 1);
+    assertEqual(faceB.sendInterest(interest), NDN_ERROR_success);
+  }
+  linkB.deliverTo(linkA, {0, 1, 2, 3});
+
+  // all Interests are processed while the first Data is on the air
+  faceA.loop(4);
+  assertTrue(linkA.rxFrames.empty());
+  assertEqual(linkA.txFrames.size(), 1U);
+  assertEqual(faceA.getTxQueue()->size(), 4U);
+
+  for (int i = 0; i < 4; ++i) {
+    clock.advance(100000);
+    faceA.loop();
+  }
+  assertEqual(linkA.nOverlaps, 0);
+  assertEqual(linkA.txFrames.size(), 4U);
+  assertEqual(faceA.getTxQueue()->size(), 0U);
+  assertEqual(faceA.getTxQueue()->getCounters().nSent, 4U);
+
+  linkA.deliverTo(linkB, {0, 1, 2, 3});
+  faceB.loop(4);
+  assertEqual(collector.nData, 4);
+}
+
+test(Face_BleLink)
+{
+  ndn::DigestKey key;
+  FrameLink linkA, linkB; // characteristics with negotiated ATT payload size
+  linkA.mtu = linkB.mtu = 244;
+  ndn::BleLink bleA(linkA), bleB(linkB);
+  assertEqual(bleA.getMtu(), 244U);
+  ndn::Face faceA(bleA), faceB(bleB);
+  faceA.setSigningKey(key);
+  faceB.enableReassembly({});
+  LpCollector collector;
+  faceB.addHandler(&collector);
+
+  // small packets are coalesced into frames no larger than MTU
+  for (uint8_t i = 0; i < 8; ++i) {
+    ndn::DataWCB<2, 0> data;
+    data.getName().append("A");
+    data.getName().append(&i, 1);
+    assertEqual(faceA.sendData(data), NDN_ERROR_success);
+  }
+  // a large packet is fragmented, and its fragments are batched too
+  std::vector<uint8_t> payload(600);
+  for (size_t i = 0; i < payload.size(); ++i) {
+    payload[i] = static_cast<uint8_t>(i * 3);
+  }
+  ndn::DataWCB<2, 0> data;
+  data.getName().append("B");
+  data.setContent(ndn::BlobLite(payload.data(), payload.size()));
+  assertEqual(faceA.sendData(data), NDN_ERROR_success);
+  assertEqual(bleA.flush(), NDN_ERROR_success);
+
+  const auto& cntA = bleA.getCounters();
+  // 8 small Data fit in 2 frames, followed by 3 fragments that each fill a frame;
+  // every frame except the last is sent because the next packet does not fit
+  assertEqual(cntA.nTxPkts, 8U + 3U);
+  assertEqual(cntA.nTxFrames, 2U + 3U);
+  assertEqual(cntA.nFlushFull, 4U);
+  assertEqual(cntA.nFlushOther, 1U);
+  assertEqual(cntA.nTxFrames, static_cast<uint32_t>(linkA.txFrames.size()));
+  for (const auto& frame : linkA.txFrames) {
+    assertLessOrEqual(frame.second.size(), 244U);
+  }
+
+  for (size_t i = 0; i < linkA.txFrames.size(); ++i) {
+    linkA.deliverTo(linkB, {static_cast<int>(i)});
+  }
+  faceB.loop(static_cast<int>(cntA.nTxPkts));
+  assertEqual(collector.nData, 9);
+  assertTrue(collector.content == payload);
+  assertEqual(bleB.getRxCounters().nRxFrames, cntA.nTxFrames);
+  assertEqual(bleB.getRxCounters().nRxPkts, cntA.nTxPkts);
+  assertEqual(bleB.getRxCounters().nRxErrors, 0U);
+
+  // a truncated element is discarded along with the rest of its frame
+  linkB.rxFrames.emplace_back(0, std::vector<uint8_t>{0x06, 0x10, 0x07, 0x00});
+  faceB.loop();
+  assertEqual(bleB.getRxCounters().nRxErrors, 1U);
+}
+
+class BundleCollector : public ndn::PacketHandler
+{
+public:
+  explicit
+  BundleCollector(ndn::Face& face)
+    : face(face)
+  {
+  }
+
+  ~BundleCollector() override
+  {
+    // Face must not delete replacementPb
+    ndn::PacketBuffer* pb = face.swapPacketBuffer(nullptr);
+    if (pb != &replacementPb) {
+      face.swapPacketBuffer(pb);
+    }
+    delete keptPb;
+  }
+
+private:
+  bool
+  processInterest(const ndn::InterestLite& interest, uint64_t endpointId) override
+  {
+    const ndn::BlobLite& comp = interest.getName().get(-1).getValue();
+    seqs.push_back(comp.buf()[0]);
+    endpointIds.push_back(endpointId);
+    if (seqs.size() == 2) { // retain packet buffer in the middle of a bundle
+      keptPb = face.swapPacketBuffer(&replacementPb);
+    }
+    return true;
+  }
+
+public:
+  ndn::Face& face;
+  std::vector<uint8_t> seqs;
+  std::vector<uint64_t> endpointIds;
+  ndn::PacketBuffer replacementPb{{}};
+  ndn::PacketBuffer* keptPb = nullptr;
+};
+
+test(Face_Bundler)
+{
+  ndn::VirtualClock clock(0);
+  ClockGuard guard(clock);
+  FrameLink linkA, linkB;
+  ndn::Bundler::Options opts;
+  opts.maxFrameSize = 100;
+  opts.maxDelay = 1000;
+  ndn::Bundler bundler(linkA, opts);
+  ndn::Face faceA(bundler), faceB(linkB);
+  faceB.enableNack(false);
+  BundleCollector collector(faceB);
+  faceB.addHandler(&collector);
+
+  // packets are held until maxDelay
+  for (uint8_t i = 0; i < 4; ++i) {
+    ndn::InterestWCB<2, 0> interest;
+    interest.getName().append("A");
+    interest.getName().append(&i, 1);
+    assertEqual(faceA.sendInterest(interest, 7), NDN_ERROR_success);
+  }
+  faceA.loop();
+  assertEqual(linkA.txFrames.size(), 0U);
+  clock.advance(999);
+  faceA.loop();
+  assertEqual(linkA.txFrames.size(), 0U);
+  clock.advance(1);
+  faceA.loop();
+  assertEqual(linkA.txFrames.size(), 1U);
+  assertEqual(linkA.txFrames[0].first, 7ULL);
+
+  // a full frame is sent immediately, and another endpoint starts a new frame
+  for (uint8_t i = 4; i < 16; ++i) {
+    ndn::InterestWCB<2, 0> interest;
+    interest.getName().append("A");
+    interest.getName().append(&i, 1);
+    assertEqual(faceA.sendInterest(interest, i < 15 ? 7 : 8), NDN_ERROR_success);
+  }
+  assertEqual(bundler.flush(), NDN_ERROR_success);
+  const auto& cnt = bundler.getCounters();
+  assertEqual(cnt.nTxPkts, 16U);
+  assertEqual(cnt.nTxFrames, static_cast<uint32_t>(linkA.txFrames.size()));
+  assertEqual(cnt.nFlushDelay, 1U);
+  assertMoreOrEqual(cnt.nFlushFull, 1U);
+  assertEqual(cnt.nFlushOther, 2U);
+  assertMore(cnt.getPktsPerFrame(), 3.0);
+  for (const auto& frame : linkA.txFrames) {
+    assertLessOrEqual(frame.second.size(), 100U);
+  }
+
+  // receiving Face unbundles in PacketBuffer, even if the buffer is swapped mid-bundle
+  for (const auto& frame : linkA.txFrames) {
+    linkB.rxFrames.push_back(frame);
+  }
+  faceB.loop(32);
+  assertEqual(collector.seqs.size(), 16U);
+  for (uint8_t i = 0; i < 16; ++i) {
+    assertEqual(collector.seqs[i], i);
+    assertEqual(collector.endpointIds[i], i < 15 ? 7ULL : 8ULL);
+  }
+}
+
+test(Face_PaddedFrame)
+{
+  FrameLink linkA, linkB;
+  ndn::Face faceA(linkA), faceB(linkB);
+  faceB.enableNack(false);
+  BundleCollector collector(faceB);
+  faceB.addHandler(&collector);
+
+  // Ethernet pads short frames to 46 octets; padding is not a bundle
+  for (uint8_t i = 0; i < 3; ++i) {
+    ndn::InterestWCB<2, 0> interest;
+    interest.getName().append("A");
+    interest.getName().append(&i, 1);
+    assertEqual(faceA.sendInterest(interest), NDN_ERROR_success);
+    std::vector<uint8_t> frame = linkA.txFrames.back().second;
+    assertLess(frame.size(), 46U);
+    frame.resize(46);
+    linkB.rxFrames.emplace_back(0, frame);
+  }
+  faceB.loop(4);
+  assertEqual(collector.seqs.size(), 3U);
+  for (uint8_t i = 0; i < 3; ++i) {
+    assertEqual(collector.seqs[i], i);
+  }
+}
+
+test(PacketBuffer_LpSequence)
+{
+  FrameLink link;
+  ndn::Face face(link);
+  ndn::InterestWCB<2, 0> interest;
+  interest.getName().append("A");
+  assertEqual(face.sendInterest(interest), NDN_ERROR_success);
+  const std::vector<uint8_t>& wire = link.txFrames.at(0).second;
+
+  // LpPacket with Sequence and FragCount=1 carries a whole packet
+  std::vector<uint8_t> lp{0x64, static_cast<uint8_t>(18 + wire.size()),
+                          0x51, 0x08, 0, 0, 0, 0, 0, 0, 0x01, 0x02, 0x53, 0x01, 0x01,
+                          0x50, static_cast<uint8_t>(wire.size())};
+  lp.insert(lp.end(), wire.begin(), wire.end());
+  lp[1] = static_cast<uint8_t>(lp.size() - 2);
+
+  ndn::PacketBuffer pb({});
+  uint8_t* buf;
+  size_t bufSize;
+  std::tie(buf, bufSize) = pb.useBuffer();
+  std::copy(lp.begin(), lp.end(), buf);
+  assertEqual(pb.parse(lp.size()), NDN_ERROR_success);
+  assertTrue(pb.getLpFragment() == nullptr);
+  assertEqual(static_cast<int>(pb.getPktType()), static_cast<int>(ndn::PacketType::INTEREST));
+  assertEqual(pb.getInterest()->getName().size(), 1U);
+
+  // FragCount=2 is a fragment to be reassembled
+  lp[14] = 0x02;
+  std::tie(buf, bufSize) = pb.useBuffer();
+  std::copy(lp.begin(), lp.end(), buf);
+  assertEqual(pb.parse(lp.size()), NDN_ERROR_success);
+  assertEqual(static_cast<int>(pb.getPktType()), static_cast<int>(ndn::PacketType::NONE));
+  assertTrue(pb.getLpFragment() != nullptr);
+  assertEqual(pb.getLpFragment()->seq, 0x0102U);
+  assertEqual(pb.getLpFragment()->fragCount, 2);
+  assertEqual(pb.getLpFragment()->payloadLen, wire.size());
+}
@@ -24,6 +24,28 @@ public:
     return sigLen;
   }
 
+  /** \brief Sign input with incremental API, in segments of \p segLen octets.
+   *  \retval -1 incremental signing is unsupported
+   */
+  int
+  signStream(const ndn::PrivateKey& key, size_t segLen = 5)
+  {
+    const uint8_t* input;
+    size_t inputLen;
+    std::tie(input, inputLen) = getInput();
+
+    if (!key.beginSign()) {
+      return -1;
+    }
+    for (size_t pos = 0; pos < inputLen; pos += segLen) {
+      key.updateSign(input + pos, std::min(segLen, inputLen - pos));
+    }
+    sig.resize(key.getMaxSigLength());
+    int sigLen = key.finishSign(sig.data());
+    sig.resize(sigLen);
+    return sigLen;
+  }
+
   String
   getSigHex() const
   {
@@ -40,6 +62,22 @@ public:
     return key.verify(input, inputLen, sig.data(), sig.size());
   }
 
+  bool
+  verifyStream(const ndn::PublicKey& key, size_t segLen = 5) const
+  {
+    const uint8_t* input;
+    size_t inputLen;
+    std::tie(input, inputLen) = getInput();
+
+    if (!key.beginVerify()) {
+      return false;
+    }
+    for (size_t pos = 0; pos < inputLen; pos += segLen) {
+      key.updateVerify(input + pos, std::min(segLen, inputLen - pos));
+    }
+    return key.finishVerify(sig.data(), sig.size());
+  }
+
   void
   modifySig()
   {
@@ -75,6 +113,19 @@ testF(KeyFixture, DigestKey_basic)
   assertFalse(this->verify(key));
 }
 
+testF(KeyFixture, DigestKey_stream)
+{
+  ndn::DigestKey key;
+  assertEqual(this->signStream(key), static_cast<int>(ndn_SHA256_DIGEST_SIZE));
+  assertEqual(this->getSigHex(),
+              F("EC41C17185C911F9F2FED2A8F6CC9E1AB4E9F06C7E62DD2E4BAEFC5B56596043"));
+  assertTrue(this->verifyStream(key));
+  assertTrue(this->verify(key));
+
+  this->modifySig();
+  assertFalse(this->verifyStream(key));
+}
+
 testF(KeyFixture, HmacKey_basic)
 {
   ndn::HmacKey key(reinterpret_cast<const uint8_t*>("secret"), 6);
@@ -89,6 +140,24 @@ testF(KeyFixture, HmacKey_basic)
   assertFalse(this->verify(key));
 }
 
+testF(KeyFixture, HmacKey_stream)
+{
+  ndn::HmacKey key(reinterpret_cast<const uint8_t*>("secret"), 6);
+  assertEqual(this->signStream(key, 1), static_cast<int>(ndn_SHA256_DIGEST_SIZE));
+  assertEqual(this->getSigHex(),
+              F("E6680A517902FF958545AF733359499BDC59FAB051FCFAC02A0F253C099DA12E"));
+  assertTrue(this->verifyStream(key));
+
+  // abandoned incremental operation does not affect the next one
+  assertTrue(key.beginSign());
+  key.updateSign(reinterpret_cast<const uint8_t*>("xyz"), 3);
+  assertTrue(this->verifyStream(key, 4));
+
+  this->modifySig();
+  assertFalse(this->verifyStream(key));
+  assertFalse(this->verify(key));
+}
+
 const uint8_t EcKey_basic_PVT[] PROGMEM {
   0xD7, 0xCB, 0xA5, 0xF4, 0xC6, 0x89, 0x3E, 0x56, 0x2B, 0xFA, 0xD1, 0x52, 0x8A, 0x8A, 0xCD, 0x4C,
   0x29, 0x3C, 0xCA, 0xC1, 0x37, 0x7F, 0x87, 0x90, 0x9A, 0x14, 0x6E, 0xA0, 0x15, 0xD8, 0x88, 0x6E,
@@ -120,6 +189,29 @@ testF(KeyFixture, EcKey_basic)
   assertFalse(this->verify(pub));
 }
 
+testF(KeyFixture, EcKey_stream)
+{
+  ndn::NameWCB<1> name;
+  name.append("key");
+  ndn::EcPrivateKey pvt(name);
+  ndn::EcPublicKey pub;
+  assertFalse(pvt.beginSign());
+  assertFalse(pub.beginVerify());
+  assertTrue(pvt.import(EcKey_basic_PVT));
+  assertTrue(pub.import(EcKey_basic_PUB));
+
+  assertMore(this->signStream(pvt), 0);
+  assertTrue(this->verify(pub));
+  yield();
+
+  assertMore(this->sign(pvt), 0);
+  assertTrue(this->verifyStream(pub, 7));
+  yield();
+
+  this->modifySig();
+  assertFalse(this->verifyStream(pub));
+}
+
 const uint8_t EcKey_importCert_CERT[] PROGMEM {
   0x06, 0xfd, 0x02, 0x11, 0x07, 0x23, 0x08, 0x01, 0x41, 0x08, 0x03, 0x4b, 0x45, 0x59, 0x08, 0x08,
   0x27, 0x00, 0xee, 0x14, 0xa8, 0xb1, 0x33, 0x04, 0x08, 0x04, 0x73, 0x65, 0x6c, 0x66, 0x08, 0x09,
@@ -188,3 +280,93 @@ testF(KeyFixture, EcKey_generate)
   this->modifySig();
   assertFalse(this->verify(pub));
 }
+
+testF(KeyFixture, EcKey_noncePool)
+{
+  ndn::NameWCB<1> name;
+  name.append("key");
+  ndn::EcPrivateKey pvt(name);
+  ndn::EcPublicKey pub;
+  assertTrue(pvt.generate(pub));
+  assertFalse(pvt.precompute());
+  if (!pvt.enableNoncePool(2)) {
+    return; // not supported by crypto backend
+  }
+
+  FrameLink link;
+  ndn::Face face(link);
+  face.setSigningKey(pvt);
+  face.loop();
+  assertEqual(pvt.getNoncePoolCounters().depth, 1);
+  assertTrue(pvt.precompute());
+  assertFalse(pvt.precompute());
+  yield();
+
+  for (int i = 0; i < 3; ++i) {
+    assertMore(this->sign(pvt), 0);
+    assertTrue(this->verify(pub));
+    yield();
+  }
+
+  ndn::EcPrivateKey::NoncePoolCounters cnt = pvt.getNoncePoolCounters();
+  assertEqual(cnt.capacity, 2);
+  assertEqual(cnt.depth, 0);
+  assertEqual(cnt.nRefills, 2U);
+  assertEqual(cnt.nHits, 2U);
+  assertEqual(cnt.nMisses, 1U);
+  assertMore(cnt.getAvgRefillMicros(), 0.0f);
+}
+
+// RFC 8032 section 7.1 TEST 1
+const uint8_t Ed25519Key_basic_PVT[] PROGMEM {
+  0x9D, 0x61, 0xB1, 0x9D, 0xEF, 0xFD, 0x5A, 0x60, 0xBA, 0x84, 0x4A, 0xF4, 0x92, 0xEC, 0x2C, 0xC4,
+  0x44, 0x49, 0xC5, 0x69, 0x7B, 0x32, 0x69, 0x19, 0x70, 0x3B, 0xAC, 0x03, 0x1C, 0xAE, 0x7F, 0x60,
+};
+const uint8_t Ed25519Key_basic_PUB[] PROGMEM {
+  0xD7, 0x5A, 0x98, 0x01, 0x82, 0xB1, 0x0A, 0xB7, 0xD5, 0x4B, 0xFE, 0xD3, 0xC9, 0x64, 0x07, 0x3A,
+  0x0E, 0xE1, 0x72, 0xF3, 0xDA, 0xA6, 0x23, 0x25, 0xAF, 0x02, 0x1A, 0x68, 0xF7, 0x07, 0x51, 0x1A,
+};
+testF(KeyFixture, Ed25519Key_basic)
+{
+  ndn::NameWCB<1> name;
+  name.append("key");
+  ndn::Ed25519PrivateKey pvt(name);
+  ndn::Ed25519PublicKey pub;
+  assertEqual(pvt.getMaxSigLength(), 64U);
+
+  assertLessOrEqual(this->sign(pvt), 0);
+  assertTrue(pvt.import(Ed25519Key_basic_PVT));
+  assertEqual(this->sign(pvt), 64);
+  // echo -n 'yoursunny.com' | openssl pkeyutl -sign -rawin -inkey pvt.pem | xxd -p
+  assertEqual(this->getSigHex(),
+              F("6C828AD05A5958DE042565EC434CBCDC3AEE7C11D16D21DF28CCFEB7838DF227"
+                "1EB0CC0BFB277BBF1A6CC215AB265342115CE1803F24B7B75F3752D0CF4AD706"));
+  yield();
+
+  assertFalse(this->verify(pub));
+  assertTrue(pub.import(Ed25519Key_basic_PUB));
+  assertTrue(this->verify(pub));
+  yield();
+
+  this->modifySig();
+  assertFalse(this->verify(pub));
+}
+
+testF(KeyFixture, Ed25519Key_generate)
+{
+  ndn::NameWCB<1> name;
+  name.append("key");
+  ndn::Ed25519PrivateKey pvt(name);
+  ndn::Ed25519PublicKey pub;
+  assertTrue(pvt.generate(pub));
+  yield();
+
+  assertEqual(this->sign(pvt), 64);
+  yield();
+  assertTrue(this->verify(pub));
+  assertFalse(pvt.beginSign());
+  assertFalse(pub.beginVerify());
+  yield();
+  this->modifySig();
+  assertFalse(this->verify(pub));
+}
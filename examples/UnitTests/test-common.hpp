@@ -1,6 +1,7 @@
 #include <esp8266ndn.h>
 
 #include <AUnitVerbose.h>
+#include <vector>
 
 using namespace aunit;
 
@@ -27,3 +28,249 @@ toHexString(const uint8_t* input, size_t len)
   }
   return os.str;
 }
+
+/** \brief Installs a clock for the lifetime of this object.
+ */
+class ClockGuard
+{
+public:
+  explicit
+  ClockGuard(ndn::Clock& clock)
+    : m_prev(ndn::getClock())
+  {
+    ndn::setClock(clock);
+  }
+
+  ~ClockGuard()
+  {
+    ndn::setClock(m_prev);
+  }
+
+private:
+  ndn::Clock& m_prev;
+};
+
+/** \brief Simulates a link that delivers frames in a chosen order, possibly with losses.
+ *
+ *  If \c airtime is nonzero, it also emulates a radio whose send() returns before transmission
+ *  completes: isTxReady() is false for \c airtime millis after each send(), during which send()
+ *  fails and increments \c nOverlaps.
+ */
+class FrameLink : public ndn::Transport
+{
+public:
+  size_t
+  receive(uint8_t* buf, size_t bufSize, uint64_t& endpointId) override
+  {
+    if (rxFrames.empty()) {
+      return 0;
+    }
+    std::vector<uint8_t> frame = rxFrames.front().second;
+    endpointId = rxFrames.front().first;
+    rxFrames.erase(rxFrames.begin());
+    if (frame.size() > bufSize) {
+      return 0;
+    }
+    std::copy(frame.begin(), frame.end(), buf);
+    return frame.size();
+  }
+
+  ndn_Error
+  send(const uint8_t* pkt, size_t len, uint64_t endpointId) override
+  {
+    if (mtu > 0 && len > mtu) {
+      return NDN_ERROR_SocketTransport_error_in_send;
+    }
+    if (!isTxReady()) {
+      ++nOverlaps;
+      return NDN_ERROR_SocketTransport_error_in_send;
+    }
+    if (airtime > 0) {
+      txDone = ndn::Deadline::in(airtime);
+    }
+    txFrames.emplace_back(endpointId, std::vector<uint8_t>(pkt, pkt + len));
+    return NDN_ERROR_success;
+  }
+
+  bool
+  isTxReady() override
+  {
+    return !txDone.isSet() || txDone.hasExpired();
+  }
+
+  size_t
+  getMtu() const override
+  {
+    return mtu;
+  }
+
+  /** \brief deliver transmitted frames in the order given by \p order; omitted frames are lost
+   */
+  void
+  deliver(std::initializer_list<int> order)
+  {
+    for (int i : order) {
+      rxFrames.push_back(txFrames.at(i));
+    }
+  }
+
+  /** \brief deliver transmitted frames to \p other in the order given by \p order
+   */
+  void
+  deliverTo(FrameLink& other, std::initializer_list<int> order)
+  {
+    for (int i : order) {
+      other.rxFrames.push_back(txFrames.at(i));
+    }
+  }
+
+public:
+  size_t mtu = 0;
+  unsigned long airtime = 0; ///< TX busy period in millis
+  ndn::Deadline txDone;
+  int nOverlaps = 0;
+  typedef std::pair<uint64_t, std::vector<uint8_t>> Frame;
+  std::vector<Frame> txFrames;
+  std::vector<Frame> rxFrames;
+};
+
+/** \brief Simulates an Arduino LoRa radio.
+ *
+ *  An async transmission occupies the radio for its time-on-air under \c radio, measured with
+ *  getClock(). parsePacket() during a transmission aborts it, as the real radio would.
+ *  interruptRx() emulates a packet arrival in continuous RX mode.
+ */
+class MockLora
+{
+public:
+  int
+  beginPacket(int implicitHeader = 0)
+  {
+    if (txDone.isSet() && !txDone.hasExpired()) {
+      return 0;
+    }
+    m_tx.clear();
+    isContinuousRx = false;
+    return 1;
+  }
+
+  size_t
+  write(const uint8_t* buf, size_t len)
+  {
+    m_tx.insert(m_tx.end(), buf, buf + len);
+    return len;
+  }
+
+  int
+  endPacket(bool async = false)
+  {
+    txFrames.push_back(m_tx);
+    if (async) {
+      txDone = ndn::Deadline::in((radio.computeAirtime(m_tx.size()) + 999) / 1000);
+    }
+    return 1;
+  }
+
+  int
+  parsePacket()
+  {
+    ++nParsePacket;
+    if (txDone.isSet() && !txDone.hasExpired()) {
+      ++nAborts;
+      txDone.clear();
+    }
+    if (rxFrames.empty()) {
+      return 0;
+    }
+    m_rx = rxFrames.front();
+    rxFrames.erase(rxFrames.begin());
+    return m_rx.size();
+  }
+
+  size_t
+  readBytes(uint8_t* buf, size_t len)
+  {
+    len = std::min(len, m_rx.size());
+    std::copy_n(m_rx.begin(), len, buf);
+    m_rx.clear();
+    return len;
+  }
+
+  int
+  rssi()
+  {
+    // RSSI register is meaningless outside receive mode
+    return isContinuousRx ? channelRssi : -157;
+  }
+
+  void
+  onReceive(void (*callback)(int))
+  {
+    m_onReceive = callback;
+  }
+
+  void
+  receive(int size = 0)
+  {
+    isContinuousRx = true;
+  }
+
+  int
+  available()
+  {
+    return m_rx.size() - m_rxPos;
+  }
+
+  int
+  read()
+  {
+    return m_rxPos < m_rx.size() ? m_rx[m_rxPos++] : -1;
+  }
+
+  int
+  packetRssi()
+  {
+    return m_rxRssi;
+  }
+
+  float
+  packetSnr()
+  {
+    return m_rxSnr;
+  }
+
+  /** \brief emulate a packet arrival that invokes onReceive callback
+   *  \return whether the radio was in continuous RX mode
+   */
+  bool
+  interruptRx(const std::vector<uint8_t>& frame, int rssi, float snr)
+  {
+    if (!isContinuousRx || m_onReceive == nullptr) {
+      return false;
+    }
+    m_rx = frame;
+    m_rxPos = 0;
+    m_rxRssi = rssi;
+    m_rxSnr = snr;
+    m_onReceive(frame.size());
+    return true;
+  }
+
+public:
+  ndn::LoraRadioParams radio;
+  int channelRssi = -120;
+  ndn::Deadline txDone;
+  int nAborts = 0;
+  int nParsePacket = 0;
+  bool isContinuousRx = false;
+  std::vector<std::vector<uint8_t>> txFrames;
+  std::vector<std::vector<uint8_t>> rxFrames;
+
+private:
+  std::vector<uint8_t> m_tx;
+  std::vector<uint8_t> m_rx;
+  size_t m_rxPos = 0;
+  int m_rxRssi = 0;
+  float m_rxSnr = 0.0;
+  void (*m_onReceive)(int) = nullptr;
+};
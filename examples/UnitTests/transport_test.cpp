@@ -0,0 +1,1101 @@
+#include "test-common.hpp"
+#include <core/packet-buffer.hpp>
+#include <transport/detail/ble-impl.hpp>
+#include <transport/detail/pbuf-gather.hpp>
+#include <transport/detail/queue.hpp>
+#include <transport/endpoint-table.hpp>
+#include <transport/header-compressor.hpp>
+#include <transport/lite-frag.hpp>
+#include <transport/loopback-transport.hpp>
+#include <transport/lp-reliability.hpp>
+#include <transport/posix-ethernet-transport.hpp>
+#include <transport/posix-udp-transport.hpp>
+#include <transport/shm-transport.hpp>
+#include <transport/stream-transport.hpp>
+#include <transport/tx-queue.hpp>
+
+#if defined(__linux__)
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+test(SafeQueue_pushPop)
+{
+  ndn::detail::SafeQueue<int, 3> queue;
+  int item;
+  bool ok;
+  std::tie(item, ok) = queue.pop();
+  assertFalse(ok);
+
+  for (int round = 0; round < 4; ++round) {
+    assertTrue(queue.push(1));
+    assertTrue(queue.push(2));
+    assertTrue(queue.push(3));
+    assertFalse(queue.push(4));
+
+    for (int i = 1; i <= 3; ++i) {
+      std::tie(item, ok) = queue.pop();
+      assertTrue(ok);
+      assertEqual(item, i);
+    }
+    std::tie(item, ok) = queue.pop();
+    assertFalse(ok);
+  }
+}
+
+/** \brief Simulates a chain of lwIP pool pbufs.
+ */
+class PbufChain
+{
+public:
+  struct Pbuf
+  {
+    Pbuf* next;
+    void* payload;
+    uint16_t tot_len;
+    uint16_t len;
+  };
+
+  /** \brief split [0, totLen) into segments of \p segLen octets
+   */
+  PbufChain(uint16_t totLen, uint16_t segLen)
+    : data(totLen)
+    , pbufs((totLen + segLen - 1) / segLen)
+  {
+    for (uint16_t i = 0; i < totLen; ++i) {
+      data[i] = static_cast<uint8_t>(i * 7 + 1);
+    }
+    uint16_t offset = 0;
+    for (size_t i = 0; i < pbufs.size(); ++i) {
+      pbufs[i].next = i + 1 < pbufs.size() ? &pbufs[i + 1] : nullptr;
+      pbufs[i].payload = &data[offset];
+      pbufs[i].tot_len = totLen - offset;
+      pbufs[i].len = std::min<uint16_t>(segLen, totLen - offset);
+      offset += pbufs[i].len;
+    }
+  }
+
+public:
+  std::vector<uint8_t> data;
+  std::vector<Pbuf> pbufs;
+};
+
+test(PbufGather_chained)
+{
+  PbufChain chain(1514, 256);
+  assertEqual(chain.pbufs.size(), 6U);
+
+  std::vector<uint8_t> buf(1500);
+  for (size_t offset : {0, 14, 255, 256, 1000}) {
+    size_t len = chain.data.size() - offset;
+    buf.assign(buf.size(), 0);
+    size_t copied = ndn::detail::gatherPbuf(chain.pbufs.data(), offset, buf.data(), std::min(len, buf.size()));
+    assertEqual(copied, std::min(len, buf.size()));
+    assertTrue(std::equal(buf.begin(), buf.begin() + copied, chain.data.begin() + offset));
+  }
+
+  // chain shorter than requested
+  assertEqual(ndn::detail::gatherPbuf(chain.pbufs.data(), 1500, buf.data(), 100), 14U);
+}
+
+test(BleRxRing_burst)
+{
+  ndn::detail::BleServiceImpl impl;
+  uint8_t frame[BLE_RX_RING_SLOT_SIZE + 1] = {};
+  for (uint8_t i = 0; i < BLE_RX_RING_SLOTS + 2; ++i) {
+    frame[0] = i;
+    assertEqual(impl.deliver(frame, 100 + i), i < BLE_RX_RING_SLOTS);
+  }
+  assertFalse(impl.deliver(frame, sizeof(frame)));
+  assertEqual(impl.getRxCounters().nFrames, static_cast<uint32_t>(BLE_RX_RING_SLOTS));
+  assertEqual(impl.getRxCounters().nOverflows, 2U);
+  assertEqual(impl.getRxCounters().nOversized, 1U);
+
+  // burst is drained in order; a frame larger than receive buffer is skipped
+  uint8_t buf[BLE_RX_RING_SLOT_SIZE];
+  for (uint8_t i = 0; i < BLE_RX_RING_SLOTS - 1; ++i) {
+    assertEqual(impl.receive(buf, 100 + BLE_RX_RING_SLOTS - 2), 100U + i);
+    assertEqual(buf[0], i);
+  }
+  assertEqual(impl.receive(buf, 100 + BLE_RX_RING_SLOTS - 2), 0U);
+  assertEqual(impl.getRxCounters().nBufTooSmall, 1U);
+
+  // slots are reused after draining
+  for (uint8_t j = 0; j < 3 * BLE_RX_RING_SLOTS; ++j) {
+    frame[0] = j;
+    assertTrue(impl.deliver(frame, 20));
+    assertEqual(impl.receive(buf, sizeof(buf)), 20U);
+    assertEqual(buf[0], j);
+  }
+}
+
+static std::vector<uint8_t>
+makeLiteFragPayload(size_t len, uint8_t seed)
+{
+  std::vector<uint8_t> payload(len);
+  for (size_t i = 0; i < len; ++i) {
+    payload[i] = static_cast<uint8_t>(seed + i * 3);
+  }
+  return payload;
+}
+
+test(LiteFrag_reorder)
+{
+  FrameLink link;
+  ndn::LiteFrag frag(link);
+  frag.begin(200, 23, 2, 5000);
+  std::vector<uint8_t> buf(200);
+  uint64_t endpointId = 0;
+
+  // 90 octets in 20-octet fragments: seq 0-3 full, seq 4 has 10 octets
+  std::vector<uint8_t> pktA = makeLiteFragPayload(90, 0x10);
+  assertEqual(frag.send(pktA.data(), pktA.size(), 7), NDN_ERROR_success);
+  assertEqual(link.txFrames.size(), 5U);
+
+  // last fragment first, duplicate in the middle
+  link.deliver({4, 2, 0, 2, 3, 1});
+  assertEqual(frag.receive(buf.data(), buf.size(), endpointId), 90U);
+  assertEqual(endpointId, 7U);
+  assertTrue(std::equal(pktA.begin(), pktA.end(), buf.begin()));
+  assertEqual(frag.getCounters().nReassembled, 1U);
+  assertEqual(frag.getCounters().nDupFrags, 1U);
+  assertEqual(frag.receive(buf.data(), buf.size(), endpointId), 0U);
+
+  // two packets interleaved from different endpoints, with the same fragment id
+  link.txFrames.clear();
+  std::vector<uint8_t> pktB = makeLiteFragPayload(50, 0x20);
+  std::vector<uint8_t> pktC = makeLiteFragPayload(41, 0x30);
+  assertEqual(frag.send(pktB.data(), pktB.size(), 8), NDN_ERROR_success); // frames 0-2
+  assertEqual(frag.send(pktC.data(), pktC.size(), 9), NDN_ERROR_success); // frames 3-5
+  link.txFrames[3].second[1] = link.txFrames[0].second[1];
+  link.txFrames[3].second[2] = link.txFrames[0].second[2];
+  link.txFrames[4].second[1] = link.txFrames[5].second[1] = link.txFrames[0].second[1];
+  link.txFrames[4].second[2] = link.txFrames[5].second[2] = link.txFrames[0].second[2];
+  link.deliver({5, 2, 3, 1, 4, 0});
+  assertEqual(frag.receive(buf.data(), buf.size(), endpointId), 41U);
+  assertEqual(endpointId, 9U);
+  assertTrue(std::equal(pktC.begin(), pktC.end(), buf.begin()));
+  assertEqual(frag.receive(buf.data(), buf.size(), endpointId), 50U);
+  assertEqual(endpointId, 8U);
+  assertTrue(std::equal(pktB.begin(), pktB.end(), buf.begin()));
+  assertEqual(frag.getCounters().nEvictions, 0U);
+}
+
+test(LiteFrag_loss)
+{
+  FrameLink link;
+  ndn::LiteFrag frag(link);
+  frag.begin(200, 23, 2, 50);
+  std::vector<uint8_t> buf(200);
+  uint64_t endpointId = 0;
+
+  for (uint8_t i = 0; i < 4; ++i) {
+    std::vector<uint8_t> pkt = makeLiteFragPayload(70, i);
+    assertEqual(frag.send(pkt.data(), pkt.size(), i), NDN_ERROR_success);
+  }
+  assertEqual(link.txFrames.size(), 16U);
+
+  // packets 0-2 each lose a fragment; the third partial packet evicts the oldest
+  link.deliver({0, 1, 3, 4, 6, 7, 9, 10, 11});
+  assertEqual(frag.receive(buf.data(), buf.size(), endpointId), 0U);
+  assertEqual(frag.getCounters().nEvictions, 1U);
+
+  // partial packets are discarded after timeout
+  delay(60);
+  link.deliver({2, 15, 13, 14, 12});
+  std::vector<uint8_t> pkt3 = makeLiteFragPayload(70, 3);
+  assertEqual(frag.receive(buf.data(), buf.size(), endpointId), 70U);
+  assertEqual(endpointId, 3U);
+  assertTrue(std::equal(pkt3.begin(), pkt3.end(), buf.begin()));
+  assertEqual(frag.getCounters().nTimeouts, 2U);
+  assertEqual(frag.getCounters().nReassembled, 1U);
+}
+
+test(LiteFrag_tooLarge)
+{
+  FrameLink link;
+  ndn::LiteFrag frag(link);
+  frag.begin(100, 23, 1, 5000);
+  std::vector<uint8_t> buf(200);
+  uint64_t endpointId = 0;
+
+  std::vector<uint8_t> pkt = makeLiteFragPayload(120, 0);
+  assertEqual(frag.send(pkt.data(), pkt.size(), 0), NDN_ERROR_success);
+  link.deliver({0, 1, 2, 3, 4, 5});
+  assertEqual(frag.receive(buf.data(), buf.size(), endpointId), 0U);
+  assertEqual(frag.getCounters().nBadFrags, 1U);
+
+  std::vector<uint8_t> huge(20 * 32 + 1);
+  assertEqual(frag.send(huge.data(), huge.size(), 0), NDN_ERROR_TLV_length_exceeds_buffer_length);
+}
+
+test(LiteFrag_inPlace)
+{
+  FrameLink link;
+  ndn::LiteFrag frag(link);
+  frag.begin(200, 23, 1, 5000);
+  uint8_t scratch[23];
+  size_t len = 0;
+  uint64_t endpointId = 0;
+
+  // scratch space only fits one fragment, and the packet is not copied out
+  std::vector<uint8_t> pkt = makeLiteFragPayload(150, 0x40);
+  assertEqual(frag.send(pkt.data(), pkt.size(), 5), NDN_ERROR_success);
+  assertEqual(link.txFrames.size(), 8U);
+  link.deliver({7, 0, 6, 1, 5, 2, 4, 3});
+  const uint8_t* reass = frag.receiveInPlace(scratch, sizeof(scratch), len, endpointId);
+  assertTrue(reass != nullptr);
+  assertEqual(len, 150U);
+  assertEqual(endpointId, 5U);
+  assertTrue(std::equal(pkt.begin(), pkt.end(), reass));
+  assertTrue(frag.receiveInPlace(scratch, sizeof(scratch), len, endpointId) == nullptr);
+
+  // receive() cannot deliver a packet larger than its buffer
+  link.txFrames.clear();
+  assertEqual(frag.send(pkt.data(), pkt.size(), 5), NDN_ERROR_success);
+  link.deliver({0, 1, 2, 3, 4, 5, 6, 7});
+  assertEqual(frag.receive(scratch, sizeof(scratch), endpointId), 0U);
+  assertEqual(frag.getCounters().nReassembled, 2U);
+}
+
+/** \brief move transmitted frames of \p src into receive queue of \p dst, dropping some of them
+ *  \param lossPct loss percentage
+ */
+static void
+pumpLossy(FrameLink& src, FrameLink& dst, int lossPct)
+{
+  for (const auto& frame : src.txFrames) {
+    if (random(100) >= lossPct) {
+      dst.rxFrames.push_back(frame);
+    }
+  }
+  src.txFrames.clear();
+}
+
+test(LpReliability_retx)
+{
+  FrameLink linkA, linkB;
+  ndn::LpReliability relA(linkA), relB(linkB);
+  ndn::LpReliability::Options opts;
+  opts.initialRto = 20;
+  opts.minRto = 20;
+  opts.maxRetx = 2;
+  opts.idleAckTimeout = 5;
+  relA.begin(opts);
+  relB.begin(opts);
+  std::vector<uint8_t> buf(1500);
+  uint64_t endpointId = 0;
+
+  const uint8_t PKT1[] = {0x06, 0x02, 0xA1, 0xA2};
+  const uint8_t PKT2[] = {0x05, 0x02, 0xB1, 0xB2};
+  assertEqual(relA.send(PKT1, sizeof(PKT1), 3), NDN_ERROR_success);
+  assertEqual(linkA.txFrames.size(), 1U);
+
+  // first transmission is lost, retransmission after RTO
+  linkA.txFrames.clear();
+  assertEqual(relA.receive(buf.data(), buf.size(), endpointId), 0U);
+  assertEqual(linkA.txFrames.size(), 0U);
+  delay(25);
+  assertEqual(relA.receive(buf.data(), buf.size(), endpointId), 0U);
+  assertEqual(relA.getCounters().nRetx, 1U);
+  linkA.deliverTo(linkB, {0});
+  linkA.txFrames.clear();
+
+  // receiver strips TxSequence
+  size_t len = relB.receive(buf.data(), buf.size(), endpointId);
+  const uint8_t STRIPPED1[] = {0x64, 0x06, 0x50, 0x04, 0x06, 0x02, 0xA1, 0xA2};
+  assertEqual(len, sizeof(STRIPPED1));
+  assertTrue(std::equal(STRIPPED1, STRIPPED1 + sizeof(STRIPPED1), buf.begin()));
+  assertEqual(endpointId, 3U);
+
+  // ack is piggybacked on reverse traffic
+  assertEqual(relB.send(PKT2, sizeof(PKT2), 3), NDN_ERROR_success);
+  assertEqual(linkB.txFrames.size(), 1U);
+  assertEqual(linkB.txFrames[0].second.size(), 2U + 12 + 12 + 2 + sizeof(PKT2));
+  linkB.deliverTo(linkA, {0});
+  linkB.txFrames.clear();
+  len = relA.receive(buf.data(), buf.size(), endpointId);
+  assertEqual(len, 2U + 2 + sizeof(PKT2));
+  assertEqual(relA.getCounters().nAcked, 1U);
+
+  // ack is sent in IDLE packet when there is no reverse traffic
+  delay(10);
+  assertEqual(relA.receive(buf.data(), buf.size(), endpointId), 0U);
+  assertEqual(relA.getCounters().nIdleAcks, 1U);
+  assertEqual(linkA.txFrames.size(), 1U);
+  linkA.deliverTo(linkB, {0});
+  linkA.txFrames.clear();
+  assertEqual(relB.receive(buf.data(), buf.size(), endpointId), 0U);
+  assertEqual(relB.getCounters().nAcked, 1U);
+
+  // give up after maxRetx
+  assertEqual(relA.send(PKT1, sizeof(PKT1), 3), NDN_ERROR_success);
+  for (int i = 0; i < 4; ++i) {
+    delay(relA.getRto() + 5);
+    relA.receive(buf.data(), buf.size(), endpointId);
+  }
+  assertEqual(relA.getCounters().nRetx, 3U);
+  assertEqual(relA.getCounters().nGiveUp, 1U);
+  assertEqual(linkA.txFrames.size(), 3U);
+}
+
+test(LpReliability_lossy)
+{
+  FrameLink linkA, linkB;
+  ndn::LpReliability relA(linkA), relB(linkB);
+  ndn::LpReliability::Options opts;
+  opts.nRetxSlots = 8;
+  opts.initialRto = 10;
+  opts.minRto = 10;
+  opts.maxRto = 40;
+  opts.maxRetx = 10;
+  opts.idleAckTimeout = 2;
+  relA.begin(opts);
+  relB.begin(opts);
+  std::vector<uint8_t> buf(1500);
+  uint64_t endpointId = 0;
+
+  const int N_PKTS = 8;
+  std::vector<bool> received(N_PKTS);
+  for (uint8_t i = 0; i < N_PKTS; ++i) {
+    uint8_t pkt[] = {0x06, 0x01, i};
+    assertEqual(relA.send(pkt, sizeof(pkt), 0), NDN_ERROR_success);
+  }
+
+  unsigned long deadline = millis() + 2000;
+  while (relA.getCounters().nAcked < N_PKTS && static_cast<long>(millis() - deadline) < 0) {
+    pumpLossy(linkA, linkB, 30);
+    size_t len;
+    while ((len = relB.receive(buf.data(), buf.size(), endpointId)) > 0) {
+      assertEqual(len, 7U);
+      received.at(buf[6]) = true;
+    }
+    pumpLossy(linkB, linkA, 30);
+    relA.receive(buf.data(), buf.size(), endpointId);
+    delay(1);
+  }
+
+  assertEqual(relA.getCounters().nAcked, static_cast<uint32_t>(N_PKTS));
+  assertEqual(relA.getCounters().nGiveUp, 0U);
+  assertMore(relA.getCounters().nRetx, 0U);
+  assertTrue(std::all_of(received.begin(), received.end(), [] (bool b) { return b; }));
+}
+
+test(LpReliability_backoff)
+{
+  FrameLink link;
+  ndn::LpReliability rel(link);
+  ndn::LpReliability::Options opts;
+  opts.initialRto = 20;
+  opts.minRto = 20;
+  rel.begin(opts);
+  std::vector<uint8_t> buf(1500);
+  uint64_t endpointId = 0;
+
+  const uint8_t PKT[] = {0x06, 0x02, 0xA1, 0xA2};
+  for (int i = 0; i < 3; ++i) {
+    assertEqual(rel.send(PKT, sizeof(PKT), 3), NDN_ERROR_success);
+  }
+
+  // three packets expiring together double RTO once
+  delay(25);
+  assertEqual(rel.receive(buf.data(), buf.size(), endpointId), 0U);
+  assertEqual(rel.getCounters().nRetx, 3U);
+  assertEqual(rel.getRto(), 40UL);
+}
+
+static ndn::VirtualClock g_loopbackClock;
+
+test(Loopback_ring)
+{
+  ndn::LoopbackTransport::LinkOptions opts;
+  opts.capacity = 4;
+  opts.delay = 1000;
+  opts.bandwidth = 1000;
+  opts.clock = &g_loopbackClock;
+  g_loopbackClock.set(0);
+  ndn::LoopbackTransport transportA, transportB;
+  transportA.begin(transportB, opts);
+  uint8_t buf[16];
+  uint64_t endpointId = 0;
+
+  // 10-octet packets take 10ms each at 1000 octets/s, plus 1ms delay
+  for (uint8_t i = 0; i < 4; ++i) {
+    uint8_t pkt[10] = {i};
+    assertEqual(transportA.send(pkt, sizeof(pkt), i), NDN_ERROR_success);
+  }
+  uint8_t pkt[10] = {4};
+  assertEqual(transportA.send(pkt, sizeof(pkt), 4), NDN_ERROR_SocketTransport_error_in_send);
+  assertEqual(transportB.getCounters().nDropFull, 1U);
+
+  for (uint8_t i = 0; i < 4; ++i) {
+    g_loopbackClock.set(10000 * (i + 1) + 999);
+    assertEqual(transportB.receive(buf, sizeof(buf), endpointId), 0U);
+    g_loopbackClock.advance(1);
+    assertEqual(transportB.receive(buf, sizeof(buf), endpointId), 10U);
+    assertEqual(buf[0], i);
+    assertEqual(endpointId, static_cast<uint64_t>(i));
+  }
+  assertEqual(transportB.getCounters().nRx, 4U);
+}
+
+test(Loopback_reorder)
+{
+  ndn::LoopbackTransport::LinkOptions opts;
+  opts.capacity = 8;
+  opts.delay = 5000;
+  opts.jitter = 3000;
+  opts.clock = &g_loopbackClock;
+  g_loopbackClock.set(0);
+  ndn::LoopbackTransport transportA, transportB;
+  transportA.begin(transportB, opts);
+  uint8_t buf[16];
+  uint64_t endpointId = 0;
+
+  for (uint8_t i = 0; i < 8; ++i) {
+    assertEqual(transportA.send(&i, 1, 0), NDN_ERROR_success);
+  }
+  g_loopbackClock.set(4999);
+  assertEqual(transportB.receive(buf, sizeof(buf), endpointId), 0U);
+  g_loopbackClock.set(8000);
+  std::vector<bool> received(8);
+  for (int i = 0; i < 8; ++i) {
+    assertEqual(transportB.receive(buf, sizeof(buf), endpointId), 1U);
+    received.at(buf[0]) = true;
+  }
+  assertTrue(std::all_of(received.begin(), received.end(), [] (bool b) { return b; }));
+
+  // reordered packets skip delay
+  opts.reorder = 1.0;
+  transportB.setLinkOptions(opts);
+  uint8_t pkt = 9;
+  assertEqual(transportA.send(&pkt, 1, 0), NDN_ERROR_success);
+  assertEqual(transportB.receive(buf, sizeof(buf), endpointId), 1U);
+  assertEqual(transportB.getCounters().nReordered, 1U);
+}
+
+test(Loopback_loss)
+{
+  ndn::LoopbackTransport::LinkOptions opts;
+  opts.capacity = 1;
+  opts.lossGood = 0.3;
+  ndn::LoopbackTransport transportA, transportB;
+  transportA.begin(transportB, opts);
+  uint8_t buf[16];
+  uint64_t endpointId = 0;
+
+  const int N_PKTS = 2000;
+  uint8_t pkt = 0;
+  for (int i = 0; i < N_PKTS; ++i) {
+    assertEqual(transportA.send(&pkt, 1, 0), NDN_ERROR_success);
+    transportB.receive(buf, sizeof(buf), endpointId);
+  }
+  assertMore(transportB.getCounters().nLost, 500U);
+  assertLess(transportB.getCounters().nLost, 700U);
+
+  // Gilbert-Elliott: 1/6 of the time in bad state, where all packets are lost
+  opts.lossGood = 0.0;
+  opts.pGoodToBad = 0.1;
+  opts.pBadToGood = 0.5;
+  transportB.setLinkOptions(opts);
+  uint32_t nLost0 = transportB.getCounters().nLost;
+  for (int i = 0; i < N_PKTS; ++i) {
+    assertEqual(transportA.send(&pkt, 1, 0), NDN_ERROR_success);
+    transportB.receive(buf, sizeof(buf), endpointId);
+  }
+  uint32_t nLost = transportB.getCounters().nLost - nLost0;
+  assertMore(nLost, 200U);
+  assertLess(nLost, 500U);
+}
+
+static void
+recordTxCompletion(void* arg, ndn_Error error)
+{
+  static_cast<std::vector<int>*>(arg)->push_back(error);
+}
+
+test(TxQueue_slowLink)
+{
+  ndn::VirtualClock clock(0);
+  ClockGuard guard(clock);
+  FrameLink link;
+  link.airtime = 100;
+  link.mtu = 30;
+  ndn::TxQueue::Options opts;
+  opts.maxPkts = 4;
+  opts.bufSize = 64;
+  ndn::TxQueue queue(link, opts);
+  std::vector<int> completions;
+  queue.setTxCallback(recordTxCompletion, &completions);
+
+  // 20-octet packets: three fit in 64 octets of storage
+  for (uint8_t i = 0; i < 4; ++i) {
+    uint8_t pkt[20] = {i};
+    assertEqual(queue.send(pkt, sizeof(pkt), i), i < 3 ? NDN_ERROR_success : NDN_ERROR_SocketTransport_error_in_send);
+  }
+  assertEqual(queue.getCounters().nFull, 1U);
+  assertEqual(queue.size(), 3U);
+
+  // first packet starts transmitting; packets are still received while the link is busy
+  link.rxFrames.emplace_back(7, std::vector<uint8_t>{0xAA});
+  uint8_t buf[32];
+  uint64_t endpointId = 0;
+  assertEqual(queue.receive(buf, sizeof(buf), endpointId), 1U);
+  assertEqual(endpointId, 7ULL);
+  assertEqual(link.txFrames.size(), 1U);
+  assertEqual(queue.size(), 3U);
+  assertEqual(completions.size(), 0U);
+
+  // after airtime, first packet completes and its storage is reused by wrapping around
+  clock.advance(100000);
+  queue.loop();
+  assertEqual(completions.size(), 1U);
+  assertEqual(link.txFrames.size(), 2U);
+  uint8_t pkt3[20] = {3};
+  assertEqual(queue.send(pkt3, sizeof(pkt3), 3), NDN_ERROR_success);
+
+  uint8_t pkt4[30] = {4};
+  assertEqual(queue.send(pkt4, sizeof(pkt4), 4), NDN_ERROR_SocketTransport_error_in_send);
+  assertEqual(queue.getCounters().nFull, 2U);
+
+  for (int i = 0; i < 3; ++i) {
+    clock.advance(100000);
+    queue.loop();
+  }
+  assertEqual(queue.size(), 0U);
+  assertTrue(completions == std::vector<int>({0, 0, 0, 0}));
+  assertEqual(link.txFrames.size(), 4U);
+  for (uint8_t i = 0; i < 4; ++i) {
+    assertEqual(link.txFrames[i].second.at(0), i);
+    assertEqual(link.txFrames[i].first, static_cast<uint64_t>(i));
+  }
+
+  // a packet rejected by the link completes with its error code
+  std::vector<int> errors;
+  uint8_t pkt5[40] = {5};
+  assertEqual(queue.sendAsync(pkt5, sizeof(pkt5), 5, recordTxCompletion, &errors), NDN_ERROR_success);
+  queue.loop();
+  assertTrue(errors == std::vector<int>({NDN_ERROR_SocketTransport_error_in_send}));
+  assertEqual(link.nOverlaps, 0);
+  assertEqual(queue.getCounters().nSent, 4U);
+  assertEqual(queue.getCounters().nErrors, 1U);
+}
+
+test(LoraScheduler_airtime)
+{
+  ndn::LoraRadioParams radio;
+  radio.hasCrc = true;
+  assertEqual(radio.computeAirtime(10), 41216U);
+  radio.spreadingFactor = 12;
+  assertEqual(radio.computeAirtime(10), 991232U);
+  radio.bandwidth = 250000;
+  radio.spreadingFactor = 9;
+  radio.codingRate = 8;
+  assertEqual(radio.computeAirtime(50), 238080U);
+}
+
+test(LoraScheduler_dutyCycle)
+{
+  ndn::VirtualClock clock(0);
+  ClockGuard guard(clock);
+  MockLora lora;
+  ndn::LoraTransport<MockLora> transport(lora);
+  transport.enableAsyncTx();
+  ndn::LoraScheduler<MockLora>::Options opts;
+  opts.radio = lora.radio;
+  opts.dutyCycle = 0.1;
+  opts.nSlots = 3;
+  ndn::LoraScheduler<MockLora> scheduler(transport, opts);
+  const auto& cnt = scheduler.getCounters();
+
+  uint8_t interest[20] = {0x05, 0x12};
+  uint8_t data1[40] = {0x06, 0x26, 1};
+  uint8_t data2[40] = {0x06, 0x26, 2};
+  assertEqual(scheduler.send(interest, sizeof(interest), 0), NDN_ERROR_success);
+  assertEqual(scheduler.send(data1, sizeof(data1), 0), NDN_ERROR_success);
+  assertEqual(scheduler.send(data2, sizeof(data2), 0), NDN_ERROR_success);
+  assertEqual(scheduler.send(data2, sizeof(data2), 0), NDN_ERROR_SocketTransport_error_in_send);
+  assertEqual(cnt.nQueueFull, 1U);
+
+  // Data are sent before Interest; radio is busy during time-on-air, then band is silent for
+  // nine times that at 10% duty cycle
+  uint32_t dataAirtime = opts.radio.computeAirtime(sizeof(data1));
+  unsigned long listenTime = opts.radio.computeSymbolTime() + 2000;
+  uint8_t buf[64];
+  uint64_t endpointId = 0;
+  // radio listens for one symbol before each transmission
+  assertEqual(scheduler.receive(buf, sizeof(buf), endpointId), 0U);
+  assertEqual(lora.txFrames.size(), 0U);
+  assertTrue(lora.isContinuousRx);
+  clock.advance(listenTime);
+  assertEqual(scheduler.receive(buf, sizeof(buf), endpointId), 0U);
+  assertEqual(lora.txFrames.size(), 1U);
+  assertEqual(lora.txFrames[0].at(2), static_cast<uint8_t>(1));
+  assertEqual(scheduler.receive(buf, sizeof(buf), endpointId), 0U);
+  assertEqual(lora.txFrames.size(), 1U);
+  assertEqual(lora.nAborts, 0);
+
+  clock.advance(dataAirtime + 1000);
+  scheduler.loop();
+  assertEqual(lora.txFrames.size(), 1U);
+  assertEqual(cnt.nBudgetWaits, 1U);
+  unsigned long wait = scheduler.getBudgetWait();
+  assertMoreOrEqual(wait, dataAirtime * 9 / 1000 - 2);
+  assertLessOrEqual(wait, dataAirtime * 9 / 1000 + 2);
+
+  clock.advance(wait * 1000);
+  scheduler.loop();
+  clock.advance(listenTime);
+  scheduler.loop();
+  assertEqual(lora.txFrames.size(), 2U);
+  assertEqual(lora.txFrames[1].at(2), static_cast<uint8_t>(2));
+
+  // listen before talk: busy channel causes random backoff; RSSI is read after one symbol in
+  // receive mode, because the radio is in standby after transmitting
+  clock.advance(dataAirtime * 10 + 2000);
+  lora.channelRssi = -70;
+  scheduler.loop();
+  assertEqual(cnt.nLbtBusy, 0U);
+  scheduler.loop();
+  assertEqual(cnt.nLbtBusy, 0U);
+  clock.advance(listenTime);
+  scheduler.loop();
+  assertEqual(cnt.nLbtBusy, 1U);
+  assertEqual(lora.txFrames.size(), 2U);
+  lora.channelRssi = -120;
+  scheduler.loop();
+  assertEqual(lora.txFrames.size(), 2U);
+  clock.advance(opts.backoffMax * 1000);
+  scheduler.loop();
+  clock.advance(listenTime);
+  scheduler.loop();
+  assertEqual(lora.txFrames.size(), 3U);
+  assertEqual(lora.txFrames[2].at(0), static_cast<uint8_t>(0x05));
+
+  assertEqual(cnt.nTxPkts, 3U);
+  assertEqual(cnt.txAirtime, 2ULL * dataAirtime + opts.radio.computeAirtime(sizeof(interest)));
+  assertEqual(lora.nAborts, 0);
+}
+
+test(Lora_interruptRx)
+{
+  ndn::VirtualClock clock(0);
+  ClockGuard guard(clock);
+  MockLora lora;
+  ndn::LoraTransport<MockLora> transport(lora);
+  transport.enableAsyncTx();
+  assertTrue(transport.beginInterruptRx());
+  ndn::LoraTransport<MockLora> transport2(lora);
+  assertFalse(transport2.beginInterruptRx());
+
+  // packets arriving while the application is busy are queued, beyond which they are dropped
+  for (uint8_t i = 0; i < LORA_RX_QUEUE_SLOTS + 1; ++i) {
+    assertTrue(lora.interruptRx({0x06, 0x01, i}, -100 - i, 2.5 - i));
+  }
+  assertEqual(transport.getRxCounters().nFrames, static_cast<uint32_t>(LORA_RX_QUEUE_SLOTS));
+  assertEqual(transport.getRxCounters().nOverflows, 1U);
+
+  uint8_t buf[16];
+  uint64_t endpointId = 1;
+  for (uint8_t i = 0; i < LORA_RX_QUEUE_SLOTS; ++i) {
+    assertEqual(transport.receive(buf, sizeof(buf), endpointId), 3U);
+    assertEqual(buf[2], i);
+    assertEqual(endpointId, 0ULL);
+    assertEqual(transport.getLastRssi(), -100 - i);
+    assertTrue(transport.getLastSnr() == 2.5 - i);
+  }
+  assertEqual(transport.receive(buf, sizeof(buf), endpointId), 0U);
+  assertEqual(lora.nParsePacket, 0);
+
+  // radio returns to continuous RX after async transmission
+  uint8_t pkt[10] = {0x05, 0x08};
+  assertEqual(transport.send(pkt, sizeof(pkt), 0), NDN_ERROR_success);
+  assertFalse(lora.isContinuousRx);
+  assertFalse(transport.isTxReady());
+  clock.advance(lora.radio.computeAirtime(sizeof(pkt)) + 1000);
+  assertTrue(transport.isTxReady());
+  assertTrue(lora.interruptRx({0x06, 0x01, 0xFF}, -90, 8.0));
+  assertEqual(transport.receive(buf, sizeof(buf), endpointId), 3U);
+  assertEqual(transport.getLastRssi(), -90);
+  assertTrue(transport.getLastSnr() == 8.0);
+
+  // receive() alone returns the radio to continuous RX, when Face is used without TxQueue
+  assertEqual(transport.send(pkt, sizeof(pkt), 0), NDN_ERROR_success);
+  assertFalse(lora.isContinuousRx);
+  assertEqual(transport.receive(buf, sizeof(buf), endpointId), 0U);
+  assertFalse(lora.isContinuousRx);
+  clock.advance(lora.radio.computeAirtime(sizeof(pkt)) + 1000);
+  assertEqual(transport.receive(buf, sizeof(buf), endpointId), 0U);
+  assertTrue(lora.isContinuousRx);
+  assertEqual(lora.nAborts, 0);
+}
+
+test(HeaderCompressor_roundtrip)
+{
+  ndn::NameWCB<3> prefix;
+  prefix.append("ndn");
+  prefix.append("edu");
+  prefix.append("ucla");
+  ndn::HeaderCodec codec;
+  assertTrue(codec.addPrefix(prefix));
+
+  FrameLink linkA, linkB;
+  ndn::HeaderCompressor compA(linkA, codec), compB(linkB, codec);
+  ndn::Face faceA(compA);
+  ndn::DigestKey digestKey;
+  faceA.setSigningKey(digestKey);
+
+  ndn::InterestWCB<6, 0> interest;
+  interest.getName().append(prefix);
+  interest.getName().append("ping");
+  uint8_t seqBuf[9];
+  interest.getName().appendSequenceNumber(0x12345678, seqBuf, sizeof(seqBuf));
+  interest.setMustBeFresh(true);
+  assertEqual(faceA.sendInterest(interest), NDN_ERROR_success);
+
+  ndn::DataWCB<6, 5> data;
+  data.getName().append(interest.getName());
+  data.getMetaInfo().setFreshnessPeriod(1000);
+  const uint8_t payload[] = {0xA0, 0xA1, 0xA2, 0xA3};
+  data.setContent(ndn::BlobLite(payload, sizeof(payload)));
+  assertEqual(faceA.sendData(data), NDN_ERROR_success);
+
+  ndn::NameWCB<5> keyName;
+  keyName.append(prefix);
+  keyName.append("KEY");
+  keyName.append("1");
+  ndn::EcPrivateKey ecKey(keyName);
+  ndn::EcPublicKey ecPub;
+  assertTrue(ecKey.generate(ecPub));
+  faceA.setSigningKey(ecKey);
+  assertEqual(faceA.sendData(data), NDN_ERROR_success);
+
+  // LpPacket is sent unchanged
+  uint8_t lp[] = {0x64, 0x04, 0x50, 0x02, 0xC0, 0xC1};
+  assertEqual(compA.send(lp, sizeof(lp), 0), NDN_ERROR_success);
+
+  const auto& cntA = compA.getCounters();
+  assertEqual(cntA.nTxCompressed, 3U);
+  assertEqual(cntA.nTxPlain, 1U);
+  // Name prefix, Nonce, InterestLifetime, MetaInfo, and SignatureInfo headers are elided
+  assertMoreOrEqual(cntA.nTxSaved, 3U * 12U);
+  assertEqual(linkA.txFrames.size(), 4U);
+  for (const auto& frame : linkA.txFrames) {
+    linkB.rxFrames.push_back(frame);
+  }
+
+  // every packet is restored octet for octet
+  uint8_t plain[512];
+  uint8_t buf[512];
+  uint64_t endpointId = 0;
+  for (const auto& frame : linkA.txFrames) {
+    size_t len = compB.receive(buf, sizeof(buf), endpointId);
+    assertMoreOrEqual(len, frame.second.size());
+    if (ndn::HeaderCodec::isCompressed(frame.second.data(), frame.second.size())) {
+      size_t plainLen = codec.decompress(frame.second.data(), frame.second.size(), plain, sizeof(plain));
+      assertEqual(plainLen, len);
+      assertEqual(std::memcmp(plain, buf, len), 0);
+      assertEqual(codec.compress(plain, plainLen, buf, sizeof(buf)), frame.second.size());
+    }
+  }
+  const auto& cntB = compB.getCounters();
+  assertEqual(cntB.nRxCompressed, 3U);
+  assertEqual(cntB.nRxPlain, 1U);
+
+  size_t len = codec.decompress(linkA.txFrames.at(2).second.data(), linkA.txFrames.at(2).second.size(),
+                                plain, sizeof(plain));
+  ndn::PacketBuffer::Options pbOpts;
+  ndn::PacketBuffer pb(pbOpts);
+  assertEqual(pb.parse(plain, len), NDN_ERROR_success);
+  assertTrue(pb.getData() != nullptr);
+  assertEqual(pb.verify(ecPub), ndn::PacketBuffer::VERIFY_OK);
+
+  // a peer without the same dictionary rejects compressed packets
+  ndn::HeaderCodec codec2;
+  ndn::HeaderCompressor compC(linkB, codec2);
+  linkB.rxFrames.push_back(linkA.txFrames.at(0));
+  assertEqual(compC.receive(buf, sizeof(buf), endpointId), 0U);
+  assertEqual(compC.getCounters().nRxErrors, 1U);
+}
+
+test(EndpointTable_lru)
+{
+  ndn::EndpointTable table(3);
+  assertEqual(table.capacity(), 3U);
+  assertTrue(table.find(1) == nullptr);
+
+  table.countRx(1, 100);
+  table.countRx(2, 200);
+  table.countRx(3, 300);
+  table.countRx(1, 100);
+  assertEqual(table.size(), 3U);
+  assertEqual(table.find(1)->nRxPkts, 2U);
+  assertEqual(table.find(1)->nRxOctets, 200U);
+
+  // find and countTx do not refresh recency, so endpoint 2 is least recently seen
+  table.countTx(2, 50);
+  table.countTx(9, 50);
+  assertEqual(table.find(2)->nTxOctets, 50U);
+  assertTrue(table.find(9) == nullptr);
+  table.countRx(4, 400);
+  assertTrue(table.find(2) == nullptr);
+  assertEqual(table.getCounters().nEvictions, 1U);
+
+  std::vector<uint64_t> order;
+  table.forEach([&] (const ndn::EndpointTable::Entry& entry) { order.push_back(entry.endpointId); });
+  assertEqual(order.size(), 3U);
+  assertEqual(order.at(0), static_cast<uint64_t>(4));
+  assertEqual(order.at(1), static_cast<uint64_t>(1));
+  assertEqual(order.at(2), static_cast<uint64_t>(3));
+
+  assertTrue(table.erase(1));
+  assertFalse(table.erase(1));
+  assertEqual(table.size(), 2U);
+  table.touch(5);
+  table.touch(6);
+  assertTrue(table.find(3) == nullptr);
+  assertTrue(table.find(4) != nullptr);
+
+  ndn::EndpointTable::Entry& entry = table.touch(7);
+  entry.addRttSample(8000);
+  assertEqual(entry.srtt, 8000U);
+  assertEqual(entry.rttvar, 4000U);
+  entry.addRttSample(16000);
+  assertEqual(entry.srtt, 9000U);
+  assertEqual(entry.rttvar, 5000U);
+}
+
+test(EndpointTable_many)
+{
+  ndn::EndpointTable table(64);
+  for (uint64_t id = 1; id <= 1000; ++id) {
+    table.countRx(id << 16, 1);
+    assertTrue(table.find(id << 16) != nullptr);
+  }
+  assertEqual(table.size(), 64U);
+  assertEqual(table.getCounters().nEvictions, 936U);
+  for (uint64_t id = 937; id <= 1000; ++id) {
+    assertTrue(table.find(id << 16) != nullptr);
+  }
+  assertTrue(table.find(936 << 16) == nullptr);
+}
+
+#if defined(__linux__)
+test(PosixUdp_batch)
+{
+  ndn::PosixUdpTransport::Options opts;
+  opts.rxBatch = opts.txBatch = 8;
+  ndn::PosixUdpTransport transportA(opts), transportB(opts);
+  IPAddress localhost(127, 0, 0, 1);
+  transportA.enableEndpointTable(4);
+  assertTrue(transportA.beginListen(26363, localhost));
+  assertTrue(transportB.beginTunnel(localhost, 26363, 26364));
+  uint8_t buf[16];
+  uint64_t endpointId = 0;
+
+  for (uint8_t i = 0; i < 16; ++i) {
+    assertEqual(transportB.send(&i, 1, 0), NDN_ERROR_success);
+  }
+  assertEqual(transportB.getCounters().nTxSyscalls, 2U);
+
+  for (int i = 0; i < 16; ++i) {
+    size_t len = 0;
+    for (int retry = 0; len == 0 && retry < 1000; ++retry) {
+      len = transportA.receive(buf, sizeof(buf), endpointId);
+    }
+    assertEqual(len, 1U);
+    assertEqual(static_cast<int>(buf[0]), i);
+  }
+  assertEqual(transportA.getCounters().nRxPkts, 16U);
+  assertLess(transportA.getCounters().nRxSyscalls, 16U);
+  assertEqual(transportA.getEndpointTable()->size(), 1U);
+  assertEqual(transportA.getEndpointTable()->find(endpointId)->nRxPkts, 16U);
+
+  // reply is queued until flush
+  uint8_t pkt = 0xA0;
+  assertEqual(transportA.send(&pkt, 1, endpointId), NDN_ERROR_success);
+  assertEqual(transportA.send(&pkt, 1, 0), NDN_ERROR_SocketTransport_error_in_getaddrinfo);
+  assertEqual(transportA.getCounters().nTxPkts, 0U);
+  assertEqual(transportA.flush(), NDN_ERROR_success);
+  assertEqual(transportA.getCounters().nTxPkts, 1U);
+
+  size_t len = 0;
+  for (int retry = 0; len == 0 && retry < 1000; ++retry) {
+    len = transportB.receive(buf, sizeof(buf), endpointId);
+  }
+  assertEqual(len, 1U);
+  assertEqual(static_cast<int>(buf[0]), 0xA0);
+  assertEqual(endpointId, static_cast<uint64_t>(0));
+}
+
+test(Stream_framing)
+{
+  int sv[2];
+  assertEqual(socketpair(AF_UNIX, SOCK_STREAM, 0, sv), 0);
+  ndn::StreamTransport transport;
+  assertTrue(transport.begin(sv[0]));
+  uint8_t buf[512];
+  uint64_t endpointId = 1;
+
+  std::vector<uint8_t> wire({0x05, 0x03, 0xA1, 0xA2, 0xA3, 0x06, 0xFD, 0x01, 0x00});
+  wire.resize(wire.size() + 256, 0xBB);
+  const size_t cuts[] = {0, 3, 7, 100, wire.size()};
+  std::vector<size_t> received;
+  for (int i = 1; i < 5; ++i) {
+    assertEqual(write(sv[1], &wire[cuts[i - 1]], cuts[i] - cuts[i - 1]),
+                static_cast<ssize_t>(cuts[i] - cuts[i - 1]));
+    size_t len;
+    while ((len = transport.receive(buf, sizeof(buf), endpointId)) > 0) {
+      received.push_back(len);
+    }
+  }
+  assertEqual(received.size(), 2U);
+  assertEqual(received.at(0), 5U);
+  assertEqual(received.at(1), 260U);
+  assertEqual(static_cast<int>(buf[0]), 0x06);
+  assertEqual(static_cast<int>(buf[259]), 0xBB);
+  assertEqual(endpointId, static_cast<uint64_t>(0));
+  assertEqual(transport.getCounters().nRxPkts, 2U);
+
+  uint8_t pkt[] = {0x07, 0x01, 0xC0};
+  assertEqual(transport.send(pkt, sizeof(pkt), 0), NDN_ERROR_success);
+  assertEqual(read(sv[1], buf, sizeof(buf)), static_cast<ssize_t>(sizeof(pkt)));
+  assertEqual(static_cast<int>(buf[2]), 0xC0);
+
+  close(sv[1]);
+  assertEqual(transport.receive(buf, sizeof(buf), endpointId), 0U);
+  assertFalse(transport.isConnected());
+  assertEqual(transport.send(pkt, sizeof(pkt), 0), NDN_ERROR_SocketTransport_socket_is_not_open);
+}
+
+test(Stream_tcp)
+{
+  int listener = socket(AF_INET, SOCK_STREAM, 0);
+  int one = 1;
+  setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+  sockaddr_in addr = {};
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  addr.sin_port = htons(26365);
+  assertEqual(bind(listener, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)), 0);
+  assertEqual(listen(listener, 1), 0);
+
+  ndn::StreamTransport transport;
+  assertTrue(transport.beginTcp(IPAddress(127, 0, 0, 1), 26365));
+  int peer = accept(listener, nullptr, nullptr);
+  close(listener);
+  assertNotEqual(peer, -1);
+
+  // peer echoes every packet
+  uint8_t buf[64];
+  uint64_t endpointId = 0;
+  uint8_t pkt[] = {0x05, 0x02, 0xD0, 0xD1};
+  for (int i = 0; i < 10; ++i) {
+    assertEqual(transport.send(pkt, sizeof(pkt), 0), NDN_ERROR_success);
+  }
+  size_t nEchoed = 0;
+  while (nEchoed < 10 * sizeof(pkt)) {
+    ssize_t n = read(peer, buf, sizeof(buf));
+    assertMore(n, 0);
+    assertEqual(write(peer, buf, n), n);
+    nEchoed += n;
+  }
+
+  int nReceived = 0;
+  for (int retry = 0; nReceived < 10 && retry < 1000; ++retry) {
+    if (transport.receive(buf, sizeof(buf), endpointId) == sizeof(pkt)) {
+      assertEqual(static_cast<int>(buf[3]), 0xD1);
+      ++nReceived;
+    }
+  }
+  assertEqual(nReceived, 10);
+  assertEqual(transport.getCounters().nRxErrors, 0U);
+  close(peer);
+}
+
+test(Shm_ring)
+{
+  ndn::ShmTransport::Options opts;
+  opts.nSlots = 3; // rounded up to 4
+  opts.slotSize = 64;
+  ndn::ShmTransport transportA, transportB;
+  assertFalse(transportB.beginAttach("/esp8266ndn-unittest"));
+  assertTrue(transportA.beginCreate("/esp8266ndn-unittest", opts));
+  assertTrue(transportB.beginAttach("/esp8266ndn-unittest"));
+  assertEqual(transportA.getMtu(), 60U);
+  uint8_t buf[64];
+  uint64_t endpointId = 1;
+
+  for (uint8_t i = 0; i < 6; ++i) {
+    assertEqual(transportA.send(&i, 1, 0),
+                i < 4 ? NDN_ERROR_success : NDN_ERROR_SocketTransport_error_in_send);
+  }
+  assertEqual(transportA.getCounters().nTxFull, 2U);
+  for (int i = 0; i < 4; ++i) {
+    assertEqual(transportB.receive(buf, sizeof(buf), endpointId), 1U);
+    assertEqual(static_cast<int>(buf[0]), i);
+  }
+  assertEqual(transportB.receive(buf, sizeof(buf), endpointId), 0U);
+  assertEqual(endpointId, static_cast<uint64_t>(0));
+  assertFalse(transportB.wait(1));
+
+  // encode in place, parse in place
+  const uint8_t interest[] = {0x05, 0x0B, 0x07, 0x03, 0x08, 0x01, 0x41,
+                              0x0A, 0x04, 0xA0, 0xA1, 0xA2, 0xA3};
+  size_t room = 0;
+  uint8_t* slot = transportB.beginSend(room);
+  assertTrue(slot != nullptr);
+  assertEqual(room, 60U);
+  memcpy(slot, interest, sizeof(interest));
+  transportB.commitSend(sizeof(interest));
+
+  assertTrue(transportA.wait(1));
+  size_t len = 0;
+  const uint8_t* pkt = transportA.peek(len);
+  assertTrue(pkt != nullptr);
+  assertEqual(len, sizeof(interest));
+  ndn::PacketBuffer pb(ndn::PacketBuffer::Options{});
+  assertEqual(pb.parse(pkt, len), NDN_ERROR_success);
+  assertEqual(static_cast<int>(pb.getPktType()), static_cast<int>(ndn::PacketType::INTEREST));
+  assertEqual(pb.getInterest()->getName().size(), 1U);
+  transportA.release();
+  assertTrue(transportA.peek(len) == nullptr);
+  assertEqual(transportA.getCounters().nRxPkts, 1U);
+}
+
+test(PosixEthernet_loopback)
+{
+  ndn::PosixEthernetTransport transportA, transportB;
+  if (!transportA.begin("lo") || !transportB.begin("lo")) {
+    return; // requires CAP_NET_RAW
+  }
+  uint8_t buf[1500];
+  uint64_t endpointId = 0;
+
+  uint8_t pkt[] = {0x05, 0x01, 0xE0};
+  for (int i = 0; i < 4; ++i) {
+    assertEqual(transportA.send(pkt, sizeof(pkt), 0), NDN_ERROR_success);
+  }
+  assertEqual(transportA.flush(), NDN_ERROR_success);
+  assertEqual(transportA.getCounters().nTxSyscalls, 1U);
+
+  int nReceived = 0;
+  for (int retry = 0; nReceived < 4 && retry < 200; ++retry) {
+    size_t len = transportB.receive(buf, sizeof(buf), endpointId);
+    if (len == 0) {
+      delay(1);
+      continue;
+    }
+    // payload is padded to Ethernet minimum
+    assertEqual(len, 46U);
+    assertEqual(static_cast<int>(buf[2]), 0xE0);
+    ndn::PosixEthernetTransport::EndpointId endpoint;
+    endpoint.endpointId = endpointId;
+    assertTrue(endpoint.isMulticast);
+    ++nReceived;
+  }
+  assertEqual(nReceived, 4);
+  assertMore(transportB.getCounters().nRxBlocks, 0U);
+}
+#endif // defined(__linux__)
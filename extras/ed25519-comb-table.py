@@ -0,0 +1,67 @@
+#!/usr/bin/env python3
+# Generate fixed-base comb table of Ed25519 base point for ed25519.c.
+# Usage: ./ed25519-comb-table.py > ../src/security/detail/ed25519_comb.h
+#
+# A 256-bit scalar is split into 4 rows of 64 bits.
+# Table entry j (j=0..15) is the point sum(bit t of j ? 2^(64*t) : 0) * B in affine coordinates,
+# stored as (y+x, y-x, 2*d*x*y) mod p. Each value is stored as 8 little-endian 32-bit words.
+
+P = 2**255 - 19
+D = -121665 * pow(121666, P - 2, P) % P
+TEETH = 4
+SPACING = 64
+
+
+def recover_x(y, sign):
+  xx = (y * y - 1) * pow(D * y * y + 1, P - 2, P) % P
+  x = pow(xx, (P + 3) // 8, P)
+  if (x * x - xx) % P != 0:
+    x = x * pow(2, (P - 1) // 4, P) % P
+  if x % 2 != sign:
+    x = P - x
+  return x
+
+
+def add(p, q):
+  (x1, y1), (x2, y2) = p, q
+  t = D * x1 * x2 * y1 * y2 % P
+  x3 = (x1 * y2 + x2 * y1) * pow(1 + t, P - 2, P) % P
+  y3 = (y1 * y2 + x1 * x2) * pow(1 - t, P - 2, P) % P
+  return (x3, y3)
+
+
+def mul(k, p):
+  r = (0, 1)
+  while k > 0:
+    if k & 1:
+      r = add(r, p)
+    p = add(p, p)
+    k >>= 1
+  return r
+
+
+def words(v):
+  return ['0x%08X' % ((v >> (32 * i)) & 0xFFFFFFFF) for i in range(8)]
+
+
+BY = 4 * pow(5, P - 2, P) % P
+B = (recover_x(BY, 0), BY)
+rows = [mul(1 << (t * SPACING), B) for t in range(TEETH)]
+
+print('/* Generated by extras/ed25519-comb-table.py, do not edit. */')
+print('/* Fixed-base comb table of Ed25519 base point, see ed25519_scalarmult_base(). */')
+print()
+print('#define COMB_TEETH %d' % TEETH)
+print('#define COMB_SPACING %d' % SPACING)
+print()
+print('static const uint32_t comb_table[%d][24] = {' % (1 << TEETH))
+for j in range(1 << TEETH):
+  pt = (0, 1)
+  for t in range(TEETH):
+    if j & (1 << t):
+      pt = add(pt, rows[t])
+  x, y = pt
+  ws = words((y + x) % P) + words((y - x) % P) + words(2 * D * x * y % P)
+  for k in range(0, 24, 4):
+    print('%s%s%s' % ('    {' if k == 0 else '     ', ', '.join(ws[k:k + 4]), '},' if k == 20 else ','))
+print('};')
@@ -0,0 +1,49 @@
+#ifndef ESP8266NDN_HOST_ARDUINO_H
+#define ESP8266NDN_HOST_ARDUINO_H
+
+// Minimal Arduino API for compiling esp8266ndn on a Linux host.
+// The program must define millis(), micros(), delay(), and random().
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#include "pgmspace.h"
+#include "Print.h"
+#include "WString.h"
+
+using std::min;
+using std::max;
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define HEX 16
+#define DEC 10
+
+unsigned long
+millis();
+
+unsigned long
+micros();
+
+void
+delay(unsigned long ms);
+
+inline void
+yield()
+{
+}
+
+long
+random(long max);
+
+inline long
+random(long min, long max)
+{
+  return min >= max ? min : min + random(max - min);
+}
+
+#endif // ESP8266NDN_HOST_ARDUINO_H
@@ -0,0 +1,38 @@
+#ifndef ESP8266NDN_HOST_IPADDRESS_H
+#define ESP8266NDN_HOST_IPADDRESS_H
+
+#include "Print.h"
+
+#include <cstdint>
+
+class IPAddress : public Printable
+{
+public:
+  IPAddress(uint32_t addr = 0)
+    : m_addr(addr)
+  {
+  }
+
+  IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d)
+    : m_addr(a | (b << 8) | (c << 16) | (static_cast<uint32_t>(d) << 24))
+  {
+  }
+
+  operator uint32_t() const
+  {
+    return m_addr;
+  }
+
+  size_t
+  printTo(Print& p) const override
+  {
+    return p.printf("%u.%u.%u.%u", m_addr & 0xFF, (m_addr >> 8) & 0xFF, (m_addr >> 16) & 0xFF, m_addr >> 24);
+  }
+
+private:
+  uint32_t m_addr;
+};
+
+#define INADDR_NONE IPAddress(0)
+
+#endif // ESP8266NDN_HOST_IPADDRESS_H
@@ -0,0 +1,147 @@
+#ifndef ESP8266NDN_HOST_PRINT_H
+#define ESP8266NDN_HOST_PRINT_H
+
+#include "WString.h"
+
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+class Printable;
+
+class Print
+{
+public:
+  virtual
+  ~Print() = default;
+
+  virtual size_t
+  write(uint8_t c) = 0;
+
+  virtual size_t
+  write(const uint8_t* buf, size_t size)
+  {
+    size_t n = 0;
+    while (size-- > 0) {
+      n += write(*buf++);
+    }
+    return n;
+  }
+
+  size_t
+  write(const char* s)
+  {
+    return write(reinterpret_cast<const uint8_t*>(s), strlen(s));
+  }
+
+  size_t
+  print(const char* s)
+  {
+    return write(s);
+  }
+
+  size_t
+  print(const __FlashStringHelper* s)
+  {
+    return write(reinterpret_cast<const char*>(s));
+  }
+
+  size_t
+  print(const String& s)
+  {
+    return write(s.c_str());
+  }
+
+  size_t
+  print(char c)
+  {
+    return write(static_cast<uint8_t>(c));
+  }
+
+  size_t
+  print(unsigned char v, int base = DEC_BASE)
+  {
+    return print(static_cast<unsigned long>(v), base);
+  }
+
+  size_t
+  print(int v, int base = DEC_BASE)
+  {
+    return print(static_cast<long>(v), base);
+  }
+
+  size_t
+  print(unsigned v, int base = DEC_BASE)
+  {
+    return print(static_cast<unsigned long>(v), base);
+  }
+
+  size_t
+  print(long v, int base = DEC_BASE)
+  {
+    return printf(base == 16 ? "%lX" : "%ld", v);
+  }
+
+  size_t
+  print(unsigned long v, int base = DEC_BASE)
+  {
+    return printf(base == 16 ? "%lX" : "%lu", v);
+  }
+
+  size_t
+  print(double v, int digits = 2)
+  {
+    return printf("%.*f", digits, v);
+  }
+
+  size_t
+  print(const Printable& p);
+
+  size_t
+  println()
+  {
+    return write("\r\n");
+  }
+
+  template<typename T>
+  size_t
+  println(const T& v)
+  {
+    size_t n = print(v);
+    return n + println();
+  }
+
+  size_t
+  printf(const char* fmt, ...)
+  {
+    char buf[256];
+    va_list ap;
+    va_start(ap, fmt);
+    vsnprintf(buf, sizeof(buf), fmt, ap);
+    va_end(ap);
+    return write(buf);
+  }
+
+private:
+  static constexpr int DEC_BASE = 10;
+};
+
+class Printable
+{
+public:
+  virtual
+  ~Printable() = default;
+
+  virtual size_t
+  printTo(Print& p) const = 0;
+};
+
+inline size_t
+Print::print(const Printable& p)
+{
+  return p.printTo(*this);
+}
+
+#endif // ESP8266NDN_HOST_PRINT_H
@@ -0,0 +1,73 @@
+#ifndef ESP8266NDN_HOST_WSTRING_H
+#define ESP8266NDN_HOST_WSTRING_H
+
+#include "pgmspace.h"
+
+#include <cctype>
+#include <string>
+
+class String : public std::string
+{
+public:
+  String() = default;
+
+  String(const char* s)
+    : std::string(s)
+  {
+  }
+
+  String(const std::string& s)
+    : std::string(s)
+  {
+  }
+
+  String(const __FlashStringHelper* s)
+    : std::string(reinterpret_cast<const char*>(s))
+  {
+  }
+
+  String(int v)
+    : std::string(std::to_string(v))
+  {
+  }
+
+  unsigned
+  length() const
+  {
+    return size();
+  }
+
+  void
+  concat(char c)
+  {
+    push_back(c);
+  }
+
+  void
+  toUpperCase()
+  {
+    for (char& c : *this) {
+      c = toupper(c);
+    }
+  }
+};
+
+inline String
+operator+(const String& a, const String& b)
+{
+  return String(static_cast<const std::string&>(a) + static_cast<const std::string&>(b));
+}
+
+inline String
+operator+(const char* a, const String& b)
+{
+  return String(a) + b;
+}
+
+inline String
+operator+(const String& a, const char* b)
+{
+  return a + String(b);
+}
+
+#endif // ESP8266NDN_HOST_WSTRING_H
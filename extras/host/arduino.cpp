@@ -0,0 +1,42 @@
+// Arduino timing and random functions for programs that run esp8266ndn on a Linux host.
+
+#include "Arduino.h"
+
+#include <time.h>
+
+static uint64_t
+getMonotonicMicros()
+{
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return static_cast<uint64_t>(ts.tv_sec) * 1000000 + ts.tv_nsec / 1000;
+}
+
+static const uint64_t g_epoch = getMonotonicMicros();
+
+unsigned long
+millis()
+{
+  return static_cast<unsigned long>((getMonotonicMicros() - g_epoch) / 1000);
+}
+
+unsigned long
+micros()
+{
+  return static_cast<unsigned long>(getMonotonicMicros() - g_epoch);
+}
+
+void
+delay(unsigned long ms)
+{
+  timespec ts;
+  ts.tv_sec = ms / 1000;
+  ts.tv_nsec = (ms % 1000) * 1000000;
+  nanosleep(&ts, nullptr);
+}
+
+long
+random(long max)
+{
+  return max <= 0 ? 0 : std::rand() % max;
+}
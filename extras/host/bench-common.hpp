@@ -0,0 +1,81 @@
+#ifndef ESP8266NDN_HOST_BENCH_COMMON_HPP
+#define ESP8266NDN_HOST_BENCH_COMMON_HPP
+
+// Producer and consumer logic shared by host benchmark programs.
+
+#include <esp8266ndn.h>
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+
+static ndn::DigestKey g_key;
+
+static bool
+processInterest(ndn::SimpleProducer::Context& ctx, const ndn::InterestLite& interest)
+{
+  static const uint8_t payload[100] = {0};
+  ndn::DataWCB<4, 0> data;
+  data.setName(interest.getName());
+  data.setContent(ndn::BlobLite(payload, sizeof(payload)));
+  ctx.sendData(data);
+  return true;
+}
+
+class Consumer : public ndn::PacketHandler
+{
+public:
+  Consumer(ndn::Face& face, int window)
+    : m_face(face)
+    , m_window(window)
+  {
+    m_face.addHandler(this);
+    m_face.enableNack(false);
+    ndn::parseNameFromUri(m_interest.getName(), m_prefix);
+  }
+
+  void
+  loop()
+  {
+    unsigned long now = millis();
+    if (m_nOutstanding > 0 && now - m_lastData > 200) {
+      m_nOutstanding = 0; // assume outstanding Interests were lost
+    }
+    while (m_nOutstanding < m_window) {
+      ndn::NameLite& name = m_interest.getName();
+      if (name.size() > 1) {
+        name.pop();
+      }
+      name.appendSequenceNumber(++m_seq, m_seqBuf, sizeof(m_seqBuf));
+      m_face.sendInterest(m_interest);
+      ++m_nOutstanding;
+      ++nInterests;
+    }
+  }
+
+private:
+  bool
+  processData(const ndn::DataLite& data, uint64_t endpointId) override
+  {
+    ++nData;
+    --m_nOutstanding;
+    m_lastData = millis();
+    return true;
+  }
+
+public:
+  uint64_t nInterests = 0;
+  uint64_t nData = 0;
+
+private:
+  ndn::Face& m_face;
+  const int m_window;
+  char m_prefix[8] = "/bench";
+  ndn::InterestWCB<4, 0> m_interest;
+  uint8_t m_seqBuf[9];
+  uint64_t m_seq = 0;
+  int m_nOutstanding = 0;
+  unsigned long m_lastData = 0;
+};
+
+#endif // ESP8266NDN_HOST_BENCH_COMMON_HPP
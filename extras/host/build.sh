@@ -0,0 +1,30 @@
+#!/bin/bash
+# Build esp8266ndn host programs on Linux.
+# Usage: ./build.sh [extra compiler flags]
+set -e
+cd "$(dirname "$0")"
+SRC=../../src
+HOST=.
+OBJ=obj
+mkdir -p $OBJ
+
+CFLAGS="-O2 -g -ffunction-sections -fdata-sections -DARDUINO=10809 -I$HOST -I$SRC $*"
+CXXFLAGS="-std=c++14 $CFLAGS -include Arduino.h"
+
+OBJS=()
+for f in $(cd $SRC && find . -name '*.c' -o -name '*.cpp' | grep -v -e /ethernet-transport -e /udp-transport); do
+  o=$OBJ/$(echo ${f#./} | tr '/' '_').o
+  OBJS+=($o)
+  if [[ $f == *.c ]]; then
+    gcc $CFLAGS -w -c $SRC/$f -o $o &
+  else
+    g++ $CXXFLAGS -w -c $SRC/$f -o $o &
+  fi
+done
+wait
+
+g++ $CXXFLAGS -Wall -c arduino.cpp -o $OBJ/arduino.o
+for prog in udp-bench shm-bench eth-bench hc-bench ec-bench; do
+  g++ $CXXFLAGS -Wall -Wno-uninitialized -c $prog.cpp -o $OBJ/$prog.o
+  g++ -Wl,--gc-sections -o $prog $OBJ/$prog.o $OBJ/arduino.o "${OBJS[@]}"
+done
@@ -0,0 +1,61 @@
+// ./build.sh && sudo ./eth-bench IFACE-P IFACE-C [BATCH] [WINDOW] [SECONDS]
+//
+// Measures Face throughput over PosixEthernetTransport between two interfaces, such as a veth pair:
+//   ip link add ndnP type veth peer name ndnC
+//   ip link set ndnP up; ip link set ndnC up
+// A producer Face on IFACE-P answers every Interest with a Data signed by DigestKey; a consumer Face
+// on IFACE-C keeps WINDOW Interests outstanding. Interests are sent to the NDN multicast group and
+// Data are unicast back. BATCH is the number of TX ring frames per send syscall.
+
+#include "bench-common.hpp"
+
+int
+main(int argc, char** argv)
+{
+  if (argc < 3) {
+    fprintf(stderr, "%s IFACE-P IFACE-C [BATCH] [WINDOW] [SECONDS]\n", argv[0]);
+    return 2;
+  }
+  ndn::PosixEthernetTransport::Options opts;
+  opts.txBatch = argc > 3 ? atoi(argv[3]) : 16;
+  int window = argc > 4 ? atoi(argv[4]) : 64;
+  unsigned long duration = (argc > 5 ? atoi(argv[5]) : 5) * 1000UL;
+
+  ndn::PosixEthernetTransport producerTransport(opts);
+  ndn::PosixEthernetTransport consumerTransport(opts);
+  if (!producerTransport.begin(argv[1]) || !consumerTransport.begin(argv[2])) {
+    fprintf(stderr, "cannot open AF_PACKET sockets\n");
+    return 1;
+  }
+
+  ndn::Face producerFace(producerTransport);
+  producerFace.setSigningKey(g_key);
+  ndn::NameWCB<1> prefix;
+  char prefixUri[] = "/bench";
+  ndn::parseNameFromUri(prefix, prefixUri);
+  ndn::SimpleProducer producer(producerFace, prefix, &processInterest);
+
+  ndn::Face consumerFace(consumerTransport);
+  Consumer consumer(consumerFace, window);
+
+  unsigned long start = millis();
+  while (millis() - start < duration) {
+    consumer.loop();
+    consumerFace.loop(window);
+    producerFace.loop(window);
+  }
+  double seconds = (millis() - start) / 1000.0;
+
+  const auto& pc = producerTransport.getCounters();
+  const auto& cc = consumerTransport.getCounters();
+  printf("batch=%d window=%d seconds=%.1f\n", opts.txBatch, window, seconds);
+  printf("interests=%" PRIu64 " data=%" PRIu64 " data-per-sec=%.0f\n",
+         consumer.nInterests, consumer.nData, consumer.nData / seconds);
+  printf("producer rx-pkts=%" PRIu32 " rx-blocks=%" PRIu32 " tx-pkts=%" PRIu32
+         " tx-syscalls=%" PRIu32 " tx-full=%" PRIu32 "\n",
+         pc.nRxPkts, pc.nRxBlocks, pc.nTxPkts, pc.nTxSyscalls, pc.nTxFull);
+  printf("consumer rx-pkts=%" PRIu32 " rx-blocks=%" PRIu32 " tx-pkts=%" PRIu32
+         " tx-syscalls=%" PRIu32 " tx-full=%" PRIu32 "\n",
+         cc.nRxPkts, cc.nRxBlocks, cc.nTxPkts, cc.nTxSyscalls, cc.nTxFull);
+  return 0;
+}
@@ -0,0 +1,248 @@
+// ./build.sh && ./hc-bench [CORPUS-FILE [PREFIX...]]
+//
+// Measures HeaderCodec byte savings and CPU cost.
+// Without arguments, it runs on synthetic corpora: ping Interests and Data signed by DigestKey,
+// sensor readings signed by ECDSA, and segmented file retrieval.
+// CORPUS-FILE is a recorded trace of concatenated Interest and Data TLV elements; each PREFIX is
+// a name URI added to the dictionary, in the order that peers would use.
+// Every packet must decompress to its original octets, otherwise it is reported as a mismatch.
+
+#include <esp8266ndn.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+typedef std::vector<std::vector<uint8_t>> Corpus;
+
+/** \brief a transport that records sent packets
+ */
+class Recorder : public ndn::Transport
+{
+public:
+  size_t
+  receive(uint8_t* buf, size_t bufSize, uint64_t& endpointId) override
+  {
+    return 0;
+  }
+
+  ndn_Error
+  send(const uint8_t* pkt, size_t len, uint64_t endpointId) override
+  {
+    corpus.emplace_back(pkt, pkt + len);
+    return NDN_ERROR_success;
+  }
+
+public:
+  Corpus corpus;
+};
+
+static void
+appendUri(ndn::NameLite& name, const char* uri)
+{
+  static char buf[256];
+  snprintf(buf, sizeof(buf), "%s", uri);
+  ndn::parseNameFromUri(name, buf);
+}
+
+static Corpus
+makePing(int count)
+{
+  Recorder rec;
+  ndn::Face face(rec);
+  ndn::DigestKey key;
+  face.setSigningKey(key);
+  uint8_t seqBuf[9];
+  for (int i = 0; i < count; ++i) {
+    ndn::InterestWCB<8, 0> interest;
+    appendUri(interest.getName(), "/ndn/edu/ucla/ping");
+    interest.getName().appendSequenceNumber(random(), seqBuf, sizeof(seqBuf));
+    interest.setMustBeFresh(true);
+    face.sendInterest(interest);
+
+    ndn::DataWCB<8, 0> data;
+    data.getName().append(interest.getName());
+    data.getMetaInfo().setFreshnessPeriod(1);
+    face.sendData(data);
+  }
+  return rec.corpus;
+}
+
+static Corpus
+makeSensor(int count)
+{
+  Recorder rec;
+  ndn::Face face(rec);
+  ndn::NameWCB<8> keyName;
+  appendUri(keyName, "/ndn/edu/ucla/sensor/KEY/%01%02%03%04");
+  ndn::EcPrivateKey key(keyName);
+  ndn::EcPublicKey pub;
+  key.generate(pub);
+  face.setSigningKey(key);
+  uint8_t tsBuf[9];
+  for (int i = 0; i < count; ++i) {
+    ndn::DataWCB<8, 8> data;
+    appendUri(data.getName(), "/ndn/edu/ucla/sensor/temperature");
+    data.getName().appendTimestamp(1600000000000ULL + i * 60000, tsBuf, sizeof(tsBuf));
+    data.getMetaInfo().setFreshnessPeriod(60000);
+    uint8_t reading[4] = {0x41, 0xB4, static_cast<uint8_t>(i), 0x00};
+    data.setContent(ndn::BlobLite(reading, sizeof(reading)));
+    face.sendData(data);
+  }
+  return rec.corpus;
+}
+
+static Corpus
+makeSegments(int count)
+{
+  Recorder rec;
+  ndn::Face face(rec);
+  ndn::DigestKey key;
+  face.setSigningKey(key);
+  static uint8_t payload[200];
+  uint8_t verBuf[9], segBuf[9];
+  for (int i = 0; i < count; ++i) {
+    ndn::InterestWCB<8, 0> interest;
+    appendUri(interest.getName(), "/ndn/edu/ucla/file/firmware.bin");
+    interest.getName().appendVersion(1600000000, verBuf, sizeof(verBuf));
+    interest.getName().appendSegment(i, segBuf, sizeof(segBuf));
+    face.sendInterest(interest);
+
+    ndn::DataWCB<8, 0> data;
+    data.getName().append(interest.getName());
+    data.setContent(ndn::BlobLite(payload, sizeof(payload)));
+    face.sendData(data);
+  }
+  return rec.corpus;
+}
+
+static bool
+loadCorpus(const char* filename, Corpus& corpus)
+{
+  FILE* f = fopen(filename, "rb");
+  if (f == nullptr) {
+    return false;
+  }
+  std::vector<uint8_t> file;
+  uint8_t chunk[4096];
+  size_t n;
+  while ((n = fread(chunk, 1, sizeof(chunk), f)) > 0) {
+    file.insert(file.end(), chunk, chunk + n);
+  }
+  fclose(f);
+
+  size_t pos = 0;
+  while (pos < file.size()) {
+    ndn_TlvStructureDecoder decoder;
+    ndn_TlvStructureDecoder_initialize(&decoder);
+    if (ndn_TlvStructureDecoder_findElementEnd(&decoder, &file[pos], file.size() - pos) !=
+          NDN_ERROR_success || !decoder.gotElementEnd) {
+      fprintf(stderr, "truncated TLV at offset %zu\n", pos);
+      return false;
+    }
+    corpus.emplace_back(&file[pos], &file[pos + decoder.offset]);
+    pos += decoder.offset;
+  }
+  return true;
+}
+
+template<typename F>
+static double
+measureNanos(int nRounds, const F& f)
+{
+  auto t0 = std::chrono::steady_clock::now();
+  for (int i = 0; i < nRounds; ++i) {
+    f();
+  }
+  auto t1 = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(t1 - t0).count() / nRounds;
+}
+
+static void
+runCorpus(const char* title, const ndn::HeaderCodec& codec, const Corpus& corpus)
+{
+  static const int N_ROUNDS = 200;
+  std::vector<std::vector<uint8_t>> compressed(corpus.size());
+  size_t nCompressed = 0, nMismatches = 0, origOctets = 0, wireOctets = 0;
+  uint8_t buf[9000];
+  for (size_t i = 0; i < corpus.size(); ++i) {
+    const auto& pkt = corpus[i];
+    size_t len = codec.compress(pkt.data(), pkt.size(), buf, sizeof(buf));
+    origOctets += pkt.size();
+    if (len == 0) {
+      wireOctets += pkt.size();
+      continue;
+    }
+    ++nCompressed;
+    wireOctets += len;
+    compressed[i].assign(buf, buf + len);
+
+    uint8_t plain[9000];
+    size_t plainLen = codec.decompress(buf, len, plain, sizeof(plain));
+    if (plainLen != pkt.size() || std::memcmp(plain, pkt.data(), plainLen) != 0) {
+      ++nMismatches;
+    }
+  }
+
+  double compressNs = measureNanos(N_ROUNDS, [&] {
+    for (const auto& pkt : corpus) {
+      codec.compress(pkt.data(), pkt.size(), buf, sizeof(buf));
+    }
+  }) / corpus.size();
+  double decompressNs = measureNanos(N_ROUNDS, [&] {
+    for (const auto& pkt : compressed) {
+      if (!pkt.empty()) {
+        codec.decompress(pkt.data(), pkt.size(), buf, sizeof(buf));
+      }
+    }
+  }) / std::max<size_t>(nCompressed, 1);
+
+  printf("%-10s pkts=%zu compressed=%zu mismatches=%zu octets=%zu->%zu saved=%.1f%% "
+         "avg-saved=%.1f compress-ns=%.0f decompress-ns=%.0f\n",
+         title, corpus.size(), nCompressed, nMismatches, origOctets, wireOctets,
+         100.0 * (origOctets - wireOctets) / origOctets,
+         static_cast<double>(origOctets - wireOctets) / corpus.size(), compressNs, decompressNs);
+}
+
+int
+main(int argc, char** argv)
+{
+  ndn::HeaderCodec codec(1024);
+  if (argc > 1) {
+    Corpus corpus;
+    if (!loadCorpus(argv[1], corpus) || corpus.empty()) {
+      fprintf(stderr, "cannot load corpus %s\n", argv[1]);
+      return 1;
+    }
+    for (int i = 2; i < argc; ++i) {
+      ndn::NameWCB<16> prefix;
+      appendUri(prefix, argv[i]);
+      if (!codec.addPrefix(prefix)) {
+        fprintf(stderr, "cannot add prefix %s\n", argv[i]);
+        return 1;
+      }
+    }
+    runCorpus(argv[1], codec, corpus);
+    return 0;
+  }
+
+  Corpus ping = makePing(500);
+  Corpus sensor = makeSensor(100);
+  Corpus segments = makeSegments(500);
+  printf("# empty dictionary\n");
+  runCorpus("ping", codec, ping);
+  runCorpus("sensor", codec, sensor);
+  runCorpus("segments", codec, segments);
+
+  ndn::NameWCB<4> prefix;
+  appendUri(prefix, "/ndn/edu/ucla");
+  codec.addPrefix(prefix);
+  printf("# dictionary /ndn/edu/ucla\n");
+  runCorpus("ping", codec, ping);
+  runCorpus("sensor", codec, sensor);
+  runCorpus("segments", codec, segments);
+  return 0;
+}
@@ -0,0 +1,17 @@
+#ifndef ESP8266NDN_HOST_PGMSPACE_H
+#define ESP8266NDN_HOST_PGMSPACE_H
+
+#include <cstdint>
+#include <cstring>
+
+#define PROGMEM
+#define PSTR(s) (s)
+#define memcpy_P memcpy
+#define strlen_P strlen
+#define pgm_read_byte(p) (*reinterpret_cast<const uint8_t*>(p))
+#define pgm_read_dword(p) (*reinterpret_cast<const uint32_t*>(p))
+
+class __FlashStringHelper;
+#define F(s) (reinterpret_cast<const __FlashStringHelper*>(s))
+
+#endif // ESP8266NDN_HOST_PGMSPACE_H
@@ -0,0 +1,82 @@
+// ./build.sh && ./shm-bench [WINDOW] [SECONDS]
+//
+// Measures Face throughput over ShmTransport between two processes.
+// The child process runs a producer Face that answers every Interest with a Data signed by
+// DigestKey; the parent process runs a consumer Face that keeps WINDOW Interests outstanding.
+// No kernel socket is involved, so the result is an upper bound of Face and codec throughput.
+
+#include "bench-common.hpp"
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+static const char SHM_NAME[] = "/esp8266ndn-shm-bench";
+
+static int
+runProducer(unsigned long duration)
+{
+  ndn::ShmTransport transport;
+  if (!transport.beginAttach(SHM_NAME)) {
+    fprintf(stderr, "cannot attach shared memory\n");
+    return 1;
+  }
+
+  ndn::Face face(transport);
+  face.setSigningKey(g_key);
+  ndn::NameWCB<1> prefix;
+  char prefixUri[] = "/bench";
+  ndn::parseNameFromUri(prefix, prefixUri);
+  ndn::SimpleProducer producer(face, prefix, &processInterest);
+
+  unsigned long start = millis();
+  while (millis() - start < duration) {
+    face.loop(64);
+    transport.wait(10);
+  }
+
+  const auto& cnt = transport.getCounters();
+  printf("producer rx-pkts=%" PRIu32 " tx-pkts=%" PRIu32 " tx-full=%" PRIu32
+         " waits=%" PRIu32 " wakes=%" PRIu32 "\n",
+         cnt.nRxPkts, cnt.nTxPkts, cnt.nTxFull, cnt.nWaits, cnt.nWakes);
+  return 0;
+}
+
+int
+main(int argc, char** argv)
+{
+  int window = argc > 1 ? atoi(argv[1]) : 64;
+  unsigned long duration = (argc > 2 ? atoi(argv[2]) : 5) * 1000UL;
+
+  ndn::ShmTransport transport;
+  if (!transport.beginCreate(SHM_NAME)) {
+    fprintf(stderr, "cannot create shared memory\n");
+    return 1;
+  }
+  fflush(stdout);
+  pid_t child = fork();
+  if (child == 0) {
+    return runProducer(duration + 200);
+  }
+
+  ndn::Face face(transport);
+  Consumer consumer(face, window);
+
+  unsigned long start = millis();
+  while (millis() - start < duration) {
+    consumer.loop();
+    face.loop(window);
+    transport.wait(10);
+  }
+  double seconds = (millis() - start) / 1000.0;
+
+  const auto& cnt = transport.getCounters();
+  printf("window=%d seconds=%.1f\n", window, seconds);
+  printf("interests=%" PRIu64 " data=%" PRIu64 " data-per-sec=%.0f\n",
+         consumer.nInterests, consumer.nData, consumer.nData / seconds);
+  printf("consumer rx-pkts=%" PRIu32 " tx-pkts=%" PRIu32 " tx-full=%" PRIu32
+         " waits=%" PRIu32 " wakes=%" PRIu32 "\n",
+         cnt.nRxPkts, cnt.nTxPkts, cnt.nTxFull, cnt.nWaits, cnt.nWakes);
+  fflush(stdout);
+  waitpid(child, nullptr, 0);
+  return 0;
+}
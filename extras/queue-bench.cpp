@@ -0,0 +1,148 @@
+// g++ -std=c++14 -O2 -pthread -o queue-bench queue-bench.cpp
+//
+// Compares ndn::detail::SafeQueue (lock-free SPSC) against a locking queue that copies
+// items under a critical section, similar to FreeRTOS xQueueSend/xQueueReceive.
+// One thread pushes timestamps, another thread pops them; run it on a machine with two or more
+// CPU cores, otherwise the numbers mostly reflect scheduler behavior.
+
+#include "../src/transport/detail/queue.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+static uint64_t
+nowNs()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+    Clock::now().time_since_epoch()).count();
+}
+
+template<typename T, int CAPACITY>
+class LockingQueue
+{
+public:
+  bool
+  push(T item)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_count == CAPACITY) {
+      return false;
+    }
+    std::memcpy(&m_arr[(m_head + m_count) % CAPACITY], &item, sizeof(T));
+    ++m_count;
+    return true;
+  }
+
+  std::tuple<T, bool>
+  pop()
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_count == 0) {
+      return std::make_tuple(T(), false);
+    }
+    T item;
+    std::memcpy(&item, &m_arr[m_head], sizeof(T));
+    m_head = (m_head + 1) % CAPACITY;
+    --m_count;
+    return std::make_tuple(item, true);
+  }
+
+private:
+  std::mutex m_mutex;
+  T m_arr[CAPACITY];
+  int m_head = 0;
+  int m_count = 0;
+};
+
+struct Result
+{
+  double mops;
+  uint64_t p50;
+  uint64_t p99;
+  uint64_t p999;
+  uint64_t max;
+};
+
+/** \brief Run one trial.
+ *  \param gapNs producer pacing between pushes; zero means unpaced
+ */
+template<typename Q>
+static Result
+runTrial(int count, uint64_t gapNs)
+{
+  std::unique_ptr<Q> q(new Q);
+  std::vector<uint64_t> latency;
+  latency.reserve(count);
+
+  uint64_t t0 = nowNs();
+  std::thread consumer([&] {
+    while (static_cast<int>(latency.size()) < count) {
+      uint64_t ts;
+      bool ok;
+      std::tie(ts, ok) = q->pop();
+      if (ok) {
+        latency.push_back(nowNs() - ts);
+      }
+      else {
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  uint64_t next = nowNs();
+  for (int i = 0; i < count; ++i) {
+    if (gapNs > 0) {
+      while (nowNs() < next)
+        ;
+      next += gapNs;
+    }
+    while (!q->push(nowNs())) {
+      std::this_thread::yield();
+    }
+  }
+  consumer.join();
+  uint64_t t1 = nowNs();
+
+  std::sort(latency.begin(), latency.end());
+  Result res;
+  res.mops = 1e3 * count / (t1 - t0);
+  res.p50 = latency[count / 2];
+  res.p99 = latency[count * 99 / 100];
+  res.p999 = latency[count * 999 / 1000];
+  res.max = latency.back();
+  return res;
+}
+
+static void
+print(const char* name, const Result& res)
+{
+  std::printf("%-10s %8.2f Mops/s  p50=%6" PRIu64 "ns p99=%8" PRIu64 "ns p99.9=%8" PRIu64
+              "ns max=%10" PRIu64 "ns\n", name, res.mops, res.p50, res.p99, res.p999, res.max);
+}
+
+int
+main(int argc, char** argv)
+{
+  int count = argc > 1 ? std::atoi(argv[1]) : 4000000;
+  const int CAPACITY = 64;
+
+  std::printf("unpaced, %d items, capacity %d\n", count, CAPACITY);
+  print("spsc", runTrial<ndn::detail::SafeQueue<uint64_t, CAPACITY>>(count, 0));
+  print("locking", runTrial<LockingQueue<uint64_t, CAPACITY>>(count, 0));
+
+  int pacedCount = count / 20;
+  std::printf("paced at 1us, %d items, capacity %d\n", pacedCount, CAPACITY);
+  print("spsc", runTrial<ndn::detail::SafeQueue<uint64_t, CAPACITY>>(pacedCount, 1000));
+  print("locking", runTrial<LockingQueue<uint64_t, CAPACITY>>(pacedCount, 1000));
+  return 0;
+}
@@ -0,0 +1,28 @@
+#!/bin/bash
+# Build the esp8266ndn network simulator on a Linux host.
+# Usage: ./build.sh [extra compiler flags]
+set -e
+cd "$(dirname "$0")"
+SRC=../../src
+HOST=../host
+OBJ=obj
+mkdir -p $OBJ
+
+CFLAGS="-O2 -g -ffunction-sections -fdata-sections -DARDUINO=10809 -I$HOST -I$SRC $*"
+CXXFLAGS="-std=c++14 $CFLAGS -include Arduino.h"
+
+OBJS=()
+for f in $(cd $SRC && find . -name '*.c' -o -name '*.cpp' | grep -v -e /ethernet-transport -e /udp-transport); do
+  o=$OBJ/$(echo ${f#./} | tr '/' '_').o
+  OBJS+=($o)
+  if [[ $f == *.c ]]; then
+    gcc $CFLAGS -w -c $SRC/$f -o $o &
+  else
+    g++ $CXXFLAGS -w -c $SRC/$f -o $o &
+  fi
+done
+wait
+
+g++ $CXXFLAGS -Wall -Wno-uninitialized -c ndnsim.cpp -o $OBJ/ndnsim.o
+g++ $CXXFLAGS -Wall -Wno-uninitialized -c scenarios.cpp -o $OBJ/scenarios.o
+g++ -Wl,--gc-sections -o ndnsim $OBJ/ndnsim.o $OBJ/scenarios.o "${OBJS[@]}"
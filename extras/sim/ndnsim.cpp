@@ -0,0 +1,417 @@
+#include "ndnsim.hpp"
+
+#include <cinttypes>
+#include <new>
+
+namespace ndnsim {
+
+static Simulator* g_current = nullptr;
+static Node* g_heapNode = nullptr;
+static bool g_wantHeapAccounting = false;
+
+/** \brief header prepended to every heap allocation
+ */
+struct alignas(std::max_align_t) HeapHeader
+{
+  Node* node;
+  size_t size;
+};
+
+void*
+HeapScope::allocate(size_t size)
+{
+  auto hdr = static_cast<HeapHeader*>(std::malloc(sizeof(HeapHeader) + size));
+  if (hdr == nullptr) {
+    throw std::bad_alloc();
+  }
+  hdr->node = g_wantHeapAccounting ? g_heapNode : nullptr;
+  hdr->size = size;
+  if (hdr->node != nullptr) {
+    hdr->node->m_heapCur += size;
+    hdr->node->m_heapPeak = std::max(hdr->node->m_heapPeak, hdr->node->m_heapCur);
+  }
+  return hdr + 1;
+}
+
+void
+HeapScope::deallocate(void* ptr)
+{
+  if (ptr == nullptr) {
+    return;
+  }
+  auto hdr = static_cast<HeapHeader*>(ptr) - 1;
+  if (hdr->node != nullptr && g_wantHeapAccounting) {
+    hdr->node->m_heapCur -= hdr->size;
+  }
+  std::free(hdr);
+}
+
+HeapScope::HeapScope(Node* node)
+  : m_prev(g_heapNode)
+{
+  g_heapNode = node;
+}
+
+HeapScope::~HeapScope()
+{
+  g_heapNode = m_prev;
+}
+
+SimTransport::SimTransport(Simulator& sim, Node& node)
+  : m_sim(sim)
+  , m_node(node)
+{
+}
+
+size_t
+SimTransport::receive(uint8_t* buf, size_t bufSize, uint64_t& endpointId)
+{
+  if (m_rxQueue.empty()) {
+    return 0;
+  }
+  RxPacket pkt = std::move(m_rxQueue.front());
+  m_rxQueue.pop_front();
+
+  const std::vector<uint8_t>& wire = *pkt.wire;
+  if (wire.size() > bufSize) {
+    return 0;
+  }
+  std::copy(wire.begin(), wire.end(), buf);
+  endpointId = pkt.endpointId;
+  ++m_cnt.nRxPkts;
+  m_cnt.nRxOctets += wire.size();
+  return wire.size();
+}
+
+ndn_Error
+SimTransport::send(const uint8_t* pkt, size_t len, uint64_t endpointId)
+{
+  ++m_cnt.nTxPkts;
+  m_cnt.nTxOctets += len;
+  switch (len == 0 ? 0 : pkt[0]) {
+    case 0x05:
+      ++m_cnt.nTxInterests;
+      break;
+    case 0x06:
+      ++m_cnt.nTxData;
+      break;
+    case 0x64:
+      ++m_cnt.nTxLpPackets;
+      break;
+  }
+  m_sim.transmit(m_node, pkt, len, endpointId);
+  return NDN_ERROR_success;
+}
+
+size_t
+SimTransport::getMtu() const
+{
+  size_t mtu = 0;
+  for (int linkIndex : m_node.m_links) {
+    size_t linkMtu = m_sim.m_links[linkIndex].options.mtu;
+    if (linkMtu > 0 && (mtu == 0 || linkMtu < mtu)) {
+      mtu = linkMtu;
+    }
+  }
+  return mtu;
+}
+
+void
+SimTransport::deliver(std::shared_ptr<const std::vector<uint8_t>> wire, uint64_t endpointId)
+{
+  if (m_rxQueue.size() >= rxQueueCapacity) {
+    ++m_cnt.nDropFull;
+    return;
+  }
+  m_rxQueue.push_back({std::move(wire), endpointId});
+}
+
+Node::Node(Simulator& sim, int index)
+  : index(index)
+  , transport(sim, *this)
+  , face(transport)
+  , m_sim(sim)
+{
+}
+
+void
+Node::loop()
+{
+  HeapScope scope(this);
+  face.loop(static_cast<int>(transport.m_rxQueue.size()) + 1);
+}
+
+void
+Node::tick()
+{
+  this->loop();
+  HeapScope scope(this);
+  for (const auto& f : m_tickFuncs) {
+    f();
+  }
+}
+
+Time
+Samples::percentile(double p)
+{
+  if (m_values.empty()) {
+    return 0;
+  }
+  if (!m_isSorted) {
+    std::sort(m_values.begin(), m_values.end());
+    m_isSorted = true;
+  }
+  size_t i = static_cast<size_t>(p * (m_values.size() - 1) + 0.5);
+  return m_values[std::min(i, m_values.size() - 1)];
+}
+
+double
+Samples::mean() const
+{
+  if (m_values.empty()) {
+    return 0.0;
+  }
+  double sum = 0.0;
+  for (Time v : m_values) {
+    sum += v;
+  }
+  return sum / m_values.size();
+}
+
+Simulator::Simulator(uint32_t seed)
+  : m_eventSeq(0)
+  , m_rng(seed)
+  , m_nEvents(0)
+{
+  g_current = this;
+  ndn::setClock(m_clock);
+  g_wantHeapAccounting = true;
+  std::srand(seed);
+}
+
+Simulator::~Simulator()
+{
+  g_wantHeapAccounting = false;
+  m_nodes.clear();
+  if (g_current == this) {
+    g_current = nullptr;
+    static ndn::SystemClock systemClock;
+    ndn::setClock(systemClock);
+  }
+}
+
+Simulator*
+Simulator::getCurrent()
+{
+  return g_current;
+}
+
+Node&
+Simulator::addNode()
+{
+  int index = static_cast<int>(m_nodes.size());
+  Node* node = new Node(*this, index);
+  m_nodes.emplace_back(node);
+  node->loop(); // Face allocates its receive buffer on first loop
+  this->scheduleTick(*node, this->now() + m_rng() % tickInterval);
+  return *node;
+}
+
+int
+Simulator::addLink(const std::vector<Node*>& members, const LinkOptions& options)
+{
+  int index = static_cast<int>(m_links.size());
+  m_links.push_back({options, members, std::vector<Time>(members.size(), 0)});
+  for (Node* node : members) {
+    node->m_links.push_back(index);
+  }
+  return index;
+}
+
+void
+Simulator::schedule(Time t, std::function<void()> f)
+{
+  HeapScope scope(nullptr);
+  m_events.push({std::max(t, this->now()), m_eventSeq++, std::move(f)});
+}
+
+void
+Simulator::scheduleTick(Node& node, Time t)
+{
+  this->schedule(t, [this, &node] {
+    node.tick();
+    this->scheduleTick(node, this->now() + tickInterval);
+  });
+}
+
+void
+Simulator::run(Time until)
+{
+  g_current = this;
+  ndn::setClock(m_clock);
+  while (!m_events.empty() && m_events.top().t <= until) {
+    Event evt = m_events.top();
+    m_events.pop();
+    m_clock.set(evt.t);
+    ++m_nEvents;
+    evt.f();
+  }
+  m_clock.set(std::max(this->now(), until));
+}
+
+void
+Simulator::transmit(Node& src, const uint8_t* pkt, size_t len, uint64_t endpointId)
+{
+  HeapScope scope(nullptr); // simulator internals are not part of node memory usage
+  auto wire = std::make_shared<const std::vector<uint8_t>>(pkt, pkt + len);
+  Node* dst = endpointId == 0 ? nullptr : m_nodes.at(endpointId - 1).get();
+  uint64_t srcEndpointId = src.index + 1;
+
+  for (int linkIndex : src.m_links) {
+    Link& link = m_links[linkIndex];
+    auto srcPos = std::find(link.members.begin(), link.members.end(), &src) - link.members.begin();
+    if (dst != nullptr && std::find(link.members.begin(), link.members.end(), dst) == link.members.end()) {
+      continue;
+    }
+
+    Time& busyUntil = link.busyUntil[srcPos];
+    Time departure = std::max(this->now(), busyUntil);
+    if (link.options.bandwidth > 0) {
+      departure += static_cast<Time>(len) * 1000000 / link.options.bandwidth;
+    }
+    busyUntil = departure;
+
+    for (Node* member : link.members) {
+      if (member == &src || (dst != nullptr && member != dst)) {
+        continue;
+      }
+      if (link.options.loss > 0.0 && this->uniform() < link.options.loss) {
+        member->transport.countLoss();
+        continue;
+      }
+      Time arrival = departure + link.options.delay;
+      if (link.options.jitter > 0) {
+        arrival += m_rng() % (link.options.jitter + 1);
+      }
+      this->schedule(arrival, [member, wire, srcEndpointId] {
+        member->transport.deliver(wire, srcEndpointId);
+        member->loop();
+      });
+    }
+
+    if (dst != nullptr) {
+      break;
+    }
+  }
+}
+
+void
+Simulator::printReport(Print& output, bool perNode) const
+{
+  SimTransport::Counters total;
+  size_t heapTotal = 0;
+  size_t heapMax = 0;
+  if (perNode) {
+    output.println(F("node txPkts txOctets rxPkts rxOctets txInterests txData txLp lost dropFull heapCur heapPeak"));
+  }
+  for (const auto& node : m_nodes) {
+    const SimTransport::Counters& cnt = node->transport.getCounters();
+    if (perNode) {
+      output.printf("%d %" PRIu32 " %" PRIu64 " %" PRIu32 " %" PRIu64 " %" PRIu32 " %" PRIu32 " %" PRIu32
+                    " %" PRIu32 " %" PRIu32 " %zu %zu\n",
+                    node->index, cnt.nTxPkts, cnt.nTxOctets, cnt.nRxPkts, cnt.nRxOctets,
+                    cnt.nTxInterests, cnt.nTxData, cnt.nTxLpPackets, cnt.nLost, cnt.nDropFull,
+                    node->getHeapUsage(), node->getHeapPeak());
+    }
+    total.nTxPkts += cnt.nTxPkts;
+    total.nTxOctets += cnt.nTxOctets;
+    total.nRxPkts += cnt.nRxPkts;
+    total.nRxOctets += cnt.nRxOctets;
+    total.nTxInterests += cnt.nTxInterests;
+    total.nTxData += cnt.nTxData;
+    total.nTxLpPackets += cnt.nTxLpPackets;
+    total.nLost += cnt.nLost;
+    total.nDropFull += cnt.nDropFull;
+    heapTotal += node->getHeapPeak();
+    heapMax = std::max(heapMax, node->getHeapPeak());
+  }
+
+  output.printf("nodes=%zu links=%zu events=%" PRIu64 " virtual-time=%" PRIu64 "ms\n",
+                m_nodes.size(), m_links.size(), m_nEvents, this->now() / 1000);
+  output.printf("tx-pkts=%" PRIu32 " tx-octets=%" PRIu64 " rx-pkts=%" PRIu32 " rx-octets=%" PRIu64 "\n",
+                total.nTxPkts, total.nTxOctets, total.nRxPkts, total.nRxOctets);
+  output.printf("tx-interests=%" PRIu32 " tx-data=%" PRIu32 " tx-lp=%" PRIu32
+                " lost=%" PRIu32 " drop-full=%" PRIu32 "\n",
+                total.nTxInterests, total.nTxData, total.nTxLpPackets, total.nLost, total.nDropFull);
+  output.printf("sizeof(Face)=%zu heap-peak-max=%zu heap-peak-mean=%zu\n",
+                sizeof(ndn::Face), heapMax, m_nodes.empty() ? 0 : heapTotal / m_nodes.size());
+}
+
+} // namespace ndnsim
+
+void*
+operator new(size_t size)
+{
+  return ndnsim::HeapScope::allocate(size);
+}
+
+void*
+operator new[](size_t size)
+{
+  return ndnsim::HeapScope::allocate(size);
+}
+
+void
+operator delete(void* ptr) noexcept
+{
+  ndnsim::HeapScope::deallocate(ptr);
+}
+
+void
+operator delete[](void* ptr) noexcept
+{
+  ndnsim::HeapScope::deallocate(ptr);
+}
+
+void
+operator delete(void* ptr, size_t) noexcept
+{
+  ndnsim::HeapScope::deallocate(ptr);
+}
+
+void
+operator delete[](void* ptr, size_t) noexcept
+{
+  ndnsim::HeapScope::deallocate(ptr);
+}
+
+unsigned long
+millis()
+{
+  ndnsim::Simulator* sim = ndnsim::Simulator::getCurrent();
+  return sim == nullptr ? 0 : static_cast<unsigned long>(sim->now() / 1000);
+}
+
+unsigned long
+micros()
+{
+  ndnsim::Simulator* sim = ndnsim::Simulator::getCurrent();
+  return sim == nullptr ? 0 : static_cast<unsigned long>(sim->now());
+}
+
+void
+delay(unsigned long)
+{
+  // Blocking waits cannot advance virtual time; firmware logic under simulation must be
+  // written as loop() functions.
+}
+
+long
+random(long max)
+{
+  ndnsim::Simulator* sim = ndnsim::Simulator::getCurrent();
+  if (max <= 0 || sim == nullptr) {
+    return 0;
+  }
+  return static_cast<long>(sim->getRng()() % static_cast<unsigned long>(max));
+}
@@ -0,0 +1,377 @@
+#ifndef ESP8266NDN_SIM_NDNSIM_HPP
+#define ESP8266NDN_SIM_NDNSIM_HPP
+
+// Discrete-event simulator that runs many esp8266ndn Face instances in one host process.
+//
+// Every Node owns a SimTransport and a Face. Nodes are attached to links: a link with two
+// members is a point-to-point link, a link with more members is a broadcast domain. A packet
+// sent to endpointId 0 is transmitted on every link of the node and received by every other
+// member; a packet sent to a nonzero endpointId goes to that node only. Incoming packets carry
+// the sender's node index plus one as endpointId.
+//
+// The simulator installs a VirtualClock with ndn::setClock(), and millis() and micros() read the
+// same clock, so firmware timers (PingClient intervals, reassembly timeouts, retransmissions)
+// run at simulation speed.
+
+#include <Arduino.h>
+#include <core/clock.hpp>
+#include <core/face.hpp>
+#include <transport/transport.hpp>
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <random>
+#include <vector>
+
+namespace ndnsim {
+
+/** \brief virtual time, in micros
+ */
+typedef uint64_t Time;
+
+class Simulator;
+class Node;
+
+/** \brief link properties
+ */
+class LinkOptions
+{
+public:
+  Time delay = 1000;          ///< propagation delay, in micros
+  Time jitter = 0;            ///< random extra delay within [0, jitter], in micros
+  uint32_t bandwidth = 0;     ///< transmission rate in octets per second, 0 means unlimited
+  double loss = 0.0;          ///< independent loss probability at each receiver
+  size_t mtu = 0;             ///< MTU reported by SimTransport, 0 means unlimited
+};
+
+/** \brief transport that delivers packets through simulated links
+ */
+class SimTransport : public ndn::Transport
+{
+public:
+  class Counters
+  {
+  public:
+    uint32_t nTxPkts = 0;
+    uint64_t nTxOctets = 0;
+    uint32_t nRxPkts = 0;
+    uint64_t nRxOctets = 0;
+    uint32_t nTxInterests = 0;
+    uint32_t nTxData = 0;
+    uint32_t nTxLpPackets = 0;  ///< Nacks and fragments
+    uint32_t nLost = 0;         ///< packets lost on links toward this node
+    uint32_t nDropFull = 0;     ///< packets dropped because receive queue is full
+  };
+
+  SimTransport(Simulator& sim, Node& node);
+
+  size_t
+  receive(uint8_t* buf, size_t bufSize, uint64_t& endpointId) override;
+
+  ndn_Error
+  send(const uint8_t* pkt, size_t len, uint64_t endpointId) override;
+
+  size_t
+  getMtu() const override;
+
+  const Counters&
+  getCounters() const
+  {
+    return m_cnt;
+  }
+
+  /** \brief max number of packets waiting in receive queue
+   */
+  size_t rxQueueCapacity = 64;
+
+private:
+  struct RxPacket
+  {
+    std::shared_ptr<const std::vector<uint8_t>> wire;
+    uint64_t endpointId;
+  };
+
+  void
+  deliver(std::shared_ptr<const std::vector<uint8_t>> wire, uint64_t endpointId);
+
+  void
+  countLoss()
+  {
+    ++m_cnt.nLost;
+  }
+
+private:
+  Simulator& m_sim;
+  Node& m_node;
+  std::deque<RxPacket> m_rxQueue;
+  Counters m_cnt;
+
+  friend class Simulator;
+  friend class Node;
+};
+
+/** \brief a simulated device
+ */
+class Node
+{
+public:
+  Node(Simulator& sim, int index);
+
+  /** \brief construct an object owned by this node, such as a PacketHandler or a name buffer
+   *
+   *  Heap allocations made by the constructor are accounted to this node.
+   */
+  template<typename T, typename... Args>
+  T&
+  emplace(Args&&... args);
+
+  /** \brief add a function invoked on every tick, such as PingClient::loop()
+   */
+  void
+  onTick(std::function<void()> f)
+  {
+    m_tickFuncs.push_back(std::move(f));
+  }
+
+  /** \brief current heap usage of objects allocated on behalf of this node
+   */
+  size_t
+  getHeapUsage() const
+  {
+    return m_heapCur;
+  }
+
+  size_t
+  getHeapPeak() const
+  {
+    return m_heapPeak;
+  }
+
+private:
+  void
+  loop();
+
+  void
+  tick();
+
+public:
+  const int index;
+  SimTransport transport;
+  ndn::Face face;
+
+private:
+  Simulator& m_sim;
+  std::vector<std::shared_ptr<void>> m_objects;
+  std::vector<std::function<void()>> m_tickFuncs;
+  std::vector<int> m_links;
+  size_t m_heapCur = 0;
+  size_t m_heapPeak = 0;
+
+  friend class Simulator;
+  friend class SimTransport;
+  friend class HeapScope;
+};
+
+/** \brief collection of duration samples
+ */
+class Samples
+{
+public:
+  void
+  add(Time value)
+  {
+    m_values.push_back(value);
+  }
+
+  size_t
+  size() const
+  {
+    return m_values.size();
+  }
+
+  /** \brief get percentile
+   *  \param p percentile between 0.0 and 1.0
+   */
+  Time
+  percentile(double p);
+
+  double
+  mean() const;
+
+private:
+  std::vector<Time> m_values;
+  bool m_isSorted = false;
+};
+
+/** \brief discrete-event simulator
+ */
+class Simulator
+{
+public:
+  explicit
+  Simulator(uint32_t seed = 1);
+
+  ~Simulator();
+
+  /** \brief get the running simulator, used by millis() and micros()
+   */
+  static Simulator*
+  getCurrent();
+
+  Time
+  now() const
+  {
+    return m_clock.now();
+  }
+
+  /** \brief create a node
+   *
+   *  Nodes are ticked every \c tickInterval, and additionally whenever a packet arrives.
+   */
+  Node&
+  addNode();
+
+  /** \brief create a link among \p members
+   *  \return link index
+   */
+  int
+  addLink(const std::vector<Node*>& members, const LinkOptions& options);
+
+  int
+  addLink(const std::vector<Node*>& members)
+  {
+    return addLink(members, LinkOptions());
+  }
+
+  Node&
+  getNode(int index)
+  {
+    return *m_nodes.at(index);
+  }
+
+  size_t
+  size() const
+  {
+    return m_nodes.size();
+  }
+
+  /** \brief invoke \p f at time \p t
+   */
+  void
+  schedule(Time t, std::function<void()> f);
+
+  /** \brief run until virtual time reaches \p until, or no event is left
+   */
+  void
+  run(Time until);
+
+  /** \brief uniform random number in [0, 1)
+   */
+  double
+  uniform()
+  {
+    return std::uniform_real_distribution<double>()(m_rng);
+  }
+
+  std::mt19937&
+  getRng()
+  {
+    return m_rng;
+  }
+
+  /** \brief print per-node and aggregate statistics
+   *  \param perNode whether to include a line for each node
+   */
+  void
+  printReport(Print& output, bool perNode) const;
+
+  /** \brief interval of periodic ticks, in micros
+   */
+  Time tickInterval = 10000;
+
+private:
+  struct Link
+  {
+    LinkOptions options;
+    std::vector<Node*> members;
+    std::vector<Time> busyUntil; ///< per member, when its transmitter becomes idle
+  };
+
+  struct Event
+  {
+    Time t;
+    uint64_t seq;
+    std::function<void()> f;
+  };
+
+  struct EventCompare
+  {
+    bool
+    operator()(const Event& a, const Event& b) const
+    {
+      return a.t > b.t || (a.t == b.t && a.seq > b.seq);
+    }
+  };
+
+  void
+  transmit(Node& src, const uint8_t* pkt, size_t len, uint64_t endpointId);
+
+  void
+  scheduleTick(Node& node, Time t);
+
+private:
+  ndn::VirtualClock m_clock;
+  uint64_t m_eventSeq;
+  std::priority_queue<Event, std::vector<Event>, EventCompare> m_events;
+  std::vector<std::unique_ptr<Node>> m_nodes;
+  std::vector<Link> m_links;
+  std::mt19937 m_rng;
+  uint64_t m_nEvents;
+
+  friend class SimTransport;
+};
+
+/** \brief account heap allocations in this scope to \p node
+ */
+class HeapScope
+{
+public:
+  explicit
+  HeapScope(Node* node);
+
+  ~HeapScope();
+
+  HeapScope(const HeapScope&) = delete;
+
+  HeapScope&
+  operator=(const HeapScope&) = delete;
+
+  /** \brief allocate memory, accounted to the node of innermost HeapScope
+   *
+   *  The simulator replaces global operator new and operator delete with these functions.
+   */
+  static void*
+  allocate(size_t size);
+
+  static void
+  deallocate(void* ptr);
+
+private:
+  Node* m_prev;
+};
+
+template<typename T, typename... Args>
+T&
+Node::emplace(Args&&... args)
+{
+  HeapScope scope(this);
+  auto obj = std::make_shared<T>(std::forward<Args>(args)...);
+  m_objects.push_back(obj);
+  return *obj;
+}
+
+} // namespace ndnsim
+
+#endif // ESP8266NDN_SIM_NDNSIM_HPP
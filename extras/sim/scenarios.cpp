@@ -0,0 +1,432 @@
+// ./build.sh && ./ndnsim ping 100 60
+//
+// Example scenarios for the esp8266ndn network simulator.
+//
+// ping  NODES SECONDS SEED  one PingServer and NODES-1 PingClients on a broadcast domain
+// nack  NODES SECONDS SEED  PingClients probe an unserved prefix; every other node responds Nack
+// cache NODES SECONDS SEED  consumers at leaves of a binary tree of caching relays fetch popular
+//                           Data from a producer at the root
+
+#include "ndnsim.hpp"
+
+#include <app/ping-client.hpp>
+#include <app/ping-server.hpp>
+#include <core/uri.hpp>
+#include <core/with-components-buffer.hpp>
+#include <security/digest-key.hpp>
+#include <ndn-cpp/lite/encoding/tlv-0_2-wire-format-lite.hpp>
+
+#include <cinttypes>
+#include <cstdio>
+#include <map>
+#include <string>
+
+using ndnsim::Node;
+using ndnsim::Samples;
+using ndnsim::Simulator;
+using ndnsim::Time;
+
+class StdoutPrint : public Print
+{
+public:
+  size_t
+  write(uint8_t c) override
+  {
+    return fwrite(&c, 1, 1, stdout);
+  }
+
+  size_t
+  write(const uint8_t* buf, size_t size) override
+  {
+    return fwrite(buf, 1, size, stdout);
+  }
+};
+
+static StdoutPrint g_stdout;
+static ndn::DigestKey g_key;
+
+/** \brief name used as map key
+ */
+static std::string
+nameKey(const ndn::NameLite& name)
+{
+  std::string key;
+  for (size_t i = 0; i < name.size(); ++i) {
+    const ndn::BlobLite& value = name.get(i).getValue();
+    key.push_back(static_cast<char>(value.size()));
+    key.append(reinterpret_cast<const char*>(value.buf()), value.size());
+  }
+  return key;
+}
+
+/** \brief measures PingClient round-trip time through its event callback
+ */
+class PingStats
+{
+public:
+  static void
+  onEvent(void* arg, ndn::PingClient::Event evt, uint64_t seq)
+  {
+    auto self = reinterpret_cast<PingStats*>(arg);
+    Time now = Simulator::getCurrent()->now();
+    switch (evt) {
+      case ndn::PingClient::Event::PROBE:
+        ++self->nProbes;
+        self->lastProbe = now;
+        break;
+      case ndn::PingClient::Event::RESPONSE:
+        ++self->nResponses;
+        self->rtt.add(now - self->lastProbe);
+        break;
+      case ndn::PingClient::Event::TIMEOUT:
+        ++self->nTimeouts;
+        break;
+      case ndn::PingClient::Event::NACK:
+        ++self->nNacks;
+        break;
+      default:
+        break;
+    }
+  }
+
+  void
+  print(Print& output)
+  {
+    output.printf("probes=%d responses=%d timeouts=%d nacks=%d\n",
+                  nProbes, nResponses, nTimeouts, nNacks);
+    output.printf("rtt-us mean=%.0f p50=%" PRIu64 " p90=%" PRIu64 " p99=%" PRIu64 " max=%" PRIu64 "\n",
+                  rtt.mean(), rtt.percentile(0.5), rtt.percentile(0.9), rtt.percentile(0.99),
+                  rtt.percentile(1.0));
+  }
+
+public:
+  int nProbes = 0;
+  int nResponses = 0;
+  int nTimeouts = 0;
+  int nNacks = 0;
+  Samples rtt;
+
+private:
+  Time lastProbe = 0;
+};
+
+static void
+addPingServer(Node& node, const char* prefixUri)
+{
+  auto& prefixBuf = node.emplace<std::string>(prefixUri);
+  auto& prefix = node.emplace<ndn::NameWCB<8>>();
+  ndn::parseNameFromUri(prefix, &prefixBuf[0]);
+  node.face.setSigningKey(g_key);
+  node.emplace<ndn::PingServer>(node.face, prefix);
+}
+
+static void
+addPingClient(Node& node, const char* prefixUri, PingStats& stats)
+{
+  auto& prefixBuf = node.emplace<std::string>(prefixUri);
+  auto& interest = node.emplace<ndn::InterestWCB<8, 0>>();
+  ndn::parseNameFromUri(interest.getName(), &prefixBuf[0]);
+  interest.setMustBeFresh(true);
+  interest.setInterestLifetimeMilliseconds(1000);
+  auto& client = node.emplace<ndn::PingClient>(node.face, interest, ndn::PingClient::Interval(2000, 500));
+  client.onEvent(&PingStats::onEvent, &stats);
+  node.onTick([&client] { client.loop(); });
+}
+
+static void
+runPing(Simulator& sim, int nNodes, Time duration, bool wantNack)
+{
+  std::vector<Node*> members;
+  for (int i = 0; i < nNodes; ++i) {
+    members.push_back(&sim.addNode());
+  }
+  ndnsim::LinkOptions link;
+  link.delay = 2000;
+  link.jitter = 1000;
+  link.bandwidth = 250000;
+  sim.addLink(members, link);
+
+  addPingServer(*members[0], "/sim/server/ping");
+  PingStats stats;
+  for (int i = 1; i < nNodes; ++i) {
+    Node& node = *members[i];
+    node.face.enableNack(wantNack);
+    addPingClient(node, wantNack ? "/sim/nobody/ping" : "/sim/server/ping", stats);
+  }
+
+  sim.run(duration);
+  sim.printReport(g_stdout, false);
+  stats.print(g_stdout);
+}
+
+/** \brief forwarder on a tree: sends Interests upstream, returns Data downstream, caches Data
+ */
+class CachingRelay : public ndn::PacketHandler
+{
+public:
+  class Counters
+  {
+  public:
+    int nInterests = 0;
+    int nHits = 0;
+    int nAggregated = 0;
+  };
+
+  CachingRelay(Node& node, uint64_t upstream, size_t csCapacity, Counters& cnt)
+    : m_node(node)
+    , m_upstream(upstream)
+    , m_csCapacity(csCapacity)
+    , m_cnt(cnt)
+  {
+    m_node.face.addHandler(this);
+  }
+
+  ~CachingRelay()
+  {
+    m_node.face.removeHandler(this);
+  }
+
+private:
+  struct PitEntry
+  {
+    std::vector<uint64_t> downstreams;
+    Time expiry;
+  };
+
+  struct CsEntry
+  {
+    std::vector<uint8_t> wire;
+    uint64_t lastUse;
+  };
+
+  bool
+  processInterest(const ndn::InterestLite& interest, uint64_t endpointId) override
+  {
+    ++m_cnt.nInterests;
+    Time now = Simulator::getCurrent()->now();
+    std::string key = nameKey(interest.getName());
+
+    auto cs = m_cs.find(key);
+    if (cs != m_cs.end() && !interest.getMustBeFresh()) {
+      ++m_cnt.nHits;
+      cs->second.lastUse = ++m_csClock;
+      m_node.face.sendPacket(cs->second.wire.data(), cs->second.wire.size(), endpointId);
+      return true;
+    }
+
+    auto pit = m_pit.find(key);
+    if (pit != m_pit.end() && pit->second.expiry > now) {
+      ++m_cnt.nAggregated;
+      pit->second.downstreams.push_back(endpointId);
+      return true;
+    }
+    m_pit[key] = {{endpointId}, now + static_cast<Time>(interest.getInterestLifetimeMilliseconds() * 1000)};
+    m_node.face.sendInterest(interest, m_upstream);
+    return true;
+  }
+
+  bool
+  processData(const ndn::DataLite& data, uint64_t endpointId) override
+  {
+    std::string key = nameKey(data.getName());
+    auto pit = m_pit.find(key);
+    if (pit == m_pit.end()) {
+      return true;
+    }
+
+    uint8_t buf[1500];
+    ndn::DynamicUInt8ArrayLite arr(buf, sizeof(buf), nullptr);
+    size_t signedBegin, signedEnd, len;
+    if (ndn::Tlv0_2WireFormatLite::encodeData(data, &signedBegin, &signedEnd, arr, &len) != NDN_ERROR_success) {
+      return true;
+    }
+    for (uint64_t downstream : pit->second.downstreams) {
+      m_node.face.sendPacket(buf, len, downstream);
+    }
+    m_pit.erase(pit);
+
+    if (m_csCapacity > 0) {
+      if (m_cs.size() >= m_csCapacity) {
+        auto lru = std::min_element(m_cs.begin(), m_cs.end(),
+          [] (const std::pair<const std::string, CsEntry>& a, const std::pair<const std::string, CsEntry>& b) {
+            return a.second.lastUse < b.second.lastUse;
+          });
+        m_cs.erase(lru);
+      }
+      m_cs[key] = {std::vector<uint8_t>(buf, buf + len), ++m_csClock};
+    }
+    return true;
+  }
+
+private:
+  Node& m_node;
+  const uint64_t m_upstream;
+  const size_t m_csCapacity;
+  Counters& m_cnt;
+  std::map<std::string, PitEntry> m_pit;
+  std::map<std::string, CsEntry> m_cs;
+  uint64_t m_csClock = 0;
+};
+
+/** \brief consumer that fetches /sim/data/<k> with Zipf-distributed k
+ */
+class CatalogConsumer : public ndn::PacketHandler
+{
+public:
+  class Counters
+  {
+  public:
+    int nInterests = 0;
+    int nData = 0;
+    Samples latency;
+  };
+
+  CatalogConsumer(Node& node, const std::vector<double>& cdf, Time interval, Counters& cnt)
+    : m_node(node)
+    , m_cdf(cdf)
+    , m_interval(interval)
+    , m_cnt(cnt)
+    , m_nextSend(0)
+  {
+    m_node.face.addHandler(this);
+    m_node.face.enableNack(false);
+  }
+
+  ~CatalogConsumer()
+  {
+    m_node.face.removeHandler(this);
+  }
+
+  void
+  loop()
+  {
+    Simulator& sim = *Simulator::getCurrent();
+    if (sim.now() < m_nextSend) {
+      return;
+    }
+    m_nextSend = sim.now() + m_interval / 2 + sim.getRng()() % m_interval;
+
+    int k = std::lower_bound(m_cdf.begin(), m_cdf.end(), sim.uniform()) - m_cdf.begin();
+    char uri[32];
+    snprintf(uri, sizeof(uri), "/sim/data/%d", k);
+    ndn::InterestWCB<4, 0> interest;
+    ndn::parseNameFromUri(interest.getName(), uri);
+    interest.setMustBeFresh(false);
+    interest.setInterestLifetimeMilliseconds(2000);
+    m_sent[nameKey(interest.getName())] = sim.now();
+    ++m_cnt.nInterests;
+    m_node.face.sendInterest(interest);
+  }
+
+private:
+  bool
+  processData(const ndn::DataLite& data, uint64_t endpointId) override
+  {
+    auto it = m_sent.find(nameKey(data.getName()));
+    if (it == m_sent.end()) {
+      return false;
+    }
+    ++m_cnt.nData;
+    m_cnt.latency.add(Simulator::getCurrent()->now() - it->second);
+    m_sent.erase(it);
+    return true;
+  }
+
+private:
+  Node& m_node;
+  const std::vector<double>& m_cdf;
+  const Time m_interval;
+  Counters& m_cnt;
+  Time m_nextSend;
+  std::map<std::string, Time> m_sent;
+};
+
+static void
+runCache(Simulator& sim, int nNodes, Time duration)
+{
+  const int nItems = 100;
+  std::vector<double> cdf(nItems);
+  double sum = 0.0;
+  for (int i = 0; i < nItems; ++i) {
+    sum += 1.0 / std::pow(i + 1, 0.8);
+    cdf[i] = sum;
+  }
+  for (double& p : cdf) {
+    p /= sum;
+  }
+
+  ndnsim::LinkOptions link;
+  link.delay = 5000;
+  link.bandwidth = 31250;
+
+  // node 0 is the producer; node i has parent (i-1)/2; nodes without children are consumers
+  std::vector<Node*> nodes;
+  for (int i = 0; i < nNodes; ++i) {
+    nodes.push_back(&sim.addNode());
+    if (i > 0) {
+      sim.addLink({nodes[(i - 1) / 2], nodes[i]}, link);
+    }
+  }
+  addPingServer(*nodes[0], "/sim/data");
+
+  CachingRelay::Counters relayCnt;
+  CatalogConsumer::Counters consumerCnt;
+  int nRelays = 0, nConsumers = 0;
+  for (int i = 1; i < nNodes; ++i) {
+    Node& node = *nodes[i];
+    uint64_t upstream = (i - 1) / 2 + 1;
+    if (2 * i + 1 < nNodes) {
+      node.emplace<CachingRelay>(node, upstream, 16, relayCnt);
+      ++nRelays;
+    }
+    else {
+      auto& consumer = node.emplace<CatalogConsumer>(node, cdf, 500000, consumerCnt);
+      node.onTick([&consumer] { consumer.loop(); });
+      ++nConsumers;
+    }
+  }
+
+  sim.run(duration);
+  sim.printReport(g_stdout, false);
+  g_stdout.printf("relays=%d relay-interests=%d cache-hits=%d hit-ratio=%.3f aggregated=%d\n",
+                  nRelays, relayCnt.nInterests, relayCnt.nHits,
+                  relayCnt.nInterests == 0 ? 0.0 : static_cast<double>(relayCnt.nHits) / relayCnt.nInterests,
+                  relayCnt.nAggregated);
+  g_stdout.printf("consumers=%d interests=%d data=%d\n", nConsumers, consumerCnt.nInterests, consumerCnt.nData);
+  g_stdout.printf("latency-us mean=%.0f p50=%" PRIu64 " p90=%" PRIu64 " p99=%" PRIu64 "\n",
+                  consumerCnt.latency.mean(), consumerCnt.latency.percentile(0.5),
+                  consumerCnt.latency.percentile(0.9), consumerCnt.latency.percentile(0.99));
+}
+
+int
+main(int argc, char** argv)
+{
+  if (argc < 2) {
+    fprintf(stderr, "%s ping|nack|cache [NODES] [SECONDS] [SEED]\n", argv[0]);
+    return 2;
+  }
+  std::string scenario = argv[1];
+  int nNodes = argc > 2 ? atoi(argv[2]) : 50;
+  Time duration = (argc > 3 ? atoi(argv[3]) : 60) * static_cast<Time>(1000000);
+  uint32_t seed = argc > 4 ? atoi(argv[4]) : 1;
+  if (nNodes < 2) {
+    fprintf(stderr, "need at least 2 nodes\n");
+    return 2;
+  }
+
+  Simulator sim(seed);
+  if (scenario == "ping") {
+    runPing(sim, nNodes, duration, false);
+  }
+  else if (scenario == "nack") {
+    runPing(sim, nNodes, duration, true);
+  }
+  else if (scenario == "cache") {
+    runCache(sim, nNodes, duration);
+  }
+  else {
+    fprintf(stderr, "unknown scenario %s\n", scenario.c_str());
+    return 2;
+  }
+  return 0;
+}
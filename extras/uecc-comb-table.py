@@ -0,0 +1,66 @@
+#!/usr/bin/env python3
+# Generate fixed-base comb tables of secp256r1 generator for uECC.c.
+# Usage: ./uecc-comb-table.py > ../src/security/detail/uECC_comb.h
+#
+# With W teeth, a 256-bit scalar is split into W rows of D=ceil(256/W) bits.
+# Table entry j-1 (j=1..2^W-1) is the affine point sum(bit t of j ? 2^(t*D) : 0) * G.
+# Each coordinate is stored as 8 little-endian 32-bit words.
+
+P = 0xFFFFFFFF00000001000000000000000000000000FFFFFFFFFFFFFFFFFFFFFFFF
+A = P - 3
+G = (0x6B17D1F2E12C4247F8BCE6E563A440F277037D812DEB33A0F4A13945D898C296,
+     0x4FE342E2FE1A7F9B8EE7EB4A7C0F9E162BCE33576B315ECECBB6406837BF51F5)
+TEETH = (4, 6, 8)
+
+
+def add(p, q):
+  if p is None:
+    return q
+  if q is None:
+    return p
+  if p[0] == q[0]:
+    if (p[1] + q[1]) % P == 0:
+      return None
+    lam = (3 * p[0] * p[0] + A) * pow(2 * p[1], P - 2, P) % P
+  else:
+    lam = (q[1] - p[1]) * pow(q[0] - p[0], P - 2, P) % P
+  x = (lam * lam - p[0] - q[0]) % P
+  return (x, (lam * (p[0] - x) - p[1]) % P)
+
+
+def mul(k, p):
+  r = None
+  while k > 0:
+    if k & 1:
+      r = add(r, p)
+    p = add(p, p)
+    k >>= 1
+  return r
+
+
+def words(v):
+  return ['0x%08X' % ((v >> (32 * i)) & 0xFFFFFFFF) for i in range(8)]
+
+
+print('/* Generated by extras/uecc-comb-table.py, do not edit. */')
+print('/* Fixed-base comb tables of secp256r1 generator, see uECC_COMB_TEETH in uECC.h. */')
+print()
+for w in TEETH:
+  d = (256 + w - 1) // w
+  rows = [mul(1 << (t * d), G) for t in range(w)]
+  print('#%s uECC_COMB_TEETH == %d' % ('if' if w == TEETH[0] else 'elif', w))
+  print('static const uint32_t comb_table[%d][16] = {' % ((1 << w) - 1))
+  for j in range(1, 1 << w):
+    pt = None
+    for t in range(w):
+      if j & (1 << t):
+        pt = add(pt, rows[t])
+    ws = words(pt[0]) + words(pt[1])
+    print('    {%s,' % ', '.join(ws[0:4]))
+    print('     %s,' % ', '.join(ws[4:8]))
+    print('     %s,' % ', '.join(ws[8:12]))
+    print('     %s},' % ', '.join(ws[12:16]))
+  print('};')
+print('#else')
+print('    #error "Unsupported value for uECC_COMB_TEETH"')
+print('#endif')
@@ -35,9 +35,8 @@ PingClient::PingClient(Face& face, InterestLite& interest, Interval pingInterval
   , m_interest(interest)
   , m_pingInterval(pingInterval)
   , m_pingTimeout(determineTimeout(pingTimeout, interest))
-  , m_lastProbe(millis())
+  , m_lastProbe(getClock().getMillis())
   , m_isPending(false)
-  , m_nextProbe(0)
   , m_evtCb(nullptr)
 {
   if (m_pingInterval.min <= m_pingTimeout) {
@@ -67,8 +66,8 @@ PingClient::getLastSeq() const
 void
 PingClient::loop()
 {
-  unsigned long now = millis();
-  if (m_isPending && now - m_lastProbe > m_pingTimeout) {
+  unsigned long now = getClock().getMillis();
+  if (m_isPending && now - m_lastProbe > static_cast<unsigned long>(m_pingTimeout)) {
     m_isPending = false;
     uint32_t seq = this->getLastSeq();
     PINGCLIENT_DBG(F("timeout seq=") << _HEX(seq));
@@ -77,7 +76,7 @@ PingClient::loop()
     }
   }
 
-  if (now > m_nextProbe) {
+  if (!m_nextProbe.isSet() || m_nextProbe.hasExpired()) {
     this->probe();
   }
 }
@@ -91,7 +90,7 @@ PingClient::processData(const DataLite& data, uint64_t endpointId)
   m_isPending = false;
 
   uint32_t seq = this->getLastSeq();
-  PINGCLIENT_DBG(F("response seq=") << _HEX(seq) << F(" rtt=") << _DEC(millis() - m_lastProbe));
+  PINGCLIENT_DBG(F("response seq=") << _HEX(seq) << F(" rtt=") << _DEC(getClock().getMillis() - m_lastProbe));
   if (m_evtCb != nullptr) {
     m_evtCb(m_evtCbArg, Event::RESPONSE, seq);
   }
@@ -108,7 +107,7 @@ PingClient::processNack(const NetworkNackLite& nackHeader, const InterestLite& i
   m_isPending = false;
 
   uint32_t seq = this->getLastSeq();
-  PINGCLIENT_DBG(F("nack seq=") << _HEX(seq) << F(" rtt=") << _DEC(millis() - m_lastProbe));
+  PINGCLIENT_DBG(F("nack seq=") << _HEX(seq) << F(" rtt=") << _DEC(getClock().getMillis() - m_lastProbe));
   if (m_evtCb != nullptr) {
     m_evtCb(m_evtCbArg, Event::NACK, seq);
   }
@@ -134,8 +133,8 @@ PingClient::probe()
   m_face.sendInterest(m_interest);
 
   m_isPending = true;
-  m_lastProbe = millis();
-  m_nextProbe = m_lastProbe + m_pingInterval();
+  m_lastProbe = getClock().getMillis();
+  m_nextProbe = Deadline::in(m_pingInterval());
 
   if (m_evtCb != nullptr) {
     m_evtCb(m_evtCbArg, Event::PROBE, seq);
@@ -1,6 +1,7 @@
 #ifndef ESP8266NDN_PING_CLIENT_HPP
 #define ESP8266NDN_PING_CLIENT_HPP
 
+#include "../core/clock.hpp"
 #include "../core/face.hpp"
 
 namespace ndn {
@@ -93,7 +94,7 @@ private:
   const int m_pingTimeout;
   unsigned long m_lastProbe; ///< timestamp of last probe
   bool m_isPending; ///< whether lastProbe is waiting for either response or timeout
-  unsigned long m_nextProbe; ///< timestamp of next probe
+  Deadline m_nextProbe; ///< when to send next probe; unset means immediately
   EventCallback m_evtCb;
   void* m_evtCbArg;
 };
@@ -8,7 +8,6 @@ SimpleConsumer::SimpleConsumer(Face& face, InterestLite& interest, int timeout)
   : interest(interest)
   , m_face(face)
   , m_timeoutDuration(timeout)
-  , m_timeoutAt(0)
   , m_result(Result::NONE)
   , m_pb(nullptr)
   , m_endpointId(0)
@@ -42,13 +41,13 @@ void
 SimpleConsumer::prepareSendInterest()
 {
   m_result = Result::NONE;
-  m_timeoutAt = millis() + m_timeoutDuration;
+  m_timeout = Deadline::in(m_timeoutDuration);
 }
 
 SimpleConsumer::Result
 SimpleConsumer::getResult() const
 {
-  if (m_result == Result::NONE && m_timeoutAt > 0 && millis() >= m_timeoutAt) {
+  if (m_result == Result::NONE && m_timeout.hasExpired()) {
     const_cast<SimpleConsumer*>(this)->m_result = Result::TIMEOUT;
   }
   return m_result;
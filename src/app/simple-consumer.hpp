@@ -1,6 +1,7 @@
 #ifndef ESP8266NDN_SIMPLE_CONSUMER_HPP
 #define ESP8266NDN_SIMPLE_CONSUMER_HPP
 
+#include "../core/clock.hpp"
 #include "../core/face.hpp"
 
 namespace ndn {
@@ -64,7 +65,7 @@ public:
 private:
   Face& m_face;
   int m_timeoutDuration;
-  unsigned long m_timeoutAt;
+  Deadline m_timeout;
   Result m_result;
   PacketBuffer* m_pb;
   uint64_t m_endpointId;
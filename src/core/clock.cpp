@@ -0,0 +1,51 @@
+#include "clock.hpp"
+
+#include <Arduino.h>
+
+namespace ndn {
+
+unsigned long
+SystemClock::getMicros()
+{
+  return ::micros();
+}
+
+unsigned long
+SystemClock::getMillis()
+{
+  return ::millis();
+}
+
+class ClockWrapper
+{
+public:
+  ClockWrapper()
+    : clock(&systemClock)
+  {
+  }
+
+public:
+  SystemClock systemClock;
+  Clock* clock;
+};
+
+static ClockWrapper&
+getClockWrapper()
+{
+  static ClockWrapper w;
+  return w;
+}
+
+Clock&
+getClock()
+{
+  return *getClockWrapper().clock;
+}
+
+void
+setClock(Clock& clock)
+{
+  getClockWrapper().clock = &clock;
+}
+
+} // namespace ndn
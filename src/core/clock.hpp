@@ -0,0 +1,174 @@
+#ifndef ESP8266NDN_CLOCK_HPP
+#define ESP8266NDN_CLOCK_HPP
+
+#include <cstdint>
+
+namespace ndn {
+
+/** \brief a monotonic time source
+ *
+ *  Readings wrap around when they overflow unsigned long. Compare them with \c Deadline or by
+ *  subtracting, never with relational operators.
+ */
+class Clock
+{
+public:
+  virtual
+  ~Clock() = default;
+
+  /** \brief get microseconds since an arbitrary epoch
+   */
+  virtual unsigned long
+  getMicros() = 0;
+
+  /** \brief get milliseconds since an arbitrary epoch
+   */
+  virtual unsigned long
+  getMillis() = 0;
+};
+
+/** \brief a clock that reads Arduino micros() and millis()
+ */
+class SystemClock : public Clock
+{
+public:
+  unsigned long
+  getMicros() override;
+
+  unsigned long
+  getMillis() override;
+};
+
+/** \brief a clock that advances only when told to
+ *
+ *  This allows accelerated-time simulation and deterministic benchmarks.
+ */
+class VirtualClock : public Clock
+{
+public:
+  explicit
+  VirtualClock(uint64_t now = 0)
+    : m_now(now)
+  {
+  }
+
+  unsigned long
+  getMicros() override
+  {
+    return static_cast<unsigned long>(m_now);
+  }
+
+  unsigned long
+  getMillis() override
+  {
+    return static_cast<unsigned long>(m_now / 1000);
+  }
+
+  /** \brief get current time in micros, without wraparound
+   */
+  uint64_t
+  now() const
+  {
+    return m_now;
+  }
+
+  /** \brief set current time in micros; must not go backwards
+   */
+  void
+  set(uint64_t now)
+  {
+    m_now = now;
+  }
+
+  /** \brief advance current time by \p micros
+   */
+  void
+  advance(uint64_t micros)
+  {
+    m_now += micros;
+  }
+
+private:
+  uint64_t m_now;
+};
+
+/** \brief get the clock used by Face, apps, and logging
+ *
+ *  The default is a SystemClock.
+ */
+Clock&
+getClock();
+
+/** \brief set the clock used by Face, apps, and logging
+ *  \param clock the clock; it must remain valid until another clock is set
+ */
+void
+setClock(Clock& clock);
+
+/** \brief a point in time measured in millis of \c getClock(), compared wraparound-safely
+ *
+ *  A Deadline may be at most LONG_MAX millis in the future.
+ */
+class Deadline
+{
+public:
+  /** \brief construct an unset deadline, which never expires
+   */
+  Deadline()
+    : m_at(0)
+    , m_isSet(false)
+  {
+  }
+
+  /** \brief construct a deadline \p ms millis after now
+   */
+  static Deadline
+  in(unsigned long ms)
+  {
+    return Deadline(getClock().getMillis() + ms);
+  }
+
+  bool
+  isSet() const
+  {
+    return m_isSet;
+  }
+
+  void
+  clear()
+  {
+    m_isSet = false;
+  }
+
+  /** \brief determine whether the deadline has been set and reached
+   */
+  bool
+  hasExpired() const
+  {
+    return m_isSet && this->remaining() <= 0;
+  }
+
+  /** \brief get millis until the deadline, negative if it has passed
+   */
+  long
+  remaining() const
+  {
+    return static_cast<long>(m_at - getClock().getMillis());
+  }
+
+private:
+  explicit
+  Deadline(unsigned long at)
+    : m_at(at)
+    , m_isSet(true)
+  {
+  }
+
+private:
+  unsigned long m_at;
+  bool m_isSet;
+};
+
+} // namespace ndn
+
+#endif // ESP8266NDN_CLOCK_HPP
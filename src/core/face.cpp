@@ -26,14 +26,14 @@ public:
   void
   logInterest(const InterestLite& interest, uint64_t endpointId, char dir = '<')
   {
-    m_output << millis() << m_prefix << dir << "I " << PrintUri{interest.getName()}
+    m_output << getClock().getMillis() << m_prefix << dir << "I " << PrintUri{interest.getName()}
              << F(" endpoint=") << _HEX(endpointId) << endl;
   }
 
   void
   logData(const DataLite& data, uint64_t endpointId, char dir = '<')
   {
-    m_output << millis() << m_prefix << dir << "D " << PrintUri{data.getName()}
+    m_output << getClock().getMillis() << m_prefix << dir << "D " << PrintUri{data.getName()}
              << F(" endpoint=") << _HEX(endpointId) << endl;
   }
 
@@ -41,7 +41,7 @@ public:
   logNack(const NetworkNackLite& nackHeader, const InterestLite& interest,
           uint64_t endpointId, char dir = '<')
   {
-    m_output << millis() << m_prefix << dir << "N " << PrintUri{interest.getName()}
+    m_output << getClock().getMillis() << m_prefix << dir << "N " << PrintUri{interest.getName()}
              << '~' << static_cast<int>(nackHeader.getReason())
              << F(" endpoint=") << _HEX(endpointId) << endl;
   }
@@ -76,11 +76,15 @@ private:
 Face::Face(Transport& transport)
   : m_transport(transport)
   , m_pb(nullptr)
+  , m_bundleEndpointId(0)
   , m_handler(nullptr)
   , m_wantNack(true)
+  , m_raisedPacketLimit(0)
   , m_outArr(m_outBuf, NDNFACE_OUTBUF_SIZE, nullptr)
   , m_sigInfoArr(m_sigInfoBuf, NDNFACE_SIGINFOBUF_SIZE, nullptr)
   , m_sigBuf(0)
+  , m_fragBuf(0)
+  , m_lpSeq(static_cast<uint64_t>(random(0x7FFFFFFF)) << 32)
   , m_signingKey(nullptr)
 {
 }
@@ -128,6 +132,18 @@ Face::enableTracing(Print& output, const String& prefix)
   m_tracing.reset(new TracingHandler(*this, output, prefix));
 }
 
+void
+Face::enableReassembly(const LpReassembler::Options& options)
+{
+  m_reass.reset(new LpReassembler(options));
+}
+
+void
+Face::enableTxQueue(const TxQueue::Options& options)
+{
+  m_txQueue.reset(new TxQueue(m_transport, options));
+}
+
 void
 Face::setSigningKey(const PrivateKey& pvtkey)
 {
@@ -139,6 +155,9 @@ Face::swapPacketBuffer(PacketBuffer* pb)
 {
   PacketBuffer* oldPb = m_pb;
   m_pb = pb;
+  if (m_pb != nullptr && oldPb != nullptr) {
+    m_pb->takeBundle(*oldPb);
+  }
   return oldPb;
 }
 
@@ -151,12 +170,21 @@ Face::loop(int packetLimit)
     }
     uint64_t endpointId;
     ndn_Error e = this->receive(endpointId);
+    if (m_raisedPacketLimit > 0) {
+      if (m_raisedPacketLimit - 1 > packetLimit) { // this iteration counts as one
+        packetLimit = m_raisedPacketLimit - 1;
+      }
+      m_raisedPacketLimit = 0;
+    }
     if (e) {
       FACE_DBG(F("receive error ") << _DEC(e));
     }
     else {
       switch (m_pb->getPktType()) {
         case PacketType::NONE:
+          if (m_signingKey != nullptr) {
+            m_signingKey->precompute(); // use idle time
+          }
           return; // no more packets
         case PacketType::INTEREST: {
           bool isAccepted = false;
@@ -208,16 +236,39 @@ Face::loop(int packetLimit)
 ndn_Error
 Face::receive(uint64_t& endpointId)
 {
-  uint8_t* buf;
-  size_t bufSize;
-  std::tie(buf, bufSize) = m_pb->useBuffer();
+  while (true) {
+    uint8_t* buf;
+    size_t bufSize;
+    std::tie(buf, bufSize) = m_pb->useBuffer();
+
+    size_t pktSize = 0;
+    if (m_pb->hasBundle()) {
+      pktSize = m_pb->useBundle();
+      endpointId = m_bundleEndpointId;
+    }
+    else {
+      pktSize = getTransport().receive(buf, bufSize, endpointId);
+      if (pktSize == 0) {
+        return NDN_ERROR_success;
+      }
+      m_bundleEndpointId = endpointId;
+    }
 
-  size_t pktSize = m_transport.receive(buf, bufSize, endpointId);
-  if (pktSize == 0) {
-    return NDN_ERROR_success;
-  }
+    ndn_Error e = m_pb->parse(pktSize);
+    const LpHeader* frag = m_pb->getLpFragment();
+    if (e || frag == nullptr) {
+      return e;
+    }
 
-  return m_pb->parse(pktSize);
+    if (m_reass == nullptr) {
+      FACE_DBG(F("received fragment, reassembly disabled"));
+      continue;
+    }
+    pktSize = m_reass->add(*frag, endpointId, buf, bufSize - m_pb->getBundleSize());
+    if (pktSize > 0) {
+      return m_pb->parse(pktSize);
+    }
+  }
 }
 
 bool
@@ -253,7 +304,92 @@ Face::verifyData(const PublicKey& pubKey) const
 ndn_Error
 Face::sendPacket(const uint8_t* pkt, size_t len, uint64_t endpointId)
 {
-  return m_transport.send(pkt, len, endpointId);
+  size_t mtu = getTransport().getMtu();
+  if (mtu == 0 || len <= mtu) {
+    return getTransport().send(pkt, len, endpointId);
+  }
+  return this->sendFragmented(pkt, len, endpointId, mtu);
+}
+
+ndn_Error
+Face::sendFragmented(const uint8_t* pkt, size_t len, uint64_t endpointId, size_t mtu)
+{
+  // LpPacket TL + Sequence + FragIndex + FragCount + Fragment TL,
+  // assuming TLV-LENGTH is below 65536 and FragCount is below 256
+  const size_t FRAG_OVERHEAD = 4 + 10 + 3 + 3 + 4;
+  const int MAX_FRAG_COUNT = 255;
+
+  const uint8_t* headers = nullptr;
+  size_t headersLen = 0;
+  const uint8_t* payload = pkt;
+  size_t payloadLen = len;
+  if (pkt[0] == ndn_Tlv_LpPacket_LpPacket) {
+    // other header fields go into the first fragment
+    LpHeader lpHeader;
+    ndn_Error error = lpHeader.decode(pkt, len);
+    if (error || lpHeader.isFragmented() || lpHeader.payload == nullptr) {
+      FACE_DBG(F("cannot fragment LpPacket"));
+      return error ? error : NDN_ERROR_header_type_is_out_of_range;
+    }
+    headers = lpHeader.headers;
+    headersLen = lpHeader.headersLen;
+    payload = lpHeader.payload;
+    payloadLen = lpHeader.payloadLen;
+  }
+
+  mtu = std::min<size_t>(mtu, 0xFFFF);
+  if (mtu <= FRAG_OVERHEAD + headersLen) {
+    FACE_DBG(F("MTU too small for fragmentation"));
+    return NDN_ERROR_TLV_length_exceeds_buffer_length;
+  }
+  size_t fragRoom = mtu - FRAG_OVERHEAD;
+  int fragCount = (headersLen + payloadLen + fragRoom - 1) / fragRoom;
+  if (fragCount > MAX_FRAG_COUNT) {
+    FACE_DBG(F("too many fragments"));
+    return NDN_ERROR_TLV_length_exceeds_buffer_length;
+  }
+  ndn_Error error = m_fragBuf.ensureLength(mtu);
+  if (error) {
+    return error;
+  }
+
+  uint64_t seqBase = m_lpSeq;
+  m_lpSeq += fragCount;
+  size_t offset = 0;
+  for (int i = 0; i < fragCount; ++i) {
+    size_t hdrLen = i == 0 ? headersLen : 0;
+    size_t fragLen = std::min(payloadLen - offset, fragRoom - hdrLen);
+    size_t lpPacketLen = 10 + 2 + ndn_TlvEncoder_sizeOfNonNegativeInteger(i) +
+                         2 + ndn_TlvEncoder_sizeOfNonNegativeInteger(fragCount) +
+                         hdrLen + 1 + ndn_TlvEncoder_sizeOfVarNumber(fragLen) + fragLen;
+
+    uint8_t seq[8];
+    for (int j = 0; j < 8; ++j) {
+      seq[j] = static_cast<uint8_t>((seqBase + i) >> (56 - 8 * j));
+    }
+
+    ndn_TlvEncoder encoder;
+    ndn_TlvEncoder_initialize(&encoder, reinterpret_cast<ndn_DynamicUInt8Array*>(&m_fragBuf));
+    ndn_TlvEncoder_writeTypeAndLength(&encoder, ndn_Tlv_LpPacket_LpPacket, lpPacketLen);
+    ndn_TlvEncoder_writeTypeAndLength(&encoder, ndn_Tlv_LpPacket_Sequence, sizeof(seq));
+    ndn_TlvEncoder_writeArray(&encoder, seq, sizeof(seq));
+    ndn_TlvEncoder_writeNonNegativeIntegerTlv(&encoder, ndn_Tlv_LpPacket_FragIndex, i);
+    ndn_TlvEncoder_writeNonNegativeIntegerTlv(&encoder, ndn_Tlv_LpPacket_FragCount, fragCount);
+    ndn_TlvEncoder_writeArray(&encoder, headers, hdrLen);
+    ndn_TlvEncoder_writeTypeAndLength(&encoder, ndn_Tlv_LpPacket_Fragment, fragLen);
+    error = ndn_TlvEncoder_writeArray(&encoder, payload + offset, fragLen);
+    if (error) {
+      FACE_DBG(F("fragment encoding error: ") << _DEC(error));
+      return error;
+    }
+
+    error = getTransport().send(m_fragBuf.getArray(), encoder.offset, endpointId);
+    if (error) {
+      return error;
+    }
+    offset += fragLen;
+  }
+  return NDN_ERROR_success;
 }
 
 ndn_Error
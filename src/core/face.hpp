@@ -1,7 +1,9 @@
 #ifndef ESP8266NDN_FACE_HPP
 #define ESP8266NDN_FACE_HPP
 
+#include "lp-reassembler.hpp"
 #include "packet-handler.hpp"
+#include "../transport/tx-queue.hpp"
 
 #include "../ndn-cpp/lite/util/dynamic-uint8-array-lite.hpp"
 #include "../ndn-cpp/lite/util/dynamic-malloc-uint8-array-lite.hpp"
@@ -13,7 +15,6 @@ namespace ndn {
 
 class PrivateKey;
 class PublicKey;
-class Transport;
 
 /** \brief max NameComponent count when preparing outgoing signed Interest
  */
@@ -22,8 +23,13 @@ class Transport;
  */
 #define NDNFACE_SIGINFOBUF_SIZE 128
 /** \brief outgoing buffer size, in octets
+ *
+ *  This limits the size of outgoing Interest, Data, and Nack. Packets larger than the transport
+ *  MTU are sent as NDNLPv2 fragments.
  */
+#ifndef NDNFACE_OUTBUF_SIZE
 #define NDNFACE_OUTBUF_SIZE 1500
+#endif
 /** \brief where to start encoding Interest when sending Nack
  */
 #define NDNFACE_OUTNACK_HEADROOM 32
@@ -66,6 +72,40 @@ public:
     m_wantNack = wantNack;
   }
 
+  /** \brief enable NDNLPv2 reassembly
+   *
+   *  Without reassembly, incoming NDNLPv2 fragments are dropped.
+   *  The receive buffer must be large enough for reassembled packets, see \c swapPacketBuffer().
+   */
+  void
+  enableReassembly(const LpReassembler::Options& options = {});
+
+  /** \brief access the reassembler
+   *  \return the reassembler, or nullptr if reassembly is disabled
+   */
+  const LpReassembler*
+  getReassembler() const
+  {
+    return m_reass.get();
+  }
+
+  /** \brief enable outgoing packet queue
+   *
+   *  Outgoing packets, including NDNLPv2 fragments, are placed in a TxQueue over the transport,
+   *  so that sending does not wait for the transport. Queued packets are transmitted in \c loop().
+   */
+  void
+  enableTxQueue(const TxQueue::Options& options = {});
+
+  /** \brief access the outgoing packet queue
+   *  \return the queue, or nullptr if queuing is disabled
+   */
+  TxQueue*
+  getTxQueue()
+  {
+    return m_txQueue.get();
+  }
+
   /** \brief set default signing key
    */
   void
@@ -99,10 +139,25 @@ public:
   swapPacketBuffer(PacketBuffer* pb);
 
   /** \brief receive and process up to \p packetLimit packets
+   *
+   *  If no more packets are pending, the default signing key may precompute() once.
    */
   void
   loop(int packetLimit = 4);
 
+  /** \brief let the current or next \c loop() process at least \p packetLimit more packets
+   *
+   *  This is intended to be invoked from a transport's backpressure callback, so that Face can
+   *  temporarily drain a burst that exceeds the usual packetLimit.
+   */
+  void
+  raisePacketLimit(int packetLimit)
+  {
+    if (packetLimit > m_raisedPacketLimit) {
+      m_raisedPacketLimit = packetLimit;
+    }
+  }
+
   /** \brief verify the signature on current Interest against given public key
    *
    *  This function is only available within onInterest callback before calling
@@ -119,7 +174,9 @@ public:
   bool
   verifyData(const PublicKey& pubKey) const;
 
-  /** \brief send a packet directly through underlying transport
+  /** \brief send a packet through underlying transport
+   *
+   *  If the packet exceeds transport MTU, it is sent as NDNLPv2 fragments.
    */
   ndn_Error
   sendPacket(const uint8_t* pkt, size_t len, uint64_t endpointId = 0);
@@ -163,22 +220,41 @@ private:
   ndn_Error
   signImpl(const PrivateKey& pvtkey, const uint8_t* input, size_t inputLen, int& sigLen);
 
+  /** \brief send a packet as NDNLPv2 fragments no larger than \p mtu
+   */
+  ndn_Error
+  sendFragmented(const uint8_t* pkt, size_t len, uint64_t endpointId, size_t mtu);
+
+  /** \brief get the transport for sending and receiving, which may be the TxQueue
+   */
+  Transport&
+  getTransport()
+  {
+    return m_txQueue == nullptr ? m_transport : *m_txQueue;
+  }
+
 private:
   Transport& m_transport;
 
   PacketBuffer* m_pb;
+  uint64_t m_bundleEndpointId; ///< sender of the bundle in m_pb
 
   PacketHandler* m_handler;
   bool m_wantNack;
+  int m_raisedPacketLimit;
 
   class TracingHandler;
   std::unique_ptr<TracingHandler> m_tracing;
+  std::unique_ptr<LpReassembler> m_reass;
+  std::unique_ptr<TxQueue> m_txQueue;
 
   uint8_t m_outBuf[NDNFACE_OUTBUF_SIZE];
   DynamicUInt8ArrayLite m_outArr;
   uint8_t m_sigInfoBuf[NDNFACE_SIGINFOBUF_SIZE];
   DynamicUInt8ArrayLite m_sigInfoArr;
   DynamicMallocUInt8ArrayLite m_sigBuf;
+  DynamicMallocUInt8ArrayLite m_fragBuf;
+  uint64_t m_lpSeq;
 
   const PrivateKey* m_signingKey;
 };
@@ -1,6 +1,7 @@
 #ifndef ESP8266NDN_LOGGER_HPP
 #define ESP8266NDN_LOGGER_HPP
 
+#include "clock.hpp"
 #include "logging.hpp"
 #include "detail/Streaming.h"
 #include "detail/PriUint64.h"
@@ -8,7 +9,7 @@
 
 #define DBG(module, ...) \
   do { \
-    ::ndn::getLogOutput() << _DEC(millis()) << " [" #module "] " << __VA_ARGS__ << "\n"; \
+    ::ndn::getLogOutput() << _DEC(::ndn::getClock().getMillis()) << " [" #module "] " << __VA_ARGS__ << "\n"; \
   } while (false)
 
 #endif // ESP8266NDN_LOGGER_HPP
@@ -0,0 +1,83 @@
+#include "lp-header.hpp"
+
+#include "../ndn-cpp/c/encoding/tlv/tlv.h"
+#include "../ndn-cpp/c/encoding/tlv/tlv-decoder.h"
+
+namespace ndn {
+
+ndn_Error
+LpHeader::decode(const uint8_t* pkt, size_t len)
+{
+  *this = LpHeader();
+
+  ndn_TlvDecoder decoder;
+  ndn_TlvDecoder_initialize(&decoder, pkt, len);
+  size_t endOffset;
+  ndn_Error error = ndn_TlvDecoder_readNestedTlvsStart(&decoder, ndn_Tlv_LpPacket_LpPacket, &endOffset);
+  if (error) {
+    return error;
+  }
+
+  while (decoder.offset < endOffset) {
+    size_t fieldOffset = decoder.offset;
+    uint64_t fieldType, fieldLength;
+    if ((error = ndn_TlvDecoder_readVarNumber(&decoder, &fieldType)) ||
+        (error = ndn_TlvDecoder_readVarNumber(&decoder, &fieldLength))) {
+      return error;
+    }
+    if (decoder.offset + fieldLength > endOffset) {
+      return NDN_ERROR_TLV_length_exceeds_buffer_length;
+    }
+
+    if (fieldType == ndn_Tlv_LpPacket_Fragment) {
+      if (headers == nullptr) {
+        headers = pkt + fieldOffset;
+      }
+      headersLen = pkt + fieldOffset - headers;
+      payload = pkt + decoder.offset;
+      payloadLen = fieldLength;
+      break; // Fragment is the last field
+    }
+
+    if (fieldType < ndn_Tlv_LpPacket_Sequence || fieldType > ndn_Tlv_LpPacket_FragCount) {
+      if (headers == nullptr) {
+        headers = pkt + fieldOffset;
+      }
+      decoder.offset += fieldLength;
+      continue;
+    }
+
+    if (headers != nullptr || fieldLength < 1 || fieldLength > 8) {
+      return NDN_ERROR_did_not_get_the_expected_TLV_type;
+    }
+    uint64_t value = 0;
+    if ((error = ndn_TlvDecoder_readNonNegativeInteger(&decoder, fieldLength, &value))) {
+      return error;
+    }
+    switch (fieldType) {
+      case ndn_Tlv_LpPacket_Sequence:
+        seq = value;
+        hasSeq = true;
+        break;
+      case ndn_Tlv_LpPacket_FragIndex:
+        fragIndex = value > 0xFFFF ? 0xFFFF : value;
+        break;
+      case ndn_Tlv_LpPacket_FragCount:
+        fragCount = value > 0xFFFF ? 0xFFFF : value;
+        break;
+    }
+  }
+
+  if (payload == nullptr) {
+    if (headers == nullptr) {
+      headers = pkt + decoder.offset;
+    }
+    headersLen = pkt + decoder.offset - headers;
+  }
+  if (fragCount == 0 || fragIndex >= fragCount || (fragCount > 1 && !hasSeq)) {
+    return NDN_ERROR_header_type_is_out_of_range;
+  }
+  return NDN_ERROR_success;
+}
+
+} // namespace ndn
@@ -0,0 +1,51 @@
+#ifndef ESP8266NDN_LP_HEADER_HPP
+#define ESP8266NDN_LP_HEADER_HPP
+
+#include "../ndn-cpp/c/errors.h"
+#include <cinttypes>
+#include <cstddef>
+
+namespace ndn {
+
+/** \brief NDNLPv2 fragmentation fields of an LpPacket, and location of other fields
+ *  \sa https://redmine.named-data.net/projects/nfd/wiki/NDNLPv2
+ */
+class LpHeader
+{
+public:
+  /** \brief decode an LpPacket
+   *
+   *  Sequence, FragIndex, and FragCount are extracted. Other header fields are not interpreted,
+   *  but must appear after the fragmentation fields, as required by NDNLPv2 field ordering.
+   */
+  ndn_Error
+  decode(const uint8_t* pkt, size_t len);
+
+  /** \brief determine whether this LpPacket carries one of several fragments
+   */
+  bool
+  isFragmented() const
+  {
+    return fragCount > 1;
+  }
+
+public:
+  uint64_t seq = 0;
+  bool hasSeq = false;
+  uint16_t fragIndex = 0;
+  uint16_t fragCount = 1;
+
+  /** \brief header fields after fragmentation fields, excluding Fragment
+   */
+  const uint8_t* headers = nullptr;
+  size_t headersLen = 0;
+
+  /** \brief TLV-VALUE of Fragment; nullptr if Fragment is absent
+   */
+  const uint8_t* payload = nullptr;
+  size_t payloadLen = 0;
+};
+
+} // namespace ndn
+
+#endif // ESP8266NDN_LP_HEADER_HPP
@@ -0,0 +1,202 @@
+#include "lp-reassembler.hpp"
+#include "logger.hpp"
+
+#include "../ndn-cpp/c/encoding/tlv/tlv.h"
+#include "../ndn-cpp/c/encoding/tlv/tlv-encoder.h"
+#include "../ndn-cpp/lite/util/dynamic-uint8-array-lite.hpp"
+
+#define LPREASS_DBG(...) DBG(LpReassembler, __VA_ARGS__)
+
+namespace ndn {
+
+struct LpReassembler::Context
+{
+  struct Slot
+  {
+    uint16_t offset;
+    uint16_t len;
+  };
+
+  bool
+  isActive() const
+  {
+    return bitmap != 0;
+  }
+
+  bool
+  isComplete() const
+  {
+    return bitmap == (fragCount == 32 ? 0xFFFFFFFF : (1UL << fragCount) - 1);
+  }
+
+  void
+  reset()
+  {
+    bitmap = 0;
+    used = 0;
+    hdr = {0, 0};
+  }
+
+  uint8_t* buf = nullptr; ///< fragment storage, m_maxSize octets, filled in arrival order
+  uint64_t endpointId = 0;
+  uint64_t seqBase = 0;   ///< Sequence of first fragment
+  unsigned long deadline = 0;
+  uint32_t bitmap = 0;    ///< received fragments; zero means context is unused
+  uint16_t fragCount = 0;
+  uint16_t used = 0;      ///< used octets in buf
+  Slot hdr = {0, 0};      ///< other header fields from first fragment
+  Slot frags[LPREASSEMBLER_MAX_FRAGS];
+};
+
+static_assert(LPREASSEMBLER_MAX_FRAGS <= 32, "bitmap is uint32_t");
+
+LpReassembler::LpReassembler(const Options& options)
+  : m_ctx(nullptr)
+  , m_buf(nullptr)
+  , m_maxSize(options.maxSize)
+  , m_nContexts(options.nContexts < 1 ? 1 : options.nContexts)
+  , m_timeout(options.timeout)
+{
+  m_ctx = new Context[m_nContexts];
+  m_buf = new uint8_t[m_maxSize * m_nContexts];
+  for (int i = 0; i < m_nContexts; ++i) {
+    m_ctx[i].buf = m_buf + i * m_maxSize;
+  }
+}
+
+LpReassembler::~LpReassembler()
+{
+  delete[] m_ctx;
+  delete[] m_buf;
+}
+
+size_t
+LpReassembler::add(const LpHeader& frag, uint64_t endpointId, uint8_t* buf, size_t bufSize)
+{
+  unsigned long now = getClock().getMillis();
+  this->expireContexts(now);
+
+  if (!frag.isFragmented() || frag.fragCount > LPREASSEMBLER_MAX_FRAGS || frag.payload == nullptr) {
+    LPREASS_DBG(F("drop-bad seq=") << frag.seq << F(" count=") << frag.fragCount);
+    ++m_cnt.nBadFrags;
+    return 0;
+  }
+
+  Context& ctx = *this->findContext(endpointId, frag.seq - frag.fragIndex, frag.fragCount, now);
+  uint32_t bit = 1UL << frag.fragIndex;
+  if ((ctx.bitmap & bit) != 0) {
+    ++m_cnt.nDupFrags;
+    return 0;
+  }
+
+  size_t hdrLen = frag.fragIndex == 0 ? frag.headersLen : 0;
+  if (ctx.fragCount != frag.fragCount || ctx.used + hdrLen + frag.payloadLen > m_maxSize) {
+    LPREASS_DBG(F("drop-bad seq=") << frag.seq << F(" count=") << frag.fragCount);
+    ++m_cnt.nBadFrags;
+    ctx.reset();
+    return 0;
+  }
+
+  if (hdrLen > 0) {
+    memcpy(ctx.buf + ctx.used, frag.headers, hdrLen);
+    ctx.hdr = {ctx.used, static_cast<uint16_t>(hdrLen)};
+    ctx.used += hdrLen;
+  }
+  memcpy(ctx.buf + ctx.used, frag.payload, frag.payloadLen);
+  ctx.frags[frag.fragIndex] = {ctx.used, static_cast<uint16_t>(frag.payloadLen)};
+  ctx.used += frag.payloadLen;
+  ctx.bitmap |= bit;
+
+  if (!ctx.isComplete()) {
+    return 0;
+  }
+
+  size_t size = this->output(ctx, buf, bufSize);
+  ctx.reset();
+  if (size == 0) {
+    LPREASS_DBG(F("reassemble err=no-room"));
+    return 0;
+  }
+  ++m_cnt.nReassembled;
+  return size;
+}
+
+LpReassembler::Context*
+LpReassembler::findContext(uint64_t endpointId, uint64_t seqBase, uint16_t fragCount, unsigned long now)
+{
+  Context* freeCtx = nullptr;
+  Context* oldestCtx = nullptr;
+  for (int i = 0; i < m_nContexts; ++i) {
+    Context& ctx = m_ctx[i];
+    if (!ctx.isActive()) {
+      freeCtx = &ctx;
+      continue;
+    }
+    if (ctx.endpointId == endpointId && ctx.seqBase == seqBase) {
+      return &ctx;
+    }
+    if (oldestCtx == nullptr || static_cast<long>(ctx.deadline - oldestCtx->deadline) < 0) {
+      oldestCtx = &ctx;
+    }
+  }
+
+  Context* ctx = freeCtx;
+  if (ctx == nullptr) {
+    LPREASS_DBG(F("evict seq=") << oldestCtx->seqBase);
+    ++m_cnt.nEvictions;
+    ctx = oldestCtx;
+  }
+  ctx->reset();
+  ctx->endpointId = endpointId;
+  ctx->seqBase = seqBase;
+  ctx->fragCount = fragCount;
+  ctx->deadline = now + m_timeout;
+  return ctx;
+}
+
+void
+LpReassembler::expireContexts(unsigned long now)
+{
+  for (int i = 0; i < m_nContexts; ++i) {
+    Context& ctx = m_ctx[i];
+    if (ctx.isActive() && static_cast<long>(now - ctx.deadline) >= 0) {
+      LPREASS_DBG(F("timeout seq=") << ctx.seqBase);
+      ++m_cnt.nTimeouts;
+      ctx.reset();
+    }
+  }
+}
+
+size_t
+LpReassembler::output(const Context& ctx, uint8_t* buf, size_t bufSize) const
+{
+  size_t payloadLen = ctx.used - ctx.hdr.len;
+  size_t size = payloadLen;
+  if (ctx.hdr.len > 0) {
+    size_t fragmentSize = 1 + ndn_TlvEncoder_sizeOfVarNumber(payloadLen) + payloadLen;
+    size_t lpPacketLen = ctx.hdr.len + fragmentSize;
+    size = 1 + ndn_TlvEncoder_sizeOfVarNumber(lpPacketLen) + lpPacketLen;
+    if (size > bufSize) {
+      return 0;
+    }
+
+    DynamicUInt8ArrayLite outArr(buf, bufSize, nullptr);
+    ndn_TlvEncoder encoder;
+    ndn_TlvEncoder_initialize(&encoder, reinterpret_cast<ndn_DynamicUInt8Array*>(&outArr));
+    ndn_TlvEncoder_writeTypeAndLength(&encoder, ndn_Tlv_LpPacket_LpPacket, lpPacketLen);
+    ndn_TlvEncoder_writeArray(&encoder, ctx.buf + ctx.hdr.offset, ctx.hdr.len);
+    ndn_TlvEncoder_writeTypeAndLength(&encoder, ndn_Tlv_LpPacket_Fragment, payloadLen);
+    buf += encoder.offset;
+  }
+  else if (size > bufSize) {
+    return 0;
+  }
+
+  for (int i = 0; i < ctx.fragCount; ++i) {
+    memcpy(buf, ctx.buf + ctx.frags[i].offset, ctx.frags[i].len);
+    buf += ctx.frags[i].len;
+  }
+  return size;
+}
+
+} // namespace ndn
@@ -0,0 +1,88 @@
+#ifndef ESP8266NDN_LP_REASSEMBLER_HPP
+#define ESP8266NDN_LP_REASSEMBLER_HPP
+
+#include "lp-header.hpp"
+
+namespace ndn {
+
+/** \brief max FragCount accepted by LpReassembler
+ */
+#define LPREASSEMBLER_MAX_FRAGS 32
+
+/** \brief NDNLPv2 reassembler
+ *
+ *  Fragments of up to \c Options::nContexts packets, keyed by (endpointId, Sequence - FragIndex),
+ *  may arrive interleaved and in any order. Fragments are stored in arrival order, and are copied
+ *  into the output buffer in FragIndex order when the last missing fragment arrives.
+ */
+class LpReassembler
+{
+public:
+  class Options
+  {
+  public:
+    uint16_t maxSize = 8800;  ///< max size of a reassembled packet
+    uint8_t nContexts = 1;    ///< number of packets that can be reassembled concurrently
+    uint16_t timeout = 500;   ///< partial packet lifetime, in millis
+  };
+
+  class Counters
+  {
+  public:
+    uint32_t nReassembled = 0; ///< packets reassembled and delivered
+    uint32_t nDupFrags = 0;    ///< duplicate fragments discarded
+    uint32_t nBadFrags = 0;    ///< fragments inconsistent with their context, or too large
+    uint32_t nTimeouts = 0;    ///< partial packets discarded due to timeout
+    uint32_t nEvictions = 0;   ///< partial packets discarded to make room for another packet
+  };
+
+  explicit
+  LpReassembler(const Options& options);
+
+  ~LpReassembler();
+
+  /** \brief add a fragment
+   *  \param frag fragment, where \c frag.isFragmented() is true
+   *  \param buf output buffer; may overlap with \c frag.payload
+   *  \param bufSize output buffer size
+   *  \return size of reassembled packet written to \p buf, or zero if incomplete
+   *
+   *  The reassembled packet is a bare network layer packet, or an LpPacket if the first fragment
+   *  carries other header fields.
+   */
+  size_t
+  add(const LpHeader& frag, uint64_t endpointId, uint8_t* buf, size_t bufSize);
+
+  const Counters&
+  getCounters() const
+  {
+    return m_cnt;
+  }
+
+private:
+  struct Context;
+
+  Context*
+  findContext(uint64_t endpointId, uint64_t seqBase, uint16_t fragCount, unsigned long now);
+
+  void
+  expireContexts(unsigned long now);
+
+  /** \brief write reassembled packet into \p buf
+   *  \return packet size, or zero if it does not fit
+   */
+  size_t
+  output(const Context& ctx, uint8_t* buf, size_t bufSize) const;
+
+private:
+  Context* m_ctx;
+  uint8_t* m_buf;
+  const uint16_t m_maxSize;
+  const uint8_t m_nContexts;
+  const uint16_t m_timeout;
+  Counters m_cnt;
+};
+
+} // namespace ndn
+
+#endif // ESP8266NDN_LP_REASSEMBLER_HPP
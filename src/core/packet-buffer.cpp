@@ -1,12 +1,15 @@
 #include "packet-buffer.hpp"
 #include "../security/public-key.hpp"
+#include "../transport/bundler.hpp"
 
 #include "../ndn-cpp/c/data.h"
 #include "../ndn-cpp/c/interest.h"
 #include "../ndn-cpp/c/network-nack.h"
 #include "../ndn-cpp/c/encoding/tlv/tlv.h"
 #include "../ndn-cpp/c/encoding/tlv/tlv-decoder.h"
+#include "../ndn-cpp/c/encoding/tlv/tlv-encoder.h"
 #include "../ndn-cpp/lite/encoding/tlv-0_2-wire-format-lite.hpp"
+#include "../ndn-cpp/lite/util/dynamic-uint8-array-lite.hpp"
 
 namespace ndn {
 
@@ -21,6 +24,7 @@ PacketBuffer::PacketBuffer(const Options& options)
   , m_netPktLen(0)
   , m_signedBegin(0)
   , m_signedEnd(0)
+  , m_bundleLen(0)
 {
   size_t allocSize = sizeof(ndn_NameComponent) * (m_maxNameComps + m_maxKeyNameComps) + m_maxSize;
   m_nameComps = reinterpret_cast<ndn_NameComponent*>(new uint8_t[allocSize]);
@@ -40,14 +44,66 @@ PacketBuffer::useBuffer()
   m_netPktLen = 0;
   m_signedBegin = 0;
   m_signedEnd = 0;
+  m_lpHeader = LpHeader();
   return std::tie(m_buf, m_maxSize);
 }
 
 ndn_Error
 PacketBuffer::parse(size_t len)
 {
+  size_t pktLen = Bundler::getPacketLength(m_buf, len);
+  if (pktLen > 0 && pktLen < len) {
+    size_t restLen = len - pktLen;
+    if (Bundler::getPacketLength(&m_buf[pktLen], restLen) > 0) {
+      m_bundleLen = restLen;
+      memmove(&m_buf[m_maxSize - m_bundleLen], &m_buf[pktLen], m_bundleLen);
+    }
+    // otherwise, trailing octets are link layer padding
+    len = pktLen;
+  }
+
   m_netPkt = m_buf;
   m_netPktLen = len;
+  m_lpHeader = LpHeader();
+  return this->parsePacket();
+}
+
+size_t
+PacketBuffer::useBundle()
+{
+  size_t len = m_bundleLen;
+  this->useBuffer();
+  m_bundleLen = 0;
+  memmove(m_buf, &m_buf[m_maxSize - len], len);
+  return len;
+}
+
+void
+PacketBuffer::takeBundle(PacketBuffer& other)
+{
+  size_t len = other.m_bundleLen;
+  other.m_bundleLen = 0;
+  if (len > m_maxSize) {
+    len = 0;
+  }
+  memcpy(&m_buf[m_maxSize - len], &other.m_buf[other.m_maxSize - len], len);
+  m_bundleLen = len;
+}
+
+ndn_Error
+PacketBuffer::parse(const uint8_t* pkt, size_t len)
+{
+  if (len > 0 && pkt[0] == ndn_Tlv_LpPacket_LpPacket) {
+    if (len > m_maxSize) {
+      return NDN_ERROR_TLV_length_exceeds_buffer_length;
+    }
+    memcpy(m_buf, pkt, len);
+    return this->parse(len);
+  }
+
+  m_netPkt = pkt;
+  m_netPktLen = len;
+  m_lpHeader = LpHeader();
   return this->parsePacket();
 }
 
@@ -106,17 +162,43 @@ PacketBuffer::parseData()
 ndn_Error
 PacketBuffer::parseLpPacket()
 {
+  ndn_Error error = m_lpHeader.decode(m_netPkt, m_netPktLen);
+  if (error) {
+    return error;
+  }
+  if (m_lpHeader.isFragmented()) {
+    // to be reassembled by Face
+    return NDN_ERROR_success;
+  }
+
+  // Tlv0_2WireFormatLite::decodeLpPacket does not recognize fragmentation fields. They precede
+  // other header fields, so that they can be stripped by writing a new LpPacket TLV-TYPE and
+  // TLV-LENGTH in front of other header fields.
+  const uint8_t* valueEnd = m_lpHeader.payload == nullptr ?
+                            m_lpHeader.headers + m_lpHeader.headersLen :
+                            m_lpHeader.payload + m_lpHeader.payloadLen;
+  size_t lpPacketLen = valueEnd - m_lpHeader.headers;
+  size_t lpPacketSize = 1 + ndn_TlvEncoder_sizeOfVarNumber(lpPacketLen) + lpPacketLen;
+  size_t lpPacketOffset = valueEnd - m_buf - lpPacketSize;
+  m_lpHeader = LpHeader();
+
+  DynamicUInt8ArrayLite outArr(m_buf, m_maxSize, nullptr);
+  ndn_TlvEncoder encoder;
+  ndn_TlvEncoder_initialize(&encoder, reinterpret_cast<ndn_DynamicUInt8Array*>(&outArr));
+  ndn_TlvEncoder_seek(&encoder, lpPacketOffset);
+  ndn_TlvEncoder_writeTypeAndLength(&encoder, ndn_Tlv_LpPacket_LpPacket, lpPacketLen);
+  m_netPkt = m_buf + lpPacketOffset;
+  m_netPktLen = lpPacketSize;
+
   // Tlv0_2WireFormatLite::decodeLpPacket only recognizes Nack and IncomingFaceId;
   // the latter never appears on a non-local connection.
   ndn_LpPacketHeaderField lpHeaders[1];
   LpPacketLite lpPkt(lpHeaders, 1);
-  ndn_Error error = Tlv0_2WireFormatLite::decodeLpPacket(lpPkt, m_netPkt, m_netPktLen);
+  error = Tlv0_2WireFormatLite::decodeLpPacket(lpPkt, m_netPkt, m_netPktLen);
   if (error) {
     return error;
   }
 
-  // Tlv0_2WireFormatLite::decodeLpPacket does not recognize fragmentation headers and would drop them,
-  // so the 'fragment' should be whole packets.
   const BlobLite& fragment = lpPkt.getFragmentWireEncoding();
   m_netPkt = fragment.buf();
   m_netPktLen = fragment.size();
@@ -220,7 +302,7 @@ PacketBuffer::verifySig(const PublicKey& pubKey, const BlobLite& sig) const
     return VERIFY_PARSE_ERR;
   }
 
-  bool res = pubKey.verify(m_buf + m_signedBegin, m_signedEnd - m_signedBegin,
+  bool res = pubKey.verify(m_netPkt + m_signedBegin, m_signedEnd - m_signedBegin,
                            sig.buf(), sig.size());
   return res ? VERIFY_OK : VERIFY_BAD_SIG;
 }
@@ -4,6 +4,7 @@
 #include "../ndn-cpp/lite/data-lite.hpp"
 #include "../ndn-cpp/lite/interest-lite.hpp"
 #include "../ndn-cpp/lite/network-nack-lite.hpp"
+#include "lp-header.hpp"
 
 #include <tuple>
 
@@ -40,16 +41,60 @@ public:
 
   /** \brief clear parse result and return buffer for receiving next packet
    *  \return buffer and buffer size
+   *  \pre !hasBundle(), otherwise receiving into the buffer may overwrite the bundle
    */
   std::tuple<uint8_t*, size_t>
   useBuffer();
 
   /** \brief parse received packet
    *  \param len packet length
+   *
+   *  If the buffer contains a bundle of several TLV elements, only the first element is parsed.
+   *  The rest of the bundle is moved to the end of the buffer, and retrievable via useBundle().
+   *  Trailing octets that do not start with another packet, such as Ethernet padding, are dropped.
    */
   ndn_Error
   parse(size_t len);
 
+  /** \brief determine whether packets from a received bundle await parsing
+   */
+  bool
+  hasBundle() const
+  {
+    return m_bundleLen > 0;
+  }
+
+  /** \brief get size of the rest of a received bundle, kept at the end of the buffer
+   */
+  size_t
+  getBundleSize() const
+  {
+    return m_bundleLen;
+  }
+
+  /** \brief clear parse result and move the rest of a received bundle to the front of buffer
+   *  \return bundle length to be passed to parse(), or zero if there is no bundle
+   */
+  size_t
+  useBundle();
+
+  /** \brief take the rest of a received bundle from another buffer
+   *
+   *  The bundle is dropped if it does not fit in this buffer.
+   */
+  void
+  takeBundle(PacketBuffer& other);
+
+  /** \brief parse a packet in external memory, such as a ShmTransport slot
+   *  \param pkt packet, which must stay valid while the parse result is in use
+   *  \param len packet length
+   *
+   *  Interest and Data are parsed in place. NDNLPv2 packets are copied into the internal buffer,
+   *  because parsing them rewrites the packet.
+   */
+  ndn_Error
+  parse(const uint8_t* pkt, size_t len);
+
   /** \brief determine packet type
    */
   PacketType
@@ -73,6 +118,17 @@ public:
   const NetworkNackLite*
   getNack() const;
 
+  /** \brief get NDNLPv2 fragment that needs reassembly
+   *  \return the fragment, or nullptr if the packet is not a fragment
+   *
+   *  When this returns non-null, \c getPktType() returns \c PacketType::NONE.
+   */
+  const LpHeader*
+  getLpFragment() const
+  {
+    return m_lpHeader.isFragmented() ? &m_lpHeader : nullptr;
+  }
+
   enum VerifyResult {
     VERIFY_OK,        ///< verify success
     VERIFY_NO_PKT,    ///< packet type is not verifiable
@@ -118,6 +174,8 @@ private:
   uint16_t m_netPktLen;
   uint16_t m_signedBegin;
   uint16_t m_signedEnd;
+  uint16_t m_bundleLen; ///< rest of bundle at the end of m_buf
+  LpHeader m_lpHeader;
   union {
     struct {
       ndn_NetworkNack m_nack;
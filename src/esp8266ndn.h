@@ -11,8 +11,11 @@
 #include "app/simple-consumer.hpp"
 #include "app/simple-producer.hpp"
 
+#include "core/clock.hpp"
 #include "core/face.hpp"
 #include "core/logging.hpp"
+#include "core/lp-header.hpp"
+#include "core/lp-reassembler.hpp"
 #include "core/packet-buffer.hpp"
 #include "core/packet-handler.hpp"
 #include "core/uri.hpp"
@@ -21,17 +24,30 @@
 #include "security/digest-key.hpp"
 #include "security/ec-private-key.hpp"
 #include "security/ec-public-key.hpp"
+#include "security/ed25519-private-key.hpp"
+#include "security/ed25519-public-key.hpp"
 #include "security/hmac-key.hpp"
 #include "security/private-key.hpp"
 #include "security/public-key.hpp"
 
 #include "transport/ble-client-transport.hpp"
+#include "transport/ble-link.hpp"
 #include "transport/ble-server-transport.hpp"
+#include "transport/bundler.hpp"
+#include "transport/endpoint-table.hpp"
 #include "transport/ethernet-transport.hpp"
+#include "transport/header-compressor.hpp"
 #include "transport/lite-frag.hpp"
 #include "transport/loopback-transport.hpp"
+#include "transport/lp-reliability.hpp"
+#include "transport/lora-scheduler.hpp"
 #include "transport/lora-transport.hpp"
+#include "transport/posix-ethernet-transport.hpp"
+#include "transport/posix-udp-transport.hpp"
+#include "transport/shm-transport.hpp"
+#include "transport/stream-transport.hpp"
 #include "transport/transport.hpp"
+#include "transport/tx-queue.hpp"
 #include "transport/udp-transport.hpp"
 
 #endif // ESP8266NDN_H
@@ -65,7 +65,8 @@ enum {
   ndn_Tlv_SignatureType_DigestSha256 = 0,
   ndn_Tlv_SignatureType_SignatureSha256WithRsa = 1,
   ndn_Tlv_SignatureType_SignatureSha256WithEcdsa = 3,
-  ndn_Tlv_SignatureType_SignatureHmacWithSha256 = 4
+  ndn_Tlv_SignatureType_SignatureHmacWithSha256 = 4,
+  ndn_Tlv_SignatureType_SignatureEd25519 = 5
 };
 
 enum {
@@ -1,4 +1,5 @@
 #include <Arduino.h>
+#include "../../../core/clock.hpp"
 extern "C" {
 #define NDN_CPP_HAVE_TIME_H 1
 #define NDN_CPP_HAVE_GMTIME_SUPPORT 1
@@ -40,7 +41,7 @@ extern "C" {
 ndn_MillisecondsSince1970
 ndn_getNowMilliseconds()
 {
-  return millis();
+  return ::ndn::getClock().getMillis();
 }
 
 // Note: configure.ac requires gettimeofday, but check anyway.
@@ -48,7 +49,7 @@ ndn_getNowMilliseconds()
 ndn_MillisecondsSince1970
 ndn_getNowMilliseconds()
 {
-  return millis();
+  return ::ndn::getClock().getMillis();
 }
 #endif
 
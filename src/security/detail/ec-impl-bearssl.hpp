@@ -28,6 +28,21 @@ public:
     return br_ecdsa_i31_sign_asn1(&br_ec_p256_m31, &br_sha256_vtable, hash, &m_key, sig);
   }
 
+  static constexpr bool CAN_PRECOMPUTE_NONCE = false;
+
+  static bool
+  precomputeNonce(uint8_t* nonce)
+  {
+    return false;
+  }
+
+  int
+  signWithNonce(const uint8_t hash[ndn_SHA256_DIGEST_SIZE], const uint8_t* nonce,
+                uint8_t* sig) const
+  {
+    return 0;
+  }
+
 private:
   uint8_t m_bits[32];
   br_ec_private_key m_key;
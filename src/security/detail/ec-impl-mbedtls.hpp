@@ -46,6 +46,21 @@ public:
       &m_key, MBEDTLS_MD_SHA256, hash, ndn_SHA256_DIGEST_SIZE, sig, &sigLen, &mbedRng, nullptr);
     return res == 0 ? static_cast<int>(sigLen) : 0;
   }
+
+  static constexpr bool CAN_PRECOMPUTE_NONCE = false;
+
+  static bool
+  precomputeNonce(uint8_t* nonce)
+  {
+    return false;
+  }
+
+  int
+  signWithNonce(const uint8_t hash[ndn_SHA256_DIGEST_SIZE], const uint8_t* nonce,
+                uint8_t* sig) const
+  {
+    return 0;
+  }
 };
 
 class EcPublicKeyImpl : public EcKeyImplBase
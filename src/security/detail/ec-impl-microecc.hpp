@@ -135,6 +135,27 @@ public:
     return res == 0 ? 0 : encodeSignatureBits(sig);
   }
 
+  static constexpr bool CAN_PRECOMPUTE_NONCE = true;
+
+  /** \brief Compute r and 1/k from a random nonce into nonce[0:64].
+   */
+  static bool
+  precomputeNonce(uint8_t* nonce)
+  {
+    setMicroEccRng();
+    return uECC_precompute_nonce(nonce, nonce + 32) != 0;
+  }
+
+  /** \brief Sign with a nonce from precomputeNonce().
+   */
+  int
+  signWithNonce(const uint8_t hash[ndn_SHA256_DIGEST_SIZE], const uint8_t* nonce,
+                uint8_t* sig) const
+  {
+    int res = uECC_sign_with_nonce(m_bits, hash, nonce, nonce + 32, sig + 8);
+    return res == 0 ? 0 : encodeSignatureBits(sig);
+  }
+
 private:
   uint8_t m_bits[32];
 };
@@ -0,0 +1,846 @@
+/* Compact Ed25519, see ed25519.h. The structure follows the ref10 and TweetNaCl public domain
+implementations. */
+
+#include "ed25519.h"
+
+#include <string.h>
+
+/* ---- SHA-512 ---- */
+
+typedef struct {
+    uint64_t state[8];
+    uint64_t length;
+    uint8_t block[128];
+    size_t fill;
+} sha512_ctx;
+
+static const uint64_t sha512_k[80] = {
+    0x428A2F98D728AE22ULL, 0x7137449123EF65CDULL, 0xB5C0FBCFEC4D3B2FULL,
+    0xE9B5DBA58189DBBCULL, 0x3956C25BF348B538ULL, 0x59F111F1B605D019ULL,
+    0x923F82A4AF194F9BULL, 0xAB1C5ED5DA6D8118ULL, 0xD807AA98A3030242ULL,
+    0x12835B0145706FBEULL, 0x243185BE4EE4B28CULL, 0x550C7DC3D5FFB4E2ULL,
+    0x72BE5D74F27B896FULL, 0x80DEB1FE3B1696B1ULL, 0x9BDC06A725C71235ULL,
+    0xC19BF174CF692694ULL, 0xE49B69C19EF14AD2ULL, 0xEFBE4786384F25E3ULL,
+    0x0FC19DC68B8CD5B5ULL, 0x240CA1CC77AC9C65ULL, 0x2DE92C6F592B0275ULL,
+    0x4A7484AA6EA6E483ULL, 0x5CB0A9DCBD41FBD4ULL, 0x76F988DA831153B5ULL,
+    0x983E5152EE66DFABULL, 0xA831C66D2DB43210ULL, 0xB00327C898FB213FULL,
+    0xBF597FC7BEEF0EE4ULL, 0xC6E00BF33DA88FC2ULL, 0xD5A79147930AA725ULL,
+    0x06CA6351E003826FULL, 0x142929670A0E6E70ULL, 0x27B70A8546D22FFCULL,
+    0x2E1B21385C26C926ULL, 0x4D2C6DFC5AC42AEDULL, 0x53380D139D95B3DFULL,
+    0x650A73548BAF63DEULL, 0x766A0ABB3C77B2A8ULL, 0x81C2C92E47EDAEE6ULL,
+    0x92722C851482353BULL, 0xA2BFE8A14CF10364ULL, 0xA81A664BBC423001ULL,
+    0xC24B8B70D0F89791ULL, 0xC76C51A30654BE30ULL, 0xD192E819D6EF5218ULL,
+    0xD69906245565A910ULL, 0xF40E35855771202AULL, 0x106AA07032BBD1B8ULL,
+    0x19A4C116B8D2D0C8ULL, 0x1E376C085141AB53ULL, 0x2748774CDF8EEB99ULL,
+    0x34B0BCB5E19B48A8ULL, 0x391C0CB3C5C95A63ULL, 0x4ED8AA4AE3418ACBULL,
+    0x5B9CCA4F7763E373ULL, 0x682E6FF3D6B2B8A3ULL, 0x748F82EE5DEFB2FCULL,
+    0x78A5636F43172F60ULL, 0x84C87814A1F0AB72ULL, 0x8CC702081A6439ECULL,
+    0x90BEFFFA23631E28ULL, 0xA4506CEBDE82BDE9ULL, 0xBEF9A3F7B2C67915ULL,
+    0xC67178F2E372532BULL, 0xCA273ECEEA26619CULL, 0xD186B8C721C0C207ULL,
+    0xEADA7DD6CDE0EB1EULL, 0xF57D4F7FEE6ED178ULL, 0x06F067AA72176FBAULL,
+    0x0A637DC5A2C898A6ULL, 0x113F9804BEF90DAEULL, 0x1B710B35131C471BULL,
+    0x28DB77F523047D84ULL, 0x32CAAB7B40C72493ULL, 0x3C9EBE0A15C9BEBCULL,
+    0x431D67C49C100D4CULL, 0x4CC5D4BECB3E42B6ULL, 0x597F299CFC657E2AULL,
+    0x5FCB6FAB3AD6FAECULL, 0x6C44198C4A475817ULL
+};
+
+static const uint64_t sha512_iv[8] = {
+    0x6A09E667F3BCC908ULL, 0xBB67AE8584CAA73BULL,
+    0x3C6EF372FE94F82BULL, 0xA54FF53A5F1D36F1ULL,
+    0x510E527FADE682D1ULL, 0x9B05688C2B3E6C1FULL,
+    0x1F83D9ABFB41BD6BULL, 0x5BE0CD19137E2179ULL
+};
+
+#define ROTR64(x, n) (((x) >> (n)) | ((x) << (64 - (n))))
+
+static uint64_t load64_be(const uint8_t *p) {
+    uint64_t v = 0;
+    int i;
+    for (i = 0; i < 8; ++i) {
+        v = (v << 8) | p[i];
+    }
+    return v;
+}
+
+static void store64_be(uint8_t *p, uint64_t v) {
+    int i;
+    for (i = 7; i >= 0; --i) {
+        p[i] = (uint8_t)v;
+        v >>= 8;
+    }
+}
+
+static void sha512_compress(uint64_t state[8], const uint8_t block[128]) {
+    uint64_t w[16];
+    uint64_t s[8];
+    uint64_t t1, t2;
+    int i;
+
+    memcpy(s, state, sizeof(s));
+    for (i = 0; i < 80; ++i) {
+        if (i < 16) {
+            w[i] = load64_be(block + 8 * i);
+        } else {
+            uint64_t w2 = w[(i - 2) & 15];
+            uint64_t w15 = w[(i - 15) & 15];
+            w[i & 15] += (ROTR64(w2, 19) ^ ROTR64(w2, 61) ^ (w2 >> 6)) + w[(i - 7) & 15] +
+                         (ROTR64(w15, 1) ^ ROTR64(w15, 8) ^ (w15 >> 7));
+        }
+        t1 = s[7] + (ROTR64(s[4], 14) ^ ROTR64(s[4], 18) ^ ROTR64(s[4], 41)) +
+             ((s[4] & s[5]) ^ (~s[4] & s[6])) + sha512_k[i] + w[i & 15];
+        t2 = (ROTR64(s[0], 28) ^ ROTR64(s[0], 34) ^ ROTR64(s[0], 39)) +
+             ((s[0] & s[1]) ^ (s[0] & s[2]) ^ (s[1] & s[2]));
+        s[7] = s[6];
+        s[6] = s[5];
+        s[5] = s[4];
+        s[4] = s[3] + t1;
+        s[3] = s[2];
+        s[2] = s[1];
+        s[1] = s[0];
+        s[0] = t1 + t2;
+    }
+    for (i = 0; i < 8; ++i) {
+        state[i] += s[i];
+    }
+}
+
+static void sha512_init(sha512_ctx *ctx) {
+    memcpy(ctx->state, sha512_iv, sizeof(ctx->state));
+    ctx->length = 0;
+    ctx->fill = 0;
+}
+
+static void sha512_update(sha512_ctx *ctx, const uint8_t *data, size_t length) {
+    ctx->length += length;
+    while (length > 0) {
+        size_t n = 128 - ctx->fill;
+        if (n > length) {
+            n = length;
+        }
+        memcpy(ctx->block + ctx->fill, data, n);
+        ctx->fill += n;
+        data += n;
+        length -= n;
+        if (ctx->fill == 128) {
+            sha512_compress(ctx->state, ctx->block);
+            ctx->fill = 0;
+        }
+    }
+}
+
+static void sha512_final(sha512_ctx *ctx, uint8_t digest[64]) {
+    int i;
+    ctx->block[ctx->fill++] = 0x80;
+    if (ctx->fill > 112) {
+        memset(ctx->block + ctx->fill, 0, 128 - ctx->fill);
+        sha512_compress(ctx->state, ctx->block);
+        ctx->fill = 0;
+    }
+    memset(ctx->block + ctx->fill, 0, 120 - ctx->fill);
+    store64_be(ctx->block + 120, ctx->length << 3);
+    sha512_compress(ctx->state, ctx->block);
+    for (i = 0; i < 8; ++i) {
+        store64_be(digest + 8 * i, ctx->state[i]);
+    }
+    memset(ctx, 0, sizeof(*ctx));
+}
+
+/* ---- Field arithmetic modulo p = 2^255 - 19 ----
+An element is sum(f[i] * 2^ceil(25.5*i)); even limbs hold 26 bits and odd limbs hold 25 bits.
+fe_mul() and fe_sq() accept inputs whose limbs are up to 1.6 times those sizes, i.e. a sum or
+difference of two carried elements, and return carried elements. */
+
+typedef int32_t fe[10];
+
+static const fe fe_d = {
+    56195235, 13857412, 51736253, 6949390, 114729,
+    24766616, 60832955, 30306712, 48412415, 21499315
+};
+
+static const fe fe_d2 = {
+    45281625, 27714825, 36363642, 13898781, 229458,
+    15978800, 54557047, 27058993, 29715967, 9444199
+};
+
+static const fe fe_sqrtm1 = {
+    34513072, 25610706, 9377949, 3500415, 12389472,
+    33281959, 41962654, 31548777, 326685, 11406482
+};
+
+#define FE_BITS(i) (26 - ((i) & 1))
+
+static void fe_0(fe h) {
+    memset(h, 0, sizeof(fe));
+}
+
+static void fe_1(fe h) {
+    fe_0(h);
+    h[0] = 1;
+}
+
+static void fe_copy(fe h, const fe f) {
+    memcpy(h, f, sizeof(fe));
+}
+
+static void fe_add(fe h, const fe f, const fe g) {
+    int i;
+    for (i = 0; i < 10; ++i) {
+        h[i] = f[i] + g[i];
+    }
+}
+
+static void fe_sub(fe h, const fe f, const fe g) {
+    int i;
+    for (i = 0; i < 10; ++i) {
+        h[i] = f[i] - g[i];
+    }
+}
+
+static void fe_neg(fe h, const fe f) {
+    int i;
+    for (i = 0; i < 10; ++i) {
+        h[i] = -f[i];
+    }
+}
+
+/* Propagates carries of 64-bit limbs, and stores the carried element into h.
+The carries of two chains are interleaved, as in ref10. */
+static void fe_reduce64(fe h, int64_t t[10]) {
+    int64_t c;
+#define FE_CARRY(i, bits, dst, factor)                     \
+    c = (t[i] + ((int64_t)1 << ((bits) - 1))) >> (bits);  \
+    t[dst] += (factor) * c;                                \
+    t[i] -= c * ((int64_t)1 << (bits))
+    FE_CARRY(0, 26, 1, 1);
+    FE_CARRY(4, 26, 5, 1);
+    FE_CARRY(1, 25, 2, 1);
+    FE_CARRY(5, 25, 6, 1);
+    FE_CARRY(2, 26, 3, 1);
+    FE_CARRY(6, 26, 7, 1);
+    FE_CARRY(3, 25, 4, 1);
+    FE_CARRY(7, 25, 8, 1);
+    FE_CARRY(4, 26, 5, 1);
+    FE_CARRY(8, 26, 9, 1);
+    FE_CARRY(9, 25, 0, 19);
+    FE_CARRY(0, 26, 1, 1);
+#undef FE_CARRY
+    h[0] = (int32_t)t[0];
+    h[1] = (int32_t)t[1];
+    h[2] = (int32_t)t[2];
+    h[3] = (int32_t)t[3];
+    h[4] = (int32_t)t[4];
+    h[5] = (int32_t)t[5];
+    h[6] = (int32_t)t[6];
+    h[7] = (int32_t)t[7];
+    h[8] = (int32_t)t[8];
+    h[9] = (int32_t)t[9];
+}
+
+static void fe_carry(fe h, const fe f) {
+    int64_t t[10];
+    int i;
+    for (i = 0; i < 10; ++i) {
+        t[i] = f[i];
+    }
+    fe_reduce64(h, t);
+}
+
+/* h = f * g. A product of limbs i and j lands in limb i+j, doubled when both are odd because
+of the half-bit radix, and multiplied by 19 when it wraps past 2^255. */
+static void fe_mul(fe h, const fe f, const fe g) {
+    int32_t f0 = f[0], f1 = f[1], f2 = f[2], f3 = f[3], f4 = f[4];
+    int32_t f5 = f[5], f6 = f[6], f7 = f[7], f8 = f[8], f9 = f[9];
+    int32_t g0 = g[0], g1 = g[1], g2 = g[2], g3 = g[3], g4 = g[4];
+    int32_t g5 = g[5], g6 = g[6], g7 = g[7], g8 = g[8], g9 = g[9];
+    int32_t f1_2 = 2 * f1, f3_2 = 2 * f3, f5_2 = 2 * f5, f7_2 = 2 * f7, f9_2 = 2 * f9;
+    int32_t g1_19 = 19 * g1, g2_19 = 19 * g2, g3_19 = 19 * g3, g4_19 = 19 * g4, g5_19 = 19 * g5;
+    int32_t g6_19 = 19 * g6, g7_19 = 19 * g7, g8_19 = 19 * g8, g9_19 = 19 * g9;
+    int64_t t[10];
+
+    t[0] = (int64_t)f0 * g0 + (int64_t)f1_2 * g9_19 + (int64_t)f2 * g8_19 + (int64_t)f3_2 * g7_19 +
+           (int64_t)f4 * g6_19 + (int64_t)f5_2 * g5_19 + (int64_t)f6 * g4_19 +
+           (int64_t)f7_2 * g3_19 + (int64_t)f8 * g2_19 + (int64_t)f9_2 * g1_19;
+    t[1] = (int64_t)f0 * g1 + (int64_t)f1 * g0 + (int64_t)f2 * g9_19 + (int64_t)f3 * g8_19 +
+           (int64_t)f4 * g7_19 + (int64_t)f5 * g6_19 + (int64_t)f6 * g5_19 + (int64_t)f7 * g4_19 +
+           (int64_t)f8 * g3_19 + (int64_t)f9 * g2_19;
+    t[2] = (int64_t)f0 * g2 + (int64_t)f1_2 * g1 + (int64_t)f2 * g0 + (int64_t)f3_2 * g9_19 +
+           (int64_t)f4 * g8_19 + (int64_t)f5_2 * g7_19 + (int64_t)f6 * g6_19 +
+           (int64_t)f7_2 * g5_19 + (int64_t)f8 * g4_19 + (int64_t)f9_2 * g3_19;
+    t[3] = (int64_t)f0 * g3 + (int64_t)f1 * g2 + (int64_t)f2 * g1 + (int64_t)f3 * g0 +
+           (int64_t)f4 * g9_19 + (int64_t)f5 * g8_19 + (int64_t)f6 * g7_19 + (int64_t)f7 * g6_19 +
+           (int64_t)f8 * g5_19 + (int64_t)f9 * g4_19;
+    t[4] = (int64_t)f0 * g4 + (int64_t)f1_2 * g3 + (int64_t)f2 * g2 + (int64_t)f3_2 * g1 +
+           (int64_t)f4 * g0 + (int64_t)f5_2 * g9_19 + (int64_t)f6 * g8_19 + (int64_t)f7_2 * g7_19 +
+           (int64_t)f8 * g6_19 + (int64_t)f9_2 * g5_19;
+    t[5] = (int64_t)f0 * g5 + (int64_t)f1 * g4 + (int64_t)f2 * g3 + (int64_t)f3 * g2 +
+           (int64_t)f4 * g1 + (int64_t)f5 * g0 + (int64_t)f6 * g9_19 + (int64_t)f7 * g8_19 +
+           (int64_t)f8 * g7_19 + (int64_t)f9 * g6_19;
+    t[6] = (int64_t)f0 * g6 + (int64_t)f1_2 * g5 + (int64_t)f2 * g4 + (int64_t)f3_2 * g3 +
+           (int64_t)f4 * g2 + (int64_t)f5_2 * g1 + (int64_t)f6 * g0 + (int64_t)f7_2 * g9_19 +
+           (int64_t)f8 * g8_19 + (int64_t)f9_2 * g7_19;
+    t[7] = (int64_t)f0 * g7 + (int64_t)f1 * g6 + (int64_t)f2 * g5 + (int64_t)f3 * g4 +
+           (int64_t)f4 * g3 + (int64_t)f5 * g2 + (int64_t)f6 * g1 + (int64_t)f7 * g0 +
+           (int64_t)f8 * g9_19 + (int64_t)f9 * g8_19;
+    t[8] = (int64_t)f0 * g8 + (int64_t)f1_2 * g7 + (int64_t)f2 * g6 + (int64_t)f3_2 * g5 +
+           (int64_t)f4 * g4 + (int64_t)f5_2 * g3 + (int64_t)f6 * g2 + (int64_t)f7_2 * g1 +
+           (int64_t)f8 * g0 + (int64_t)f9_2 * g9_19;
+    t[9] = (int64_t)f0 * g9 + (int64_t)f1 * g8 + (int64_t)f2 * g7 + (int64_t)f3 * g6 +
+           (int64_t)f4 * g5 + (int64_t)f5 * g4 + (int64_t)f6 * g3 + (int64_t)f7 * g2 +
+           (int64_t)f8 * g1 + (int64_t)f9 * g0;
+    fe_reduce64(h, t);
+}
+
+/* h = f * f, computing each cross product once. */
+static void fe_sq(fe h, const fe f) {
+    int32_t f0 = f[0], f1 = f[1], f2 = f[2], f3 = f[3], f4 = f[4];
+    int32_t f5 = f[5], f6 = f[6], f7 = f[7], f8 = f[8], f9 = f[9];
+    int32_t f0_2 = 2 * f0, f1_2 = 2 * f1, f2_2 = 2 * f2, f3_2 = 2 * f3, f4_2 = 2 * f4;
+    int32_t f5_2 = 2 * f5, f6_2 = 2 * f6, f7_2 = 2 * f7, f8_2 = 2 * f8, f9_2 = 2 * f9;
+    int32_t f1_4 = 4 * f1, f3_4 = 4 * f3, f5_4 = 4 * f5, f7_4 = 4 * f7;
+    int32_t f5_19 = 19 * f5, f6_19 = 19 * f6, f7_19 = 19 * f7, f8_19 = 19 * f8, f9_19 = 19 * f9;
+    int64_t t[10];
+
+    t[0] = (int64_t)f0 * f0 + (int64_t)f1_4 * f9_19 + (int64_t)f2_2 * f8_19 +
+           (int64_t)f3_4 * f7_19 + (int64_t)f4_2 * f6_19 + (int64_t)f5_2 * f5_19;
+    t[1] = (int64_t)f0_2 * f1 + (int64_t)f2_2 * f9_19 + (int64_t)f3_2 * f8_19 +
+           (int64_t)f4_2 * f7_19 + (int64_t)f5_2 * f6_19;
+    t[2] = (int64_t)f0_2 * f2 + (int64_t)f1_2 * f1 + (int64_t)f3_4 * f9_19 + (int64_t)f4_2 * f8_19 +
+           (int64_t)f5_4 * f7_19 + (int64_t)f6 * f6_19;
+    t[3] = (int64_t)f0_2 * f3 + (int64_t)f1_2 * f2 + (int64_t)f4_2 * f9_19 + (int64_t)f5_2 * f8_19 +
+           (int64_t)f6_2 * f7_19;
+    t[4] = (int64_t)f0_2 * f4 + (int64_t)f1_4 * f3 + (int64_t)f2 * f2 + (int64_t)f5_4 * f9_19 +
+           (int64_t)f6_2 * f8_19 + (int64_t)f7_2 * f7_19;
+    t[5] = (int64_t)f0_2 * f5 + (int64_t)f1_2 * f4 + (int64_t)f2_2 * f3 + (int64_t)f6_2 * f9_19 +
+           (int64_t)f7_2 * f8_19;
+    t[6] = (int64_t)f0_2 * f6 + (int64_t)f1_4 * f5 + (int64_t)f2_2 * f4 + (int64_t)f3_2 * f3 +
+           (int64_t)f7_4 * f9_19 + (int64_t)f8 * f8_19;
+    t[7] = (int64_t)f0_2 * f7 + (int64_t)f1_2 * f6 + (int64_t)f2_2 * f5 + (int64_t)f3_2 * f4 +
+           (int64_t)f8_2 * f9_19;
+    t[8] = (int64_t)f0_2 * f8 + (int64_t)f1_4 * f7 + (int64_t)f2_2 * f6 + (int64_t)f3_4 * f5 +
+           (int64_t)f4 * f4 + (int64_t)f9_2 * f9_19;
+    t[9] = (int64_t)f0_2 * f9 + (int64_t)f1_2 * f8 + (int64_t)f2_2 * f7 + (int64_t)f3_2 * f6 +
+           (int64_t)f4_2 * f5;
+    fe_reduce64(h, t);
+}
+
+/* h = f^(2^n), n >= 1. */
+static void fe_sqn(fe h, const fe f, int n) {
+    fe_sq(h, f);
+    while (--n > 0) {
+        fe_sq(h, h);
+    }
+}
+
+/* Computes f^(2^250 - 1) into t250, and f^11 into t11, which are shared by fe_invert() and
+fe_pow22523(). */
+static void fe_pow2250(fe t250, fe t11, const fe f) {
+    fe t0, t1, t2;
+    fe_sq(t0, f);                    /* 2 */
+    fe_sqn(t1, t0, 2);               /* 8 */
+    fe_mul(t1, f, t1);               /* 9 */
+    fe_mul(t11, t0, t1);             /* 11 */
+    fe_sq(t0, t11);                  /* 22 */
+    fe_mul(t0, t1, t0);              /* 2^5 - 1 */
+    fe_sqn(t1, t0, 5);
+    fe_mul(t0, t1, t0);              /* 2^10 - 1 */
+    fe_sqn(t1, t0, 10);
+    fe_mul(t1, t1, t0);              /* 2^20 - 1 */
+    fe_sqn(t2, t1, 20);
+    fe_mul(t1, t2, t1);              /* 2^40 - 1 */
+    fe_sqn(t1, t1, 10);
+    fe_mul(t0, t1, t0);              /* 2^50 - 1 */
+    fe_sqn(t1, t0, 50);
+    fe_mul(t1, t1, t0);              /* 2^100 - 1 */
+    fe_sqn(t2, t1, 100);
+    fe_mul(t1, t2, t1);              /* 2^200 - 1 */
+    fe_sqn(t1, t1, 50);
+    fe_mul(t250, t1, t0);            /* 2^250 - 1 */
+}
+
+/* h = 1/f = f^(p-2) = f^(2^255 - 21). */
+static void fe_invert(fe h, const fe f) {
+    fe t250, t11;
+    fe_pow2250(t250, t11, f);
+    fe_sqn(t250, t250, 5);           /* 2^255 - 2^5 */
+    fe_mul(h, t250, t11);
+}
+
+/* h = f^((p-5)/8) = f^(2^252 - 3). */
+static void fe_pow22523(fe h, const fe f) {
+    fe t250, t11;
+    fe_pow2250(t250, t11, f);
+    fe_sqn(t250, t250, 2);           /* 2^252 - 4 */
+    fe_mul(h, t250, f);
+}
+
+static void fe_frombytes(fe h, const uint8_t s[32]) {
+    int64_t t[10];
+    uint64_t acc = 0;
+    int nbits = 0;
+    int k = 0;
+    int i;
+    for (i = 0; i < 10; ++i) {
+        while (nbits < FE_BITS(i)) {
+            acc |= (uint64_t)s[k++] << nbits;
+            nbits += 8;
+        }
+        t[i] = (int64_t)(acc & (((uint64_t)1 << FE_BITS(i)) - 1));
+        acc >>= FE_BITS(i);
+        nbits -= FE_BITS(i);
+    }
+    fe_reduce64(h, t); /* bit 255 is ignored */
+}
+
+/* Stores the canonical encoding of carried element f. */
+static void fe_tobytes(uint8_t s[32], const fe f) {
+    int32_t h[10];
+    int32_t q;
+    int32_t c;
+    uint64_t acc = 0;
+    int nbits = 0;
+    int k = 0;
+    int i;
+
+    memcpy(h, f, sizeof(h));
+    /* q = floor(h / p), which is 0 or 1 */
+    q = (19 * h[9] + ((int32_t)1 << 24)) >> 25;
+    for (i = 0; i < 10; ++i) {
+        q = (h[i] + q) >> FE_BITS(i);
+    }
+    h[0] += 19 * q;
+    for (i = 0; i < 10; ++i) {
+        c = h[i] >> FE_BITS(i);
+        h[i] -= c * ((int32_t)1 << FE_BITS(i));
+        if (i < 9) {
+            h[i + 1] += c;
+        }
+    }
+
+    for (i = 0; i < 10; ++i) {
+        acc |= (uint64_t)(uint32_t)h[i] << nbits;
+        nbits += FE_BITS(i);
+        while (nbits >= 8) {
+            s[k++] = (uint8_t)acc;
+            acc >>= 8;
+            nbits -= 8;
+        }
+    }
+    s[k] = (uint8_t)acc;
+}
+
+static int fe_isnegative(const fe f) {
+    uint8_t s[32];
+    fe_tobytes(s, f);
+    return s[0] & 1;
+}
+
+static int fe_isnonzero(const fe f) {
+    uint8_t s[32];
+    uint8_t r = 0;
+    int i;
+    fe_tobytes(s, f);
+    for (i = 0; i < 32; ++i) {
+        r |= s[i];
+    }
+    return r != 0;
+}
+
+/* ---- Group arithmetic on -x^2 + y^2 = 1 + d x^2 y^2 ---- */
+
+/* extended coordinates: x = X/Z, y = Y/Z, x*y = T/Z */
+typedef struct {
+    fe X;
+    fe Y;
+    fe Z;
+    fe T;
+} ge_p3;
+
+/* affine point (y+x, y-x, 2dxy) */
+typedef struct {
+    fe ypx;
+    fe ymx;
+    fe xy2d;
+} ge_precomp;
+
+/* extended point (Y+X, Y-X, Z, 2dT) */
+typedef struct {
+    fe YpX;
+    fe YmX;
+    fe Z;
+    fe T2d;
+} ge_cached;
+
+static void ge_p3_0(ge_p3 *h) {
+    fe_0(h->X);
+    fe_1(h->Y);
+    fe_1(h->Z);
+    fe_0(h->T);
+}
+
+/* r = 2p, dbl-2008-hwcd. The formulas are complete, so that no special case depends on p. */
+static void ge_dbl(ge_p3 *r, const ge_p3 *p) {
+    fe a, b, c, e, f, g, h;
+    fe_sq(a, p->X);
+    fe_sq(b, p->Y);
+    fe_sq(c, p->Z);
+    fe_add(c, c, c);
+    fe_add(e, p->X, p->Y);
+    fe_sq(e, e);
+    fe_sub(e, e, a);
+    fe_sub(e, e, b);
+    fe_sub(g, b, a);
+    fe_sub(f, g, c);
+    fe_carry(f, f);
+    fe_add(h, a, b);
+    fe_neg(h, h);
+    fe_mul(r->X, e, f);
+    fe_mul(r->Y, g, h);
+    fe_mul(r->T, e, h);
+    fe_mul(r->Z, f, g);
+}
+
+/* r = p + q with precomputed affine q, madd-2008-hwcd-3. */
+static void ge_madd(ge_p3 *r, const ge_p3 *p, const ge_precomp *q) {
+    fe a, b, c, d, e, f, g, h;
+    fe_sub(a, p->Y, p->X);
+    fe_mul(a, a, q->ymx);
+    fe_add(b, p->Y, p->X);
+    fe_mul(b, b, q->ypx);
+    fe_mul(c, p->T, q->xy2d);
+    fe_add(d, p->Z, p->Z);
+    fe_sub(e, b, a);
+    fe_sub(f, d, c);
+    fe_add(g, d, c);
+    fe_add(h, b, a);
+    fe_mul(r->X, e, f);
+    fe_mul(r->Y, g, h);
+    fe_mul(r->T, e, h);
+    fe_mul(r->Z, f, g);
+}
+
+/* r = p + q with cached q, add-2008-hwcd-3. */
+static void ge_add(ge_p3 *r, const ge_p3 *p, const ge_cached *q) {
+    fe a, b, c, d, e, f, g, h;
+    fe_sub(a, p->Y, p->X);
+    fe_mul(a, a, q->YmX);
+    fe_add(b, p->Y, p->X);
+    fe_mul(b, b, q->YpX);
+    fe_mul(c, p->T, q->T2d);
+    fe_mul(d, p->Z, q->Z);
+    fe_add(d, d, d);
+    fe_sub(e, b, a);
+    fe_sub(f, d, c);
+    fe_add(g, d, c);
+    fe_add(h, b, a);
+    fe_mul(r->X, e, f);
+    fe_mul(r->Y, g, h);
+    fe_mul(r->T, e, h);
+    fe_mul(r->Z, f, g);
+}
+
+static void ge_to_cached(ge_cached *r, const ge_p3 *p) {
+    fe_add(r->YpX, p->Y, p->X);
+    fe_sub(r->YmX, p->Y, p->X);
+    fe_copy(r->Z, p->Z);
+    fe_mul(r->T2d, p->T, fe_d2);
+}
+
+static void ge_tobytes(uint8_t s[32], const ge_p3 *p) {
+    fe recip, x, y;
+    fe_invert(recip, p->Z);
+    fe_mul(x, p->X, recip);
+    fe_mul(y, p->Y, recip);
+    fe_tobytes(s, y);
+    s[31] ^= (uint8_t)(fe_isnegative(x) << 7);
+}
+
+/* Decodes s and sets h to its negation. Returns 0 on success, -1 if s is not a point. */
+static int ge_frombytes_negate_vartime(ge_p3 *h, const uint8_t s[32]) {
+    fe u, v, v3, vxx, check;
+
+    fe_frombytes(h->Y, s);
+    fe_1(h->Z);
+    fe_sq(u, h->Y);
+    fe_mul(v, u, fe_d);
+    fe_sub(u, u, h->Z);              /* u = y^2 - 1 */
+    fe_add(v, v, h->Z);              /* v = dy^2 + 1 */
+
+    fe_sq(v3, v);
+    fe_mul(v3, v3, v);               /* v3 = v^3 */
+    fe_sq(h->X, v3);
+    fe_mul(h->X, h->X, v);
+    fe_mul(h->X, h->X, u);           /* x = uv^7 */
+    fe_pow22523(h->X, h->X);         /* x = (uv^7)^((p-5)/8) */
+    fe_mul(h->X, h->X, v3);
+    fe_mul(h->X, h->X, u);           /* x = uv^3 (uv^7)^((p-5)/8) */
+
+    fe_sq(vxx, h->X);
+    fe_mul(vxx, vxx, v);
+    fe_sub(check, vxx, u);           /* vx^2 - u */
+    if (fe_isnonzero(check)) {
+        fe_add(check, vxx, u);       /* vx^2 + u */
+        if (fe_isnonzero(check)) {
+            return -1;
+        }
+        fe_mul(h->X, h->X, fe_sqrtm1);
+    }
+
+    if (!fe_isnonzero(h->X) && (s[31] >> 7)) {
+        return -1;
+    }
+    if (fe_isnegative(h->X) == (s[31] >> 7)) {
+        fe_neg(h->X, h->X);
+    }
+    fe_mul(h->T, h->X, h->Y);
+    return 0;
+}
+
+/* Fixed-base comb multiplication of the base point, after Lim and Lee.
+The scalar is split into COMB_TEETH rows of COMB_SPACING bits. Column i collects bit i of every
+row into an index, and comb_table[index] holds the matching sum of 2^(row*COMB_SPACING)*B.
+Thus a*B takes COMB_SPACING doublings and mixed additions, compared to 256 of each. */
+#include "ed25519_comb.h"
+
+/* Loads comb_table[index] into t. Every entry is read, so that memory access pattern does not
+depend on index. */
+static void comb_select(ge_precomp *t, unsigned index) {
+    uint32_t words[24] = {0};
+    uint8_t bytes[32];
+    uint32_t diff;
+    uint32_t mask;
+    unsigned j;
+    unsigned w;
+
+    for (j = 0; j < (1 << COMB_TEETH); ++j) {
+        diff = (uint32_t)j ^ (uint32_t)index;
+        mask = ((diff | ((uint32_t)0 - diff)) >> 31) - 1; /* all ones iff diff == 0 */
+        for (w = 0; w < 24; ++w) {
+            words[w] |= comb_table[j][w] & mask;
+        }
+    }
+
+    for (w = 0; w < 32; ++w) {
+        bytes[w] = (uint8_t)(words[w >> 2] >> ((w & 3) * 8));
+    }
+    fe_frombytes(t->ypx, bytes);
+    for (w = 0; w < 32; ++w) {
+        bytes[w] = (uint8_t)(words[8 + (w >> 2)] >> ((w & 3) * 8));
+    }
+    fe_frombytes(t->ymx, bytes);
+    for (w = 0; w < 32; ++w) {
+        bytes[w] = (uint8_t)(words[16 + (w >> 2)] >> ((w & 3) * 8));
+    }
+    fe_frombytes(t->xy2d, bytes);
+}
+
+/* h = a * B, where a is a 256-bit little-endian scalar. Runs in constant time. */
+static void ge_scalarmult_base(ge_p3 *h, const uint8_t a[32]) {
+    ge_precomp t;
+    unsigned index;
+    unsigned bit;
+    int i;
+    int k;
+
+    ge_p3_0(h);
+    for (i = COMB_SPACING - 1; i >= 0; --i) {
+        ge_dbl(h, h);
+        index = 0;
+        for (k = 0; k < COMB_TEETH; ++k) {
+            bit = (unsigned)(i + k * COMB_SPACING);
+            index |= (unsigned)((a[bit >> 3] >> (bit & 7)) & 1) << k;
+        }
+        comb_select(&t, index);
+        ge_madd(h, h, &t);
+    }
+}
+
+/* r = a * A + b * B, where a and b are less than 2^253. Runs in variable time, for public data only.
+Both scalars are processed in one pass of doublings, after Straus and Shamir. */
+static void ge_double_scalarmult_vartime(ge_p3 *r, const uint8_t a[32], const ge_p3 *A,
+                                         const uint8_t b[32]) {
+    ge_precomp B;
+    ge_cached cA;
+    ge_cached cAB;
+    ge_p3 AB;
+    int i;
+    int da;
+    int db;
+
+    comb_select(&B, 1);
+    ge_to_cached(&cA, A);
+    ge_madd(&AB, A, &B);
+    ge_to_cached(&cAB, &AB);
+
+    ge_p3_0(r);
+    for (i = 252; i >= 0; --i) {
+        ge_dbl(r, r);
+        da = (a[i >> 3] >> (i & 7)) & 1;
+        db = (b[i >> 3] >> (i & 7)) & 1;
+        if (da && db) {
+            ge_add(r, r, &cAB);
+        } else if (da) {
+            ge_add(r, r, &cA);
+        } else if (db) {
+            ge_madd(r, r, &B);
+        }
+    }
+}
+
+/* ---- Scalar arithmetic modulo L = 2^252 + 27742317777372353535851937790883648493 ---- */
+
+static const uint8_t sc_L[32] = {
+    0xED, 0xD3, 0xF5, 0x5C, 0x1A, 0x63, 0x12, 0x58, 0xD6, 0x9C, 0xF7, 0xA2, 0xDE, 0xF9, 0xDE, 0x14,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10
+};
+
+/* Reduces x, given as 64 signed base-256 digits, modulo L into r. */
+static void sc_modL(uint8_t r[32], int64_t x[64]) {
+    int64_t carry;
+    int i;
+    int j;
+
+    /* fold digit i >= 32 using 2^256 = -16 * (L - 2^252) mod L */
+    for (i = 63; i >= 32; --i) {
+        carry = 0;
+        for (j = i - 32; j < i - 12; ++j) {
+            x[j] += carry - 16 * x[i] * sc_L[j - (i - 32)];
+            carry = (x[j] + 128) >> 8;
+            x[j] -= carry * 256;
+        }
+        x[j] += carry;
+        x[i] = 0;
+    }
+    carry = 0;
+    for (j = 0; j < 32; ++j) {
+        x[j] += carry - (x[31] >> 4) * sc_L[j];
+        carry = x[j] >> 8;
+        x[j] &= 255;
+    }
+    for (j = 0; j < 32; ++j) {
+        x[j] -= carry * sc_L[j];
+    }
+    for (i = 0; i < 32; ++i) {
+        x[i + 1] += x[i] >> 8;
+        r[i] = (uint8_t)(x[i] & 255);
+    }
+}
+
+/* Reduces the 512-bit little-endian s modulo L into s[0..31]. */
+static void sc_reduce(uint8_t s[64]) {
+    int64_t x[64];
+    int i;
+    for (i = 0; i < 64; ++i) {
+        x[i] = s[i];
+    }
+    memset(s, 0, 64);
+    sc_modL(s, x);
+    memset(x, 0, sizeof(x));
+}
+
+/* Determines whether s < L, as RFC 8032 requires of the S component. */
+static int sc_is_canonical(const uint8_t s[32]) {
+    int i;
+    for (i = 31; i >= 0; --i) {
+        if (s[i] != sc_L[i]) {
+            return s[i] < sc_L[i];
+        }
+    }
+    return 0;
+}
+
+/* ---- Ed25519 ---- */
+
+void ed25519_expand_key(uint8_t expanded_key[ED25519_EXPANDED_KEY_SIZE],
+                        uint8_t public_key[ED25519_PUBLIC_KEY_SIZE],
+                        const uint8_t seed[ED25519_SEED_SIZE]) {
+    sha512_ctx ctx;
+    ge_p3 A;
+
+    sha512_init(&ctx);
+    sha512_update(&ctx, seed, ED25519_SEED_SIZE);
+    sha512_final(&ctx, expanded_key);
+    expanded_key[0] &= 248;
+    expanded_key[31] &= 127;
+    expanded_key[31] |= 64;
+
+    ge_scalarmult_base(&A, expanded_key);
+    ge_tobytes(public_key, &A);
+    memset(&A, 0, sizeof(A));
+}
+
+void ed25519_sign(uint8_t signature[ED25519_SIGNATURE_SIZE],
+                  const uint8_t *message, size_t length,
+                  const uint8_t expanded_key[ED25519_EXPANDED_KEY_SIZE],
+                  const uint8_t public_key[ED25519_PUBLIC_KEY_SIZE]) {
+    sha512_ctx ctx;
+    uint8_t r[64];
+    uint8_t k[64];
+    int64_t x[64];
+    ge_p3 R;
+    int i;
+    int j;
+
+    /* r = H(prefix || M) mod L, R = r * B */
+    sha512_init(&ctx);
+    sha512_update(&ctx, expanded_key + 32, 32);
+    sha512_update(&ctx, message, length);
+    sha512_final(&ctx, r);
+    sc_reduce(r);
+    ge_scalarmult_base(&R, r);
+    ge_tobytes(signature, &R);
+
+    /* k = H(R || A || M) mod L */
+    sha512_init(&ctx);
+    sha512_update(&ctx, signature, 32);
+    sha512_update(&ctx, public_key, ED25519_PUBLIC_KEY_SIZE);
+    sha512_update(&ctx, message, length);
+    sha512_final(&ctx, k);
+    sc_reduce(k);
+
+    /* S = r + k * a mod L */
+    for (i = 0; i < 64; ++i) {
+        x[i] = i < 32 ? r[i] : 0;
+    }
+    for (i = 0; i < 32; ++i) {
+        for (j = 0; j < 32; ++j) {
+            x[i + j] += (int64_t)k[i] * expanded_key[j];
+        }
+    }
+    sc_modL(signature + 32, x);
+
+    memset(r, 0, sizeof(r));
+    memset(x, 0, sizeof(x));
+    memset(&R, 0, sizeof(R));
+}
+
+int ed25519_verify(const uint8_t signature[ED25519_SIGNATURE_SIZE],
+                   const uint8_t *message, size_t length,
+                   const uint8_t public_key[ED25519_PUBLIC_KEY_SIZE]) {
+    sha512_ctx ctx;
+    uint8_t k[64];
+    uint8_t check[32];
+    uint8_t diff = 0;
+    ge_p3 A;
+    ge_p3 R;
+    int i;
+
+    if (!sc_is_canonical(signature + 32) ||
+        ge_frombytes_negate_vartime(&A, public_key) != 0) {
+        return 0;
+    }
+
+    sha512_init(&ctx);
+    sha512_update(&ctx, signature, 32);
+    sha512_update(&ctx, public_key, ED25519_PUBLIC_KEY_SIZE);
+    sha512_update(&ctx, message, length);
+    sha512_final(&ctx, k);
+    sc_reduce(k);
+
+    /* R' = k * (-A) + S * B, which equals R in a valid signature */
+    ge_double_scalarmult_vartime(&R, k, &A, signature + 32);
+    ge_tobytes(check, &R);
+    for (i = 0; i < 32; ++i) {
+        diff |= check[i] ^ signature[i];
+    }
+    return diff == 0;
+}
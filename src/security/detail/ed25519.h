@@ -0,0 +1,74 @@
+#ifndef ESP8266NDN_ED25519_H
+#define ESP8266NDN_ED25519_H
+
+/* Compact Ed25519 (RFC 8032, PureEdDSA) signing and verification.
+
+Field elements use ten signed limbs in radix 2^25.5, so that multiplications fit 32x32->64-bit
+instructions of 32-bit microcontrollers. Operations on secret data run in constant time:
+signing and key expansion compute the scalar multiplication with a fixed-base comb whose table
+entries are selected by scanning every entry, and branch only on public data. */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define ED25519_SEED_SIZE 32
+#define ED25519_EXPANDED_KEY_SIZE 64
+#define ED25519_PUBLIC_KEY_SIZE 32
+#define ED25519_SIGNATURE_SIZE 64
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* ed25519_expand_key() function.
+Derive the signing key and public key from a 32-byte private key seed.
+
+Inputs:
+    seed - The private key seed, which should be 32 random bytes.
+
+Outputs:
+    expanded_key - Will be filled in with the clamped secret scalar and the nonce prefix.
+    public_key   - Will be filled in with the encoded public key.
+*/
+void ed25519_expand_key(uint8_t expanded_key[ED25519_EXPANDED_KEY_SIZE],
+                        uint8_t public_key[ED25519_PUBLIC_KEY_SIZE],
+                        const uint8_t seed[ED25519_SEED_SIZE]);
+
+/* ed25519_sign() function.
+Generate an Ed25519 signature of a message.
+
+Inputs:
+    message      - The message to sign.
+    length       - The message length.
+    expanded_key - The output of ed25519_expand_key().
+    public_key   - The public key from ed25519_expand_key().
+
+Outputs:
+    signature - Will be filled in with the signature value.
+*/
+void ed25519_sign(uint8_t signature[ED25519_SIGNATURE_SIZE],
+                  const uint8_t *message, size_t length,
+                  const uint8_t expanded_key[ED25519_EXPANDED_KEY_SIZE],
+                  const uint8_t public_key[ED25519_PUBLIC_KEY_SIZE]);
+
+/* ed25519_verify() function.
+Verify an Ed25519 signature of a message.
+
+Inputs:
+    signature  - The signature value.
+    message    - The signed message.
+    length     - The message length.
+    public_key - The public key of the signer.
+
+Returns 1 if the signature is valid, 0 if it is invalid.
+*/
+int ed25519_verify(const uint8_t signature[ED25519_SIGNATURE_SIZE],
+                   const uint8_t *message, size_t length,
+                   const uint8_t public_key[ED25519_PUBLIC_KEY_SIZE]);
+
+#ifdef __cplusplus
+} /* end of extern "C" */
+#endif
+
+#endif /* ESP8266NDN_ED25519_H */
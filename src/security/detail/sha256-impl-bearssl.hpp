@@ -7,7 +7,7 @@
 namespace ndn {
 namespace detail {
 
-static void
+inline void
 sha256(const uint8_t* input, size_t len, uint8_t* result)
 {
   br_sha256_context ctx;
@@ -16,6 +16,31 @@ sha256(const uint8_t* input, size_t len, uint8_t* result)
   br_sha256_out(&ctx, result);
 }
 
+class Sha256Impl
+{
+public:
+  void
+  begin()
+  {
+    br_sha256_init(&m_ctx);
+  }
+
+  void
+  update(const uint8_t* input, size_t len)
+  {
+    br_sha256_update(&m_ctx, input, len);
+  }
+
+  void
+  finish(uint8_t* result)
+  {
+    br_sha256_out(&m_ctx, result);
+  }
+
+private:
+  br_sha256_context m_ctx;
+};
+
 class HmacImpl
 {
 public:
@@ -33,8 +58,27 @@ public:
     br_hmac_out(&ctx, sig);
   }
 
+  void
+  begin() const
+  {
+    br_hmac_init(&m_stream, &m_key, 0);
+  }
+
+  void
+  update(const uint8_t* input, size_t inputLen) const
+  {
+    br_hmac_update(&m_stream, input, inputLen);
+  }
+
+  void
+  finish(uint8_t* sig) const
+  {
+    br_hmac_out(&m_stream, sig);
+  }
+
 private:
   br_hmac_key_context m_key;
+  mutable br_hmac_context m_stream;
 };
 
 } // namespace detail
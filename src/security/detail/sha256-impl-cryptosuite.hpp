@@ -6,7 +6,7 @@
 namespace ndn {
 namespace detail {
 
-static void
+inline void
 sha256(const uint8_t* input, size_t len, uint8_t* result)
 {
   Sha256 sha;
@@ -15,6 +15,31 @@ sha256(const uint8_t* input, size_t len, uint8_t* result)
   memcpy(result, sha.result(), HASH_LENGTH);
 }
 
+class Sha256Impl
+{
+public:
+  void
+  begin()
+  {
+    m_sha.init();
+  }
+
+  void
+  update(const uint8_t* input, size_t len)
+  {
+    m_sha.write(input, len);
+  }
+
+  void
+  finish(uint8_t* result)
+  {
+    memcpy(result, m_sha.result(), HASH_LENGTH);
+  }
+
+private:
+  Sha256 m_sha;
+};
+
 class HmacImpl
 {
 public:
@@ -31,6 +56,24 @@ public:
     memcpy(sig, m_sha.resultHmac(), HASH_LENGTH);
   }
 
+  void
+  begin() const
+  {
+    m_sha.reset();
+  }
+
+  void
+  update(const uint8_t* input, size_t inputLen) const
+  {
+    m_sha.write(input, inputLen);
+  }
+
+  void
+  finish(uint8_t* sig) const
+  {
+    memcpy(sig, m_sha.resultHmac(), HASH_LENGTH);
+  }
+
 private:
   mutable Sha256 m_sha;
 };
@@ -7,12 +7,47 @@
 namespace ndn {
 namespace detail {
 
-static void
+inline void
 sha256(const uint8_t* input, size_t len, uint8_t* result)
 {
   mbedtls_sha256_ret(input, len, result, 0);
 }
 
+class Sha256Impl
+{
+public:
+  Sha256Impl()
+  {
+    mbedtls_sha256_init(&m_ctx);
+  }
+
+  ~Sha256Impl()
+  {
+    mbedtls_sha256_free(&m_ctx);
+  }
+
+  void
+  begin()
+  {
+    mbedtls_sha256_starts_ret(&m_ctx, 0);
+  }
+
+  void
+  update(const uint8_t* input, size_t len)
+  {
+    mbedtls_sha256_update_ret(&m_ctx, input, len);
+  }
+
+  void
+  finish(uint8_t* result)
+  {
+    mbedtls_sha256_finish_ret(&m_ctx, result);
+  }
+
+private:
+  mbedtls_sha256_context m_ctx;
+};
+
 class HmacImpl
 {
 public:
@@ -31,14 +66,31 @@ public:
   void
   computeHmac(const uint8_t* input, size_t inputLen, uint8_t* sig) const
   {
-    auto ctx = const_cast<mbedtls_md_context_t*>(&m_ctx);
-    mbedtls_md_hmac_update(ctx, input, inputLen);
-    mbedtls_md_hmac_finish(ctx, sig);
-    mbedtls_md_hmac_reset(ctx);
+    this->begin();
+    this->update(input, inputLen);
+    this->finish(sig);
+  }
+
+  void
+  begin() const
+  {
+    mbedtls_md_hmac_reset(&m_ctx);
+  }
+
+  void
+  update(const uint8_t* input, size_t inputLen) const
+  {
+    mbedtls_md_hmac_update(&m_ctx, input, inputLen);
+  }
+
+  void
+  finish(uint8_t* sig) const
+  {
+    mbedtls_md_hmac_finish(&m_ctx, sig);
   }
 
 private:
-  mbedtls_md_context_t m_ctx;
+  mutable mbedtls_md_context_t m_ctx;
 };
 
 } // namespace detail
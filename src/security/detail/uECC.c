@@ -1778,18 +1778,211 @@ static void EccPoint_mult(EccPoint * RESTRICT result,
     vli_set(result->y, Ry[0]);
 }
 
+#if uECC_COMB_TEETH
+
+#if (uECC_CURVE != uECC_secp256r1)
+    #error "uECC_COMB_TEETH is only supported on secp256r1"
+#endif
+
+/* Fixed-base comb multiplication of the generator, after Lim and Lee.
+The scalar is split into uECC_COMB_TEETH rows of COMB_SPACING bits. Column i collects bit i of
+every row into an index, and comb_table[index - 1] holds the matching sum of 2^(row*COMB_SPACING)*G.
+Thus k*G takes COMB_SPACING doublings and additions, compared to 256 ladder steps. */
+#include "uECC_comb.h"
+
+#define COMB_SPACING ((uECC_BYTES * 8 + uECC_COMB_TEETH - 1) / uECC_COMB_TEETH)
+#define COMB_POINTS ((1 << uECC_COMB_TEETH) - 1)
+
+/* Sets dest = src if cond is 1, leaves dest unchanged if cond is 0, in constant time. */
+static void vli_cmov(uECC_word_t *dest, const uECC_word_t *src, uECC_word_t cond) {
+    uECC_word_t mask = (uECC_word_t)0 - cond;
+    wordcount_t i;
+    for (i = 0; i < uECC_WORDS; ++i) {
+        dest[i] = (dest[i] & ~mask) | (src[i] & mask);
+    }
+}
+
+/* Loads comb_table[index - 1] into point. Every entry is read, so that memory access pattern
+does not depend on index. point is set to (0, 0) if index is 0. */
+static void comb_select(EccPoint *point, uECC_word_t index) {
+    uint32_t words[16] = {0};
+    uint32_t diff;
+    uint32_t mask;
+    unsigned j;
+    unsigned w;
+
+    for (j = 0; j < COMB_POINTS; ++j) {
+        diff = (uint32_t)(j + 1) ^ (uint32_t)index;
+        mask = ((diff | ((uint32_t)0 - diff)) >> 31) - 1; /* all ones iff diff == 0 */
+        for (w = 0; w < 16; ++w) {
+            words[w] |= comb_table[j][w] & mask;
+        }
+    }
+
+    for (w = 0; w < uECC_WORDS; ++w) {
+    #if (uECC_WORD_SIZE == 1)
+        point->x[w] = (uint8_t)(words[w >> 2] >> ((w & 3) * 8));
+        point->y[w] = (uint8_t)(words[8 + (w >> 2)] >> ((w & 3) * 8));
+    #elif (uECC_WORD_SIZE == 4)
+        point->x[w] = words[w];
+        point->y[w] = words[8 + w];
+    #else
+        point->x[w] = words[2 * w] | ((uint64_t)words[2 * w + 1] << 32);
+        point->y[w] = words[8 + 2 * w] | ((uint64_t)words[8 + 2 * w + 1] << 32);
+    #endif
+    }
+}
+
+/* Add affine point (x2, y2) to Jacobian point (X1, Y1, Z1) in place. */
+static void EccPoint_add_mixed_jacobian(uECC_word_t * RESTRICT X1,
+                                        uECC_word_t * RESTRICT Y1,
+                                        uECC_word_t * RESTRICT Z1,
+                                        const EccPoint * RESTRICT point) {
+    uECC_word_t t1[uECC_WORDS];
+    uECC_word_t t2[uECC_WORDS];
+    uECC_word_t t3[uECC_WORDS];
+
+    if (vli_isZero(Z1)) {
+        vli_set(X1, point->x);
+        vli_set(Y1, point->y);
+        vli_clear(Z1);
+        Z1[0] = 1;
+        return;
+    }
+
+    vli_modSquare_fast(t1, Z1);          /* t1 = z1^2 */
+    vli_modMult_fast(t2, t1, Z1);        /* t2 = z1^3 */
+    vli_modMult_fast(t1, t1, point->x);  /* t1 = x2*z1^2 = U2 */
+    vli_modMult_fast(t2, t2, point->y);  /* t2 = y2*z1^3 = S2 */
+    vli_modSub_fast(t1, t1, X1);         /* t1 = U2 - x1 = H */
+    vli_modSub_fast(t2, t2, Y1);         /* t2 = S2 - y1 = R */
+
+    if (vli_isZero(t1)) {
+        /* Points have same x. This does not happen with a random scalar. */
+        if (vli_isZero(t2)) {
+            vli_set(X1, point->x);
+            vli_set(Y1, point->y);
+            vli_clear(Z1);
+            Z1[0] = 1;
+            EccPoint_double_jacobian(X1, Y1, Z1);
+        } else {
+            vli_clear(Z1); /* point at infinity */
+        }
+        return;
+    }
+
+    vli_modMult_fast(Z1, Z1, t1);  /* z3 = z1*H */
+    vli_modSquare_fast(t3, t1);    /* t3 = H^2 */
+    vli_modMult_fast(t1, t1, t3);  /* t1 = H^3 */
+    vli_modMult_fast(t3, t3, X1);  /* t3 = x1*H^2 = V */
+    vli_modMult_fast(Y1, Y1, t1);  /* y1 = y1*H^3 */
+    vli_modSquare_fast(X1, t2);    /* x1 = R^2 */
+    vli_modSub_fast(X1, X1, t1);   /* x1 = R^2 - H^3 */
+    vli_modSub_fast(X1, X1, t3);   /* x1 = R^2 - H^3 - V */
+    vli_modSub_fast(X1, X1, t3);   /* x1 = R^2 - H^3 - 2*V = x3 */
+    vli_modSub_fast(t3, t3, X1);   /* t3 = V - x3 */
+    vli_modMult_fast(t3, t3, t2);  /* t3 = R*(V - x3) */
+    vli_modSub_fast(Y1, t3, Y1);   /* y1 = R*(V - x3) - y1*H^3 = y3 */
+}
+
+/* Computes result = scalar * G, where 0 < scalar < curve_n.
+Time and memory access pattern do not depend on the scalar. */
+static void EccPoint_mult_comb(EccPoint * RESTRICT result, const uECC_word_t * RESTRICT scalar) {
+    uECC_word_t X[uECC_WORDS];
+    uECC_word_t Y[uECC_WORDS];
+    uECC_word_t Z[uECC_WORDS];
+    uECC_word_t sX[uECC_WORDS];
+    uECC_word_t sY[uECC_WORDS];
+    uECC_word_t sZ[uECC_WORDS];
+    uECC_word_t one[uECC_WORDS];
+    uECC_word_t random[uECC_WORDS];
+    EccPoint point;
+    uECC_word_t index;
+    uECC_word_t nonzero;
+    uECC_word_t infinity = 1;
+    uECC_word_t tries;
+    bitcount_t i;
+    bitcount_t bit;
+    int t;
+
+    vli_clear(one);
+    one[0] = 1;
+
+    /* While the accumulator is still the point at infinity, operate on G instead and discard
+       the results, so that leading zero columns take as long as the others. */
+    vli_set(X, curve_G.x);
+    vli_set(Y, curve_G.y);
+    vli_set(Z, one);
+
+    for (i = COMB_SPACING - 1; i >= 0; --i) {
+        EccPoint_double_jacobian(X, Y, Z);
+
+        index = 0;
+        for (t = 0; t < uECC_COMB_TEETH; ++t) {
+            bit = i + t * COMB_SPACING;
+            if (bit < uECC_BYTES * 8) {
+                index |= (uECC_word_t)(!!vli_testBit(scalar, bit)) << t;
+            }
+        }
+        nonzero = !!index;
+        comb_select(&point, index | !nonzero); /* use entry 1 as a dummy for index 0 */
+
+        vli_set(sX, X);
+        vli_set(sY, Y);
+        vli_set(sZ, Z);
+        EccPoint_add_mixed_jacobian(sX, sY, sZ, &point);
+
+        vli_cmov(X, sX, nonzero & !infinity);
+        vli_cmov(Y, sY, nonzero & !infinity);
+        vli_cmov(Z, sZ, nonzero & !infinity);
+        vli_cmov(X, point.x, nonzero & infinity);
+        vli_cmov(Y, point.y, nonzero & infinity);
+        vli_cmov(Z, one, nonzero & infinity);
+        infinity &= !nonzero;
+    }
+
+    /* Prevent side channel analysis of vli_modInv() to determine bits of Z,
+       which depends on the scalar, by premultiplying by a random number. */
+    vli_set(random, one);
+    for (tries = 0; tries < MAX_TRIES; ++tries) {
+        if (g_rng_function((uint8_t *)sX, sizeof(sX)) && !vli_isZero(sX) &&
+                vli_cmp(curve_p, sX) == 1) {
+            vli_set(random, sX);
+            break;
+        }
+    }
+    vli_modMult_fast(Z, Z, random);  /* z' = rand * z */
+    vli_modInv(Z, Z, curve_p);       /* z = 1 / z' */
+    vli_modMult_fast(Z, Z, random);  /* z = 1 / z */
+    apply_z(X, Y, Z);
+
+    vli_set(result->x, X);
+    vli_set(result->y, Y);
+}
+
+#endif /* uECC_COMB_TEETH */
+
 static int EccPoint_compute_public_key(EccPoint *result, uECC_word_t *private) {
+#if !uECC_COMB_TEETH
     uECC_word_t tmp1[uECC_WORDS];
     uECC_word_t tmp2[uECC_WORDS];
     uECC_word_t *p2[2] = {tmp1, tmp2};
     uECC_word_t carry;
+#endif
 
     /* Make sure the private key is in the range [1, n-1]. */
     if (vli_isZero(private)) {
         return 0;
     }
 
-#if (uECC_CURVE == uECC_secp160r1)
+#if uECC_COMB_TEETH
+    if (vli_cmp(curve_n, private) != 1) {
+        return 0;
+    }
+
+    // The comb processes a fixed number of columns, so the bitcount needs no regularization.
+    EccPoint_mult_comb(result, private);
+#elif (uECC_CURVE == uECC_secp160r1)
     // Don't regularize the bitcount for secp160r1, since it would have a larger performance
     // impact (about 2% slower on average) and requires the vli_xxx_n functions, leading to
     // a significant increase in code size.
@@ -2426,13 +2619,13 @@ static void vli_modMult_n(uECC_word_t *result, const uECC_word_t *left, const uE
 }
 #endif /* (uECC_CURVE != uECC_secp160r1) */
 
-static int uECC_sign_with_k(const uint8_t private_key[uECC_BYTES],
-                            const uint8_t message_hash[uECC_BYTES],
-                            uECC_word_t k[uECC_N_WORDS],
-                            uint8_t signature[uECC_BYTES*2]) {
+/* Computes r = x(k * G) mod n, and replaces k with 1/k mod n. */
+static int compute_nonce(uECC_word_t k[uECC_N_WORDS], uECC_word_t r[uECC_N_WORDS]) {
     uECC_word_t tmp[uECC_N_WORDS];
+#if !uECC_COMB_TEETH
     uECC_word_t s[uECC_N_WORDS];
     uECC_word_t *k2[2] = {tmp, s};
+#endif
     EccPoint p;
     uECC_word_t carry;
     uECC_word_t tries;
@@ -2451,6 +2644,10 @@ static int uECC_sign_with_k(const uint8_t private_key[uECC_BYTES],
 
     /* p = k * G */
     EccPoint_mult(&p, &curve_G, k2[!carry], 0, (uECC_BYTES * 8) + 2);
+#else
+#if uECC_COMB_TEETH
+    /* p = k * G, in time independent of k */
+    EccPoint_mult_comb(&p, k);
 #else
     /* Make sure that we don't leak timing information about k.
        See http://eprint.iacr.org/2011/232.pdf */
@@ -2459,6 +2656,7 @@ static int uECC_sign_with_k(const uint8_t private_key[uECC_BYTES],
 
     /* p = k * G */
     EccPoint_mult(&p, &curve_G, k2[!carry], 0, (uECC_BYTES * 8) + 1);
+#endif
 
     /* r = x1 (mod n) */
     if (vli_cmp(curve_n, p.x) != 1) {
@@ -2494,17 +2692,31 @@ static int uECC_sign_with_k(const uint8_t private_key[uECC_BYTES],
     vli_modInv_n(k, k, curve_n); /* k = 1 / k' */
     vli_modMult_n(k, k, tmp); /* k = 1 / k */
 
-    vli_nativeToBytes(signature, p.x); /* store r */
+    r[uECC_N_WORDS - 1] = 0;
+    vli_set(r, p.x);
+    return 1;
+}
+
+/* Computes s = (e + r*d) / k, and writes r and s into signature. */
+static int sign_with_nonce(const uint8_t private_key[uECC_BYTES],
+                           const uint8_t message_hash[uECC_BYTES],
+                           const uECC_word_t r[uECC_N_WORDS],
+                           const uECC_word_t k_inverse[uECC_N_WORDS],
+                           uint8_t signature[uECC_BYTES*2]) {
+    uECC_word_t tmp[uECC_N_WORDS];
+    uECC_word_t s[uECC_N_WORDS];
+
+    vli_nativeToBytes(signature, r); /* store r */
 
     tmp[uECC_N_WORDS - 1] = 0;
     vli_bytesToNative(tmp, private_key); /* tmp = d */
     s[uECC_N_WORDS - 1] = 0;
-    vli_set(s, p.x);
+    vli_set(s, r);
     vli_modMult_n(s, tmp, s); /* s = r*d */
 
     vli_bytesToNative(tmp, message_hash);
     vli_modAdd_n(s, tmp, s, curve_n); /* s = e + r*d */
-    vli_modMult_n(s, s, k); /* s = (e + r*d) / k */
+    vli_modMult_n(s, s, k_inverse); /* s = (e + r*d) / k */
 #if (uECC_CURVE == uECC_secp160r1)
     if (s[uECC_N_WORDS - 1]) {
         return 0;
@@ -2514,6 +2726,14 @@ static int uECC_sign_with_k(const uint8_t private_key[uECC_BYTES],
     return 1;
 }
 
+static int uECC_sign_with_k(const uint8_t private_key[uECC_BYTES],
+                            const uint8_t message_hash[uECC_BYTES],
+                            uECC_word_t k[uECC_N_WORDS],
+                            uint8_t signature[uECC_BYTES*2]) {
+    uECC_word_t r[uECC_N_WORDS];
+    return compute_nonce(k, r) && sign_with_nonce(private_key, message_hash, r, k, signature);
+}
+
 int uECC_sign(const uint8_t private_key[uECC_BYTES],
               const uint8_t message_hash[uECC_BYTES],
               uint8_t signature[uECC_BYTES*2]) {
@@ -2533,6 +2753,41 @@ int uECC_sign(const uint8_t private_key[uECC_BYTES],
     return 0;
 }
 
+#if (uECC_CURVE != uECC_secp160r1)
+int uECC_precompute_nonce(uint8_t r[uECC_BYTES], uint8_t k_inverse[uECC_BYTES]) {
+    uECC_word_t k[uECC_N_WORDS];
+    uECC_word_t r_native[uECC_N_WORDS];
+    uECC_word_t tries;
+
+    for (tries = 0; tries < MAX_TRIES; ++tries) {
+        if (g_rng_function((uint8_t *)k, sizeof(k)) && compute_nonce(k, r_native)) {
+            vli_nativeToBytes(r, r_native);
+            vli_nativeToBytes(k_inverse, k);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int uECC_sign_with_nonce(const uint8_t private_key[uECC_BYTES],
+                         const uint8_t message_hash[uECC_BYTES],
+                         const uint8_t r[uECC_BYTES],
+                         const uint8_t k_inverse[uECC_BYTES],
+                         uint8_t signature[uECC_BYTES*2]) {
+    uECC_word_t r_native[uECC_N_WORDS];
+    uECC_word_t k_native[uECC_N_WORDS];
+
+    vli_bytesToNative(r_native, r);
+    vli_bytesToNative(k_native, k_inverse);
+    /* Make sure 0 < r < curve_n and 0 < 1/k < curve_n */
+    if (vli_isZero(r_native) || vli_cmp(curve_n, r_native) != 1 ||
+            vli_isZero(k_native) || vli_cmp(curve_n, k_native) != 1) {
+        return 0;
+    }
+    return sign_with_nonce(private_key, message_hash, r_native, k_native, signature);
+}
+#endif /* (uECC_CURVE != uECC_secp160r1) */
+
 /* Compute an HMAC using K as a key (as in RFC 6979). Note that K is always
    the same size as the hash result size. */
 static void HMAC_init(uECC_HashContext *hash_context, const uint8_t *K) {
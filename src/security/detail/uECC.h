@@ -51,6 +51,16 @@ faster by about 8% but increases the code size. */
     #define uECC_SQUARE_FUNC 1
 #endif
 
+/* uECC_COMB_TEETH - If nonzero, uECC_make_key(), uECC_compute_public_key(), and uECC_sign()
+compute multiples of the generator with a fixed-base comb over a precomputed table, instead of the
+generic Montgomery ladder. Possible values are 4, 6, and 8 teeth; a table of
+(2^uECC_COMB_TEETH - 1) points is placed in flash, occupying 960, 4032, or 16320 bytes.
+More teeth make the table larger and signing faster. Define as 0 to disable.
+Only secp256r1 is supported. */
+#ifndef uECC_COMB_TEETH
+    #define uECC_COMB_TEETH 6
+#endif
+
 #define uECC_CONCAT1(a, b) a##b
 #define uECC_CONCAT(a, b) uECC_CONCAT1(a, b)
 
@@ -145,6 +155,40 @@ int uECC_sign(const uint8_t private_key[uECC_BYTES],
               const uint8_t message_hash[uECC_BYTES],
               uint8_t signature[uECC_BYTES*2]);
 
+/* uECC_precompute_nonce() function.
+Generate a random ECDSA nonce k and compute the message-independent part of a signature.
+This contains the scalar multiplication that dominates the cost of uECC_sign(), so that it can
+be performed ahead of time. Not available on secp160r1.
+
+Outputs:
+    r         - Will be filled in with x(k * G) mod n, the first half of the signature.
+    k_inverse - Will be filled in with 1/k mod n. This must be kept secret, and used only once.
+
+Returns 1 if the nonce was generated successfully, 0 if an error occurred.
+*/
+int uECC_precompute_nonce(uint8_t r[uECC_BYTES], uint8_t k_inverse[uECC_BYTES]);
+
+/* uECC_sign_with_nonce() function.
+Generate an ECDSA signature for a given hash value, using a nonce from uECC_precompute_nonce().
+This takes a few modular multiplications only. Reusing a nonce reveals the private key.
+
+Inputs:
+    private_key  - Your private key.
+    message_hash - The hash of the message to sign.
+    r            - The r value from uECC_precompute_nonce().
+    k_inverse    - The k_inverse value from uECC_precompute_nonce().
+
+Outputs:
+    signature - Will be filled in with the signature value.
+
+Returns 1 if the signature generated successfully, 0 if an error occurred.
+*/
+int uECC_sign_with_nonce(const uint8_t private_key[uECC_BYTES],
+                         const uint8_t message_hash[uECC_BYTES],
+                         const uint8_t r[uECC_BYTES],
+                         const uint8_t k_inverse[uECC_BYTES],
+                         uint8_t signature[uECC_BYTES*2]);
+
 /* uECC_HashContext structure.
 This is used to pass in an arbitrary hash function to uECC_sign_deterministic().
 The structure will be used for multiple hash computations; each time a new hash
@@ -1,9 +1,14 @@
 #include "digest-key.hpp"
+#include "detail/sha256-impl.hpp"
 #include "../ndn-cpp/lite/util/crypto-lite.hpp"
 #include <cstring>
 
 namespace ndn {
 
+DigestKey::DigestKey() = default;
+
+DigestKey::~DigestKey() = default;
+
 int
 DigestKey::sign(const uint8_t* input, size_t inputLen, uint8_t* sig) const
 {
@@ -30,4 +35,54 @@ DigestKey::verify(const uint8_t* input, size_t inputLen, const uint8_t* sig, siz
   return std::memcmp(sig, newSig, ndn_SHA256_DIGEST_SIZE) == 0;
 }
 
+bool
+DigestKey::beginSign() const
+{
+  if (m_stream == nullptr) {
+    m_stream.reset(new detail::Sha256Impl());
+  }
+  m_stream->begin();
+  return true;
+}
+
+void
+DigestKey::updateSign(const uint8_t* input, size_t inputLen) const
+{
+  if (m_stream != nullptr) {
+    m_stream->update(input, inputLen);
+  }
+}
+
+int
+DigestKey::finishSign(uint8_t* sig) const
+{
+  if (m_stream == nullptr) {
+    return 0;
+  }
+  m_stream->finish(sig);
+  return ndn_SHA256_DIGEST_SIZE;
+}
+
+bool
+DigestKey::beginVerify() const
+{
+  return this->beginSign();
+}
+
+void
+DigestKey::updateVerify(const uint8_t* input, size_t inputLen) const
+{
+  this->updateSign(input, inputLen);
+}
+
+bool
+DigestKey::finishVerify(const uint8_t* sig, size_t sigLen) const
+{
+  uint8_t newSig[ndn_SHA256_DIGEST_SIZE];
+  if (sigLen != ndn_SHA256_DIGEST_SIZE || this->finishSign(newSig) == 0) {
+    return false;
+  }
+  return std::memcmp(sig, newSig, ndn_SHA256_DIGEST_SIZE) == 0;
+}
+
 } // namespace ndn
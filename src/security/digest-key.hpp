@@ -3,14 +3,22 @@
 
 #include "private-key.hpp"
 #include "public-key.hpp"
+#include <memory>
 
 namespace ndn {
+namespace detail {
+class Sha256Impl;
+} // namespace detail
 
 /** \brief Selects DigestSha256 signature type.
  */
 class DigestKey : public PrivateKey, public PublicKey
 {
 public:
+  DigestKey();
+
+  ~DigestKey();
+
   size_t
   getMaxSigLength() const final
   {
@@ -25,6 +33,27 @@ public:
 
   bool
   verify(const uint8_t* input, size_t inputLen, const uint8_t* sig, size_t sigLen) const final;
+
+  bool
+  beginSign() const final;
+
+  void
+  updateSign(const uint8_t* input, size_t inputLen) const final;
+
+  int
+  finishSign(uint8_t* sig) const final;
+
+  bool
+  beginVerify() const final;
+
+  void
+  updateVerify(const uint8_t* input, size_t inputLen) const final;
+
+  bool
+  finishVerify(const uint8_t* sig, size_t sigLen) const final;
+
+private:
+  mutable std::unique_ptr<detail::Sha256Impl> m_stream;
 };
 
 } // namespace ndn
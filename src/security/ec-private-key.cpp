@@ -1,10 +1,47 @@
 #include "ec-private-key.hpp"
 #include "ec-public-key.hpp"
 #include "detail/ec-impl.hpp"
+#include "detail/sha256-impl.hpp"
+#include "../core/clock.hpp"
 #include "../ndn-cpp/lite/util/crypto-lite.hpp"
 
+#include <cstring>
+
 namespace ndn {
 
+/** \brief storage of precomputed nonces
+ *
+ *  Each entry is r followed by 1/k, as produced by EcPrivateKeyImpl::precomputeNonce().
+ *  Entries are used in LIFO order, and erased after use.
+ */
+class EcPrivateKey::NoncePool
+{
+public:
+  static constexpr size_t ENTRY_SIZE = 64;
+
+  explicit
+  NoncePool(uint16_t capacity)
+    : entries(new uint8_t[capacity * ENTRY_SIZE])
+  {
+    cnt.capacity = capacity;
+  }
+
+  ~NoncePool()
+  {
+    std::memset(entries.get(), 0, cnt.capacity * ENTRY_SIZE);
+  }
+
+  uint8_t*
+  at(uint16_t i)
+  {
+    return &entries[i * ENTRY_SIZE];
+  }
+
+public:
+  std::unique_ptr<uint8_t[]> entries;
+  NoncePoolCounters cnt;
+};
+
 EcPrivateKey::EcPrivateKey(const NameLite& keyName)
   : m_keyName(keyName)
 {
@@ -33,9 +70,97 @@ EcPrivateKey::sign(const uint8_t* input, size_t inputLen, uint8_t* sig) const
   }
   uint8_t hash[ndn_SHA256_DIGEST_SIZE];
   CryptoLite::digestSha256(input, inputLen, hash);
+  return this->signHash(hash, sig);
+}
+
+bool
+EcPrivateKey::beginSign() const
+{
+  if (!m_impl) {
+    return false;
+  }
+  if (m_stream == nullptr) {
+    m_stream.reset(new detail::Sha256Impl());
+  }
+  m_stream->begin();
+  return true;
+}
+
+void
+EcPrivateKey::updateSign(const uint8_t* input, size_t inputLen) const
+{
+  if (m_stream != nullptr) {
+    m_stream->update(input, inputLen);
+  }
+}
+
+int
+EcPrivateKey::finishSign(uint8_t* sig) const
+{
+  if (!m_impl || m_stream == nullptr) {
+    return 0;
+  }
+  uint8_t hash[ndn_SHA256_DIGEST_SIZE];
+  m_stream->finish(hash);
+  return this->signHash(hash, sig);
+}
+
+int
+EcPrivateKey::signHash(const uint8_t* hash, uint8_t* sig) const
+{
+  if (m_pool != nullptr) {
+    NoncePoolCounters& cnt = m_pool->cnt;
+    if (cnt.depth > 0) {
+      uint8_t* nonce = m_pool->at(--cnt.depth);
+      int sigLen = m_impl->signWithNonce(hash, nonce, sig);
+      std::memset(nonce, 0, NoncePool::ENTRY_SIZE);
+      if (sigLen > 0) {
+        ++cnt.nHits;
+        return sigLen;
+      }
+    }
+    ++cnt.nMisses;
+  }
   return m_impl->sign(hash, sig);
 }
 
+bool
+EcPrivateKey::enableNoncePool(uint16_t capacity)
+{
+  if (capacity == 0) {
+    m_pool.reset();
+    return true;
+  }
+  if (!Impl::CAN_PRECOMPUTE_NONCE) {
+    return false;
+  }
+  m_pool.reset(new NoncePool(capacity));
+  return true;
+}
+
+bool
+EcPrivateKey::precompute() const
+{
+  if (m_pool == nullptr || m_pool->cnt.depth >= m_pool->cnt.capacity) {
+    return false;
+  }
+  NoncePoolCounters& cnt = m_pool->cnt;
+  unsigned long t0 = getClock().getMicros();
+  if (!Impl::precomputeNonce(m_pool->at(cnt.depth))) {
+    return false;
+  }
+  cnt.refillMicros += getClock().getMicros() - t0;
+  ++cnt.nRefills;
+  ++cnt.depth;
+  return true;
+}
+
+EcPrivateKey::NoncePoolCounters
+EcPrivateKey::getNoncePoolCounters() const
+{
+  return m_pool == nullptr ? NoncePoolCounters() : m_pool->cnt;
+}
+
 ndn_Error
 EcPrivateKey::setSignatureInfo(SignatureLite& signature) const
 {
@@ -8,6 +8,7 @@ namespace ndn {
 class EcPublicKey;
 namespace detail {
 class EcPrivateKeyImpl;
+class Sha256Impl;
 } // namespace detail
 
 /** \brief Holds an EC private key (curve secp256r1) for SignatureSha256WithEcdsa signature type.
@@ -37,6 +38,52 @@ public:
   bool
   generate(EcPublicKey& pub);
 
+  /** \brief Counters of the nonce pool.
+   */
+  class NoncePoolCounters
+  {
+  public:
+    /** \brief average time to compute one entry, in micros
+     */
+    float
+    getAvgRefillMicros() const
+    {
+      return nRefills == 0 ? 0.0 : static_cast<float>(refillMicros) / nRefills;
+    }
+
+  public:
+    uint16_t capacity = 0;     ///< max entries, zero if pool is disabled
+    uint16_t depth = 0;        ///< available entries
+    uint32_t nRefills = 0;     ///< entries computed
+    uint32_t refillMicros = 0; ///< total time spent computing entries
+    uint32_t nHits = 0;        ///< signatures made with an entry
+    uint32_t nMisses = 0;      ///< signatures made on the full path
+  };
+
+  /** \brief Enable or disable the pool of precomputed ECDSA nonces.
+   *  \param capacity max entries, each occupies 64 octets; zero disables the pool
+   *  \return whether success; false if the crypto backend cannot precompute nonces
+   *
+   *  Most of ECDSA signing cost is computing r from a random nonce k, which does not depend
+   *  on the message. With the pool, precompute() computes (r, 1/k) in idle time, so that
+   *  sign() needs only a few modular multiplications. Each entry is erased after one use.
+   *  sign() falls back to the full computation when the pool is empty.
+   *
+   *  Face::loop() refills the pool of its default signing key, one entry per idle loop.
+   *  Otherwise, call precompute() periodically from the same thread as sign().
+   *  Currently, only the micro-ecc backend (nRF52 and host) supports the pool.
+   */
+  bool
+  enableNoncePool(uint16_t capacity);
+
+  /** \brief Compute one nonce pool entry, if the pool is enabled and not full.
+   */
+  bool
+  precompute() const final;
+
+  NoncePoolCounters
+  getNoncePoolCounters() const;
+
   size_t
   getMaxSigLength() const final
   {
@@ -46,15 +93,31 @@ public:
   int
   sign(const uint8_t* input, size_t inputLen, uint8_t* sig) const final;
 
+  bool
+  beginSign() const final;
+
+  void
+  updateSign(const uint8_t* input, size_t inputLen) const final;
+
+  int
+  finishSign(uint8_t* sig) const final;
+
   ndn_Error
   setSignatureInfo(SignatureLite& signature) const final;
 
 public:
   static constexpr size_t MAX_SIG_LENGTH = 72;
 
+private:
+  int
+  signHash(const uint8_t* hash, uint8_t* sig) const;
+
 private:
   using Impl = detail::EcPrivateKeyImpl;
   std::unique_ptr<Impl> m_impl;
+  mutable std::unique_ptr<detail::Sha256Impl> m_stream;
+  class NoncePool;
+  std::unique_ptr<NoncePool> m_pool;
   const NameLite& m_keyName;
 };
 
@@ -1,5 +1,6 @@
 #include "ec-public-key.hpp"
 #include "detail/ec-impl.hpp"
+#include "detail/sha256-impl.hpp"
 #include "../ndn-cpp/lite/util/crypto-lite.hpp"
 
 #include <algorithm>
@@ -67,4 +68,36 @@ EcPublicKey::verify(const uint8_t* input, size_t inputLen, const uint8_t* sig, s
   return m_impl->verify(hash, sig, sigLen);
 }
 
+bool
+EcPublicKey::beginVerify() const
+{
+  if (!m_impl) {
+    return false;
+  }
+  if (m_stream == nullptr) {
+    m_stream.reset(new detail::Sha256Impl());
+  }
+  m_stream->begin();
+  return true;
+}
+
+void
+EcPublicKey::updateVerify(const uint8_t* input, size_t inputLen) const
+{
+  if (m_stream != nullptr) {
+    m_stream->update(input, inputLen);
+  }
+}
+
+bool
+EcPublicKey::finishVerify(const uint8_t* sig, size_t sigLen) const
+{
+  if (!m_impl || m_stream == nullptr) {
+    return false;
+  }
+  uint8_t hash[ndn_SHA256_DIGEST_SIZE];
+  m_stream->finish(hash);
+  return m_impl->verify(hash, sig, sigLen);
+}
+
 } // namespace ndn
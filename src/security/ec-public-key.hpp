@@ -8,6 +8,7 @@
 namespace ndn {
 namespace detail {
 class EcPublicKeyImpl;
+class Sha256Impl;
 } // namespace detail
 
 /** \brief Holds an EC public key (curve secp256r1) for SignatureSha256WithEcdsa signature type.
@@ -35,9 +36,19 @@ public:
   bool
   verify(const uint8_t* input, size_t inputLen, const uint8_t* sig, size_t sigLen) const final;
 
+  bool
+  beginVerify() const final;
+
+  void
+  updateVerify(const uint8_t* input, size_t inputLen) const final;
+
+  bool
+  finishVerify(const uint8_t* sig, size_t sigLen) const final;
+
 private:
   using Impl = detail::EcPublicKeyImpl;
   std::unique_ptr<Impl> m_impl;
+  mutable std::unique_ptr<detail::Sha256Impl> m_stream;
 };
 
 } // namespace ndn
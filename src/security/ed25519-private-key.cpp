@@ -0,0 +1,69 @@
+#include "ed25519-private-key.hpp"
+#include "ed25519-public-key.hpp"
+#include "detail/ed25519.h"
+#include "../ndn-cpp/lite/util/crypto-lite.hpp"
+
+#include <cstring>
+
+#ifdef ARDUINO_ARCH_NRF52
+#include <avr/pgmspace.h>
+#else
+#include <pgmspace.h>
+#endif
+
+namespace ndn {
+
+Ed25519PrivateKey::Ed25519PrivateKey(const NameLite& keyName)
+  : m_hasKey(false)
+  , m_keyName(keyName)
+{
+}
+
+Ed25519PrivateKey::~Ed25519PrivateKey()
+{
+  std::memset(m_expanded, 0, sizeof(m_expanded));
+}
+
+bool
+Ed25519PrivateKey::import(const uint8_t seed[32])
+{
+  uint8_t bits[ED25519_SEED_SIZE];
+  memcpy_P(bits, seed, sizeof(bits));
+  ed25519_expand_key(m_expanded, m_pub, bits);
+  std::memset(bits, 0, sizeof(bits));
+  m_hasKey = true;
+  return true;
+}
+
+bool
+Ed25519PrivateKey::generate(Ed25519PublicKey& pub)
+{
+  uint8_t seed[ED25519_SEED_SIZE];
+  if (CryptoLite::generateRandomBytes(seed, sizeof(seed)) != NDN_ERROR_success) {
+    return false;
+  }
+  this->import(seed);
+  std::memset(seed, 0, sizeof(seed));
+  return pub.import(m_pub);
+}
+
+int
+Ed25519PrivateKey::sign(const uint8_t* input, size_t inputLen, uint8_t* sig) const
+{
+  if (!m_hasKey) {
+    return 0;
+  }
+  ed25519_sign(sig, input, inputLen, m_expanded, m_pub);
+  return ED25519_SIGNATURE_SIZE;
+}
+
+ndn_Error
+Ed25519PrivateKey::setSignatureInfo(SignatureLite& signature) const
+{
+  signature.setType(ndn_SignatureType_Ed25519Signature);
+  KeyLocatorLite& kl = signature.getKeyLocator();
+  kl.setType(ndn_KeyLocatorType_KEYNAME);
+  return kl.setKeyName(m_keyName);
+}
+
+} // namespace ndn
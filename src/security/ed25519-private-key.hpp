@@ -0,0 +1,65 @@
+#ifndef ESP8266NDN_ED25519_PRIVATE_KEY_HPP
+#define ESP8266NDN_ED25519_PRIVATE_KEY_HPP
+
+#include "private-key.hpp"
+
+namespace ndn {
+class Ed25519PublicKey;
+
+/** \brief Holds an Ed25519 private key for SignatureEd25519 signature type.
+ *
+ *  Compared to EcPrivateKey, signing and verification are several times faster on 32-bit
+ *  microcontrollers, signatures are fixed-length 64 octets, and signing is deterministic so that
+ *  it does not consume random numbers.
+ *  It cannot sign incrementally, because Ed25519 hashes the signed portion twice.
+ */
+class Ed25519PrivateKey : public PrivateKey
+{
+public:
+  /** \brief Constructor.
+   *  \param keyName certificate name; caller must retain memory and may modify later
+   */
+  explicit
+  Ed25519PrivateKey(const NameLite& keyName);
+
+  ~Ed25519PrivateKey();
+
+  /** \brief Import key bits.
+   *  \param seed 32-octet private key as in RFC 8032;
+   *              may come from PROGMEM, will be copied
+   */
+  bool
+  import(const uint8_t seed[32]);
+
+  /** \brief Generate key pair.
+   *
+   *  Updates this and \p pub with private and public key bits.
+   */
+  bool
+  generate(Ed25519PublicKey& pub);
+
+  size_t
+  getMaxSigLength() const final
+  {
+    return SIG_LENGTH;
+  }
+
+  int
+  sign(const uint8_t* input, size_t inputLen, uint8_t* sig) const final;
+
+  ndn_Error
+  setSignatureInfo(SignatureLite& signature) const final;
+
+public:
+  static constexpr size_t SIG_LENGTH = 64;
+
+private:
+  uint8_t m_expanded[64]; ///< secret scalar and nonce prefix
+  uint8_t m_pub[32];
+  bool m_hasKey;
+  const NameLite& m_keyName;
+};
+
+} // namespace ndn
+
+#endif // ESP8266NDN_ED25519_PRIVATE_KEY_HPP
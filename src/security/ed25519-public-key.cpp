@@ -0,0 +1,38 @@
+#include "ed25519-public-key.hpp"
+#include "detail/ed25519.h"
+
+#include <cstring>
+
+#ifdef ARDUINO_ARCH_NRF52
+#include <avr/pgmspace.h>
+#else
+#include <pgmspace.h>
+#endif
+
+namespace ndn {
+
+Ed25519PublicKey::Ed25519PublicKey()
+  : m_hasKey(false)
+{
+}
+
+Ed25519PublicKey::~Ed25519PublicKey() = default;
+
+bool
+Ed25519PublicKey::import(const uint8_t bits[32])
+{
+  memcpy_P(m_bits, bits, sizeof(m_bits));
+  m_hasKey = true;
+  return true;
+}
+
+bool
+Ed25519PublicKey::verify(const uint8_t* input, size_t inputLen, const uint8_t* sig, size_t sigLen) const
+{
+  if (!m_hasKey || sigLen != ED25519_SIGNATURE_SIZE) {
+    return false;
+  }
+  return ed25519_verify(sig, input, inputLen, m_bits) == 1;
+}
+
+} // namespace ndn
@@ -0,0 +1,35 @@
+#ifndef ESP8266NDN_ED25519_PUBLIC_KEY_HPP
+#define ESP8266NDN_ED25519_PUBLIC_KEY_HPP
+
+#include "public-key.hpp"
+
+namespace ndn {
+
+/** \brief Holds an Ed25519 public key for SignatureEd25519 signature type.
+ *
+ *  It cannot verify incrementally, because the hash covers the signature before the signed portion.
+ */
+class Ed25519PublicKey : public PublicKey
+{
+public:
+  Ed25519PublicKey();
+
+  ~Ed25519PublicKey();
+
+  /** \brief Import key bits.
+   *  \param bits encoded point as in RFC 8032; may come from PROGMEM, will be copied
+   */
+  bool
+  import(const uint8_t bits[32]);
+
+  bool
+  verify(const uint8_t* input, size_t inputLen, const uint8_t* sig, size_t sigLen) const final;
+
+private:
+  uint8_t m_bits[32];
+  bool m_hasKey;
+};
+
+} // namespace ndn
+
+#endif // ESP8266NDN_ED25519_PUBLIC_KEY_HPP
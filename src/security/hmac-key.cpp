@@ -42,4 +42,48 @@ HmacKey::verify(const uint8_t* input, size_t inputLen, const uint8_t* sig, size_
   return compareDigest(sig, newSig, ndn_SHA256_DIGEST_SIZE);
 }
 
+bool
+HmacKey::beginSign() const
+{
+  m_impl->begin();
+  return true;
+}
+
+void
+HmacKey::updateSign(const uint8_t* input, size_t inputLen) const
+{
+  m_impl->update(input, inputLen);
+}
+
+int
+HmacKey::finishSign(uint8_t* sig) const
+{
+  m_impl->finish(sig);
+  return ndn_SHA256_DIGEST_SIZE;
+}
+
+bool
+HmacKey::beginVerify() const
+{
+  return this->beginSign();
+}
+
+void
+HmacKey::updateVerify(const uint8_t* input, size_t inputLen) const
+{
+  this->updateSign(input, inputLen);
+}
+
+bool
+HmacKey::finishVerify(const uint8_t* sig, size_t sigLen) const
+{
+  if (sigLen != ndn_SHA256_DIGEST_SIZE) {
+    return false;
+  }
+
+  uint8_t newSig[ndn_SHA256_DIGEST_SIZE];
+  m_impl->finish(newSig);
+  return compareDigest(sig, newSig, ndn_SHA256_DIGEST_SIZE);
+}
+
 } // namespace ndn
@@ -38,6 +38,24 @@ public:
   bool
   verify(const uint8_t* input, size_t inputLen, const uint8_t* sig, size_t sigLen) const final;
 
+  bool
+  beginSign() const final;
+
+  void
+  updateSign(const uint8_t* input, size_t inputLen) const final;
+
+  int
+  finishSign(uint8_t* sig) const final;
+
+  bool
+  beginVerify() const final;
+
+  void
+  updateVerify(const uint8_t* input, size_t inputLen) const final;
+
+  bool
+  finishVerify(const uint8_t* sig, size_t sigLen) const final;
+
 private:
   using Impl = detail::HmacImpl;
   std::unique_ptr<Impl> m_impl;
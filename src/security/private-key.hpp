@@ -28,11 +28,57 @@ public:
   virtual int
   sign(const uint8_t* input, size_t inputLen, uint8_t* sig) const = 0;
 
+  /** \brief Start signing incrementally.
+   *  \return whether success; false if this key cannot sign incrementally
+   *
+   *  Pass the signed portion to \p updateSign(), in one or more segments, and then invoke
+   *  \p finishSign(). This allows signing while a packet is being encoded, or when the signed
+   *  portion is not contiguous in memory.
+   *  The key holds the state of one incremental operation. Invoking \p beginSign() again, or
+   *  \p PublicKey::beginVerify() on a key that can also verify, abandons the unfinished one.
+   *  Do not invoke \p sign() on the same key before \p finishSign(): some keys, such as
+   *  HmacKey, share state between one-shot and incremental signing.
+   */
+  virtual bool
+  beginSign() const
+  {
+    return false;
+  }
+
+  /** \brief Append a segment of signed portion, after \p beginSign().
+   */
+  virtual void
+  updateSign(const uint8_t* input, size_t inputLen) const
+  {
+  }
+
+  /** \brief Complete incremental signing.
+   *  \param[out] sig signature bits, must have space for \p getMaxSigLength()
+   *  \return length of signature bits
+   *  \retval 0 error
+   */
+  virtual int
+  finishSign(uint8_t* sig) const
+  {
+    return 0;
+  }
+
   /** \brief Provide SignatureType and KeyLocator.
    *  \param signature receiving SignatureInfo element
    */
   virtual ndn_Error
   setSignatureInfo(SignatureLite& signature) const = 0;
+
+  /** \brief Perform message-independent work ahead of time to speed up subsequent sign().
+   *  \return whether any work was done; false if there is nothing to precompute
+   *
+   *  Face::loop() invokes this on the default signing key when no packet is pending.
+   */
+  virtual bool
+  precompute() const
+  {
+    return false;
+  }
 };
 
 } // namespace ndn
@@ -22,6 +22,40 @@ public:
    */
   virtual bool
   verify(const uint8_t* input, size_t inputLen, const uint8_t* sig, size_t sigLen) const = 0;
+
+  /** \brief Start verifying incrementally.
+   *  \return whether success; false if this key cannot verify incrementally
+   *
+   *  Pass the signed portion to \p updateVerify(), in one or more segments, and then invoke
+   *  \p finishVerify(). This allows verifying while a packet is being decoded, or when the signed
+   *  portion is not contiguous in memory.
+   *  The key holds the state of one incremental operation. Invoking \p beginVerify() again, or
+   *  \p PrivateKey::beginSign() on a key that can also sign, abandons the unfinished one.
+   *  Do not invoke \p verify() on the same key before \p finishVerify(): some keys, such as
+   *  HmacKey, share state between one-shot and incremental verification.
+   */
+  virtual bool
+  beginVerify() const
+  {
+    return false;
+  }
+
+  /** \brief Append a segment of signed portion, after \p beginVerify().
+   */
+  virtual void
+  updateVerify(const uint8_t* input, size_t inputLen) const
+  {
+  }
+
+  /** \brief Complete incremental verification.
+   *  \param sig signature bits
+   *  \param sigLen length of signature bits
+   */
+  virtual bool
+  finishVerify(const uint8_t* sig, size_t sigLen) const
+  {
+    return false;
+  }
 };
 
 } // namespace ndn
@@ -54,4 +54,19 @@ BleClientTransport::send(const uint8_t* pkt, size_t len, uint64_t endpointId)
          NDN_ERROR_SocketTransport_socket_is_not_open;
 }
 
+size_t
+BleClientTransport::getMtu() const
+{
+  return m_impl == nullptr ? 0 : m_impl->getMtu();
+}
+
+BleClientTransport::Counters
+BleClientTransport::getCounters() const
+{
+  if (m_impl == nullptr) {
+    return Counters();
+  }
+  return m_impl->getRxCounters();
+}
+
 } // namespace ndn
@@ -2,6 +2,7 @@
 #define ESP8266NDN_BLE_CLIENT_TRANSPORT_HPP
 
 #include "transport.hpp"
+#include "detail/ble-rx-ring.hpp"
 #include <memory>
 
 namespace ndn {
@@ -14,6 +15,13 @@ class BleClientImpl;
 class BleClientTransport : public Transport
 {
 public:
+  /** \brief RX ring counters
+   *
+   *  Received frames are queued in a ring of BLE_RX_RING_SLOTS slots until Face::loop() drains
+   *  them, so that a burst of packets is not overwritten.
+   */
+  typedef detail::BleRxRing::Counters Counters;
+
   BleClientTransport();
 
   ~BleClientTransport();
@@ -27,6 +35,16 @@ public:
   ndn_Error
   send(const uint8_t* pkt, size_t len, uint64_t endpointId) final;
 
+  /** \brief get negotiated ATT payload size
+   *
+   *  Wrap the transport in BleLink to send larger packets and batch smaller packets.
+   */
+  size_t
+  getMtu() const final;
+
+  Counters
+  getCounters() const;
+
 private:
   std::unique_ptr<detail::BleClientImpl> m_impl;
 };
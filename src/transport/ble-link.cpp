@@ -0,0 +1,73 @@
+#include "ble-link.hpp"
+#include "../core/logger.hpp"
+
+#include <cstring>
+
+#define BLELINK_DBG(...) DBG(BleLink, __VA_ARGS__)
+
+namespace ndn {
+
+static Bundler::Options
+makeBundlerOptions(const BleLink::Options& options)
+{
+  Bundler::Options opts;
+  opts.maxFrameSize = options.maxFrameSize;
+  opts.maxDelay = 0;
+  return opts;
+}
+
+BleLink::BleLink(Transport& inner)
+  : BleLink(inner, Options())
+{
+}
+
+BleLink::BleLink(Transport& inner, const Options& options)
+  : Bundler(inner, makeBundlerOptions(options))
+  , m_rxBuf(new uint8_t[options.maxFrameSize])
+  , m_rxEndpoint(0)
+  , m_rxBufSize(options.maxFrameSize)
+  , m_rxLen(0)
+  , m_rxPos(0)
+{
+}
+
+BleLink::~BleLink() = default;
+
+size_t
+BleLink::receive(uint8_t* buf, size_t bufSize, uint64_t& endpointId)
+{
+  flush();
+
+  while (true) {
+    if (m_rxPos >= m_rxLen) {
+      m_rxPos = 0;
+      m_rxLen = inner.receive(m_rxBuf.get(), m_rxBufSize, m_rxEndpoint);
+      if (m_rxLen == 0) {
+        return 0;
+      }
+      ++m_rxCnt.nRxFrames;
+    }
+
+    const uint8_t* element = &m_rxBuf[m_rxPos];
+    size_t len = getPacketLength(element, m_rxLen - m_rxPos);
+    if (len == 0) {
+      ++m_rxCnt.nRxErrors;
+      BLELINK_DBG(F("bad TLV at ") << m_rxPos << '/' << m_rxLen);
+      m_rxPos = m_rxLen;
+      continue;
+    }
+
+    m_rxPos += len;
+    if (len > bufSize) {
+      ++m_rxCnt.nRxErrors;
+      BLELINK_DBG(F("drop oversized len=") << len);
+      continue;
+    }
+    std::memcpy(buf, element, len);
+    endpointId = m_rxEndpoint;
+    ++m_rxCnt.nRxPkts;
+    return len;
+  }
+}
+
+} // namespace ndn
@@ -0,0 +1,72 @@
+#ifndef ESP8266NDN_BLE_LINK_HPP
+#define ESP8266NDN_BLE_LINK_HPP
+
+#include "bundler.hpp"
+
+#include <memory>
+
+namespace ndn {
+
+/** \brief a transport wrapper that packs several packets into each BLE notification
+ *
+ *  Each notification or write on a BLE characteristic costs a slot in a connection event,
+ *  regardless of its size. BleLink is a Bundler whose frame size defaults to the max ATT
+ *  attribute length, capped by the negotiated ATT payload size as reported by inner.getMtu().
+ *  It has no time limit: the pending frame is sent when the next packet does not fit, when it is
+ *  addressed to another endpoint, in receive(), or in flush().
+ *  Received frames are split into their packets, so that a peer may or may not batch.
+ *
+ *  A frame is a bare concatenation of TLV elements, not an NDNLPv2 LpPacket: NDNLPv2 has no field
+ *  to carry several network layer packets in one LpPacket, each element is self-delimiting, and
+ *  fragments and Nacks are already LpPackets that appear as elements within a frame.
+ *
+ *  getMtu() returns the frame size, so that Face sends a larger packet as NDNLPv2 fragments,
+ *  which are batched like other packets. The peer should enable Face reassembly.
+ */
+class BleLink : public Bundler
+{
+public:
+  class Options
+  {
+  public:
+    uint16_t maxFrameSize = 512; ///< max frame size, limited by max ATT attribute length
+  };
+
+  class RxCounters
+  {
+  public:
+    uint32_t nRxFrames = 0;  ///< frames received
+    uint32_t nRxPkts = 0;    ///< packets received
+    uint32_t nRxErrors = 0;  ///< frames with bad TLV, or packets exceeding receive buffer
+  };
+
+  explicit
+  BleLink(Transport& inner);
+
+  BleLink(Transport& inner, const Options& options);
+
+  ~BleLink();
+
+  /** \brief send pending frame, then receive the next packet from current or next frame
+   */
+  size_t
+  receive(uint8_t* buf, size_t bufSize, uint64_t& endpointId) final;
+
+  const RxCounters&
+  getRxCounters() const
+  {
+    return m_rxCnt;
+  }
+
+private:
+  std::unique_ptr<uint8_t[]> m_rxBuf;
+  uint64_t m_rxEndpoint;
+  uint16_t m_rxBufSize;
+  uint16_t m_rxLen;
+  uint16_t m_rxPos;
+  RxCounters m_rxCnt;
+};
+
+} // namespace ndn
+
+#endif // ESP8266NDN_BLE_LINK_HPP
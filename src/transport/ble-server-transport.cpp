@@ -56,4 +56,19 @@ BleServerTransport::send(const uint8_t* pkt, size_t len, uint64_t endpointId)
          NDN_ERROR_SocketTransport_socket_is_not_open;
 }
 
+size_t
+BleServerTransport::getMtu() const
+{
+  return m_impl == nullptr ? 0 : m_impl->getMtu();
+}
+
+BleServerTransport::Counters
+BleServerTransport::getCounters() const
+{
+  if (m_impl == nullptr) {
+    return Counters();
+  }
+  return m_impl->getRxCounters();
+}
+
 } // namespace ndn
@@ -0,0 +1,129 @@
+#include "bundler.hpp"
+#include "../core/clock.hpp"
+#include "../core/logger.hpp"
+#include "../ndn-cpp/c/encoding/tlv/tlv-decoder.h"
+
+#include <algorithm>
+#include <cstring>
+
+#define BUNDLER_DBG(...) DBG(Bundler, __VA_ARGS__)
+
+namespace ndn {
+
+Bundler::Bundler(Transport& inner)
+  : Bundler(inner, Options())
+{
+}
+
+Bundler::Bundler(Transport& inner, const Options& options)
+  : inner(inner)
+  , m_opts(options)
+  , m_buf(new uint8_t[options.maxFrameSize])
+  , m_endpointId(0)
+  , m_due(0)
+  , m_len(0)
+{
+}
+
+Bundler::~Bundler() = default;
+
+size_t
+Bundler::getMtu() const
+{
+  size_t mtu = inner.getMtu();
+  return mtu == 0 ? m_opts.maxFrameSize : std::min<size_t>(mtu, m_opts.maxFrameSize);
+}
+
+size_t
+Bundler::receive(uint8_t* buf, size_t bufSize, uint64_t& endpointId)
+{
+  loop();
+  return inner.receive(buf, bufSize, endpointId);
+}
+
+ndn_Error
+Bundler::send(const uint8_t* pkt, size_t len, uint64_t endpointId)
+{
+  size_t mtu = getMtu();
+  if (len > mtu) {
+    return NDN_ERROR_TLV_length_exceeds_buffer_length;
+  }
+
+  if (m_len > 0) {
+    if (endpointId != m_endpointId) {
+      sendFrame(m_cnt.nFlushOther);
+    }
+    else if (m_len + len > mtu) {
+      sendFrame(m_cnt.nFlushFull);
+    }
+  }
+  if (m_len == 0) {
+    m_due = getClock().getMicros() + m_opts.maxDelay;
+    m_endpointId = endpointId;
+  }
+  std::memcpy(&m_buf[m_len], pkt, len);
+  m_len += len;
+  ++m_cnt.nTxPkts;
+
+  if (m_len == mtu) {
+    sendFrame(m_cnt.nFlushFull);
+  }
+  else {
+    loop();
+  }
+  return NDN_ERROR_success;
+}
+
+void
+Bundler::loop()
+{
+  if (m_len > 0 && m_opts.maxDelay > 0 &&
+      static_cast<long>(getClock().getMicros() - m_due) >= 0) {
+    sendFrame(m_cnt.nFlushDelay);
+  }
+}
+
+ndn_Error
+Bundler::flush()
+{
+  if (m_len == 0) {
+    return NDN_ERROR_success;
+  }
+  return sendFrame(m_cnt.nFlushOther);
+}
+
+ndn_Error
+Bundler::sendFrame(uint32_t& reasonCounter)
+{
+  ndn_Error e = inner.send(m_buf.get(), m_len, m_endpointId);
+  m_len = 0;
+  ++m_cnt.nTxFrames;
+  ++reasonCounter;
+  if (e != NDN_ERROR_success) {
+    ++m_cnt.nTxErrors;
+    BUNDLER_DBG(F("send err=") << e);
+  }
+  return e;
+}
+
+size_t
+Bundler::getPacketLength(const uint8_t* frame, size_t len)
+{
+  ndn_TlvDecoder decoder;
+  ndn_TlvDecoder_initialize(&decoder, frame, len);
+  uint64_t type, length;
+  if (ndn_TlvDecoder_readVarNumber(&decoder, &type) ||
+      ndn_TlvDecoder_readVarNumber(&decoder, &length) ||
+      length > len - decoder.offset) {
+    return 0;
+  }
+  switch (type) {
+    case ndn_Tlv_Interest:
+    case ndn_Tlv_Data:
+    case ndn_Tlv_LpPacket_LpPacket:
+      return decoder.offset + length;
+  }
+  return 0;
+}
+
+} // namespace ndn
@@ -0,0 +1,124 @@
+#ifndef ESP8266NDN_BUNDLER_HPP
+#define ESP8266NDN_BUNDLER_HPP
+
+#include "transport.hpp"
+
+#include <memory>
+
+namespace ndn {
+
+/** \brief a transport wrapper that bundles several small packets into one link frame
+ *
+ *  Each UDP datagram, Ethernet frame, or LoRa transmission has a fixed per-frame overhead.
+ *  Bundler appends outgoing packets to a frame of up to getMtu() octets, and sends the frame
+ *  when the next packet does not fit or is addressed to another endpoint, when the oldest packet
+ *  has waited for \c Options::maxDelay, or in flush(). Time limits are checked in send(),
+ *  receive(), and loop(); Face::loop() invokes receive() so that it drives the timer.
+ *
+ *  A bundle is a concatenation of TLV elements. The receiving Face unbundles it in PacketBuffer,
+ *  so that the peer needs no Bundler unless it sends bundles too. Trailing octets that do not
+ *  start with an Interest, Data, or LpPacket, such as Ethernet padding, are not unbundled.
+ */
+class Bundler : public Transport
+{
+public:
+  class Options
+  {
+  public:
+    uint16_t maxFrameSize = 1450; ///< max frame size, further limited by inner MTU
+    uint32_t maxDelay = 2000;     ///< max wait for more packets, in micros; zero means no limit
+  };
+
+  class Counters
+  {
+  public:
+    /** \brief average number of packets per frame
+     */
+    float
+    getPktsPerFrame() const
+    {
+      return nTxFrames == 0 ? 0.0 : static_cast<float>(nTxPkts) / nTxFrames;
+    }
+
+  public:
+    uint32_t nTxPkts = 0;      ///< packets sent
+    uint32_t nTxFrames = 0;    ///< frames sent
+    uint32_t nTxErrors = 0;    ///< frames rejected by inner transport
+    uint32_t nFlushFull = 0;   ///< frames sent because next packet does not fit
+    uint32_t nFlushDelay = 0;  ///< frames sent because maxDelay elapsed
+    uint32_t nFlushOther = 0;  ///< frames sent due to endpoint change or flush()
+  };
+
+  explicit
+  Bundler(Transport& inner);
+
+  Bundler(Transport& inner, const Options& options);
+
+  ~Bundler();
+
+  /** \brief send pending frame if it is due, then receive from inner transport
+   */
+  size_t
+  receive(uint8_t* buf, size_t bufSize, uint64_t& endpointId) override;
+
+  /** \brief append a packet to pending frame
+   *  \retval NDN_ERROR_TLV_length_exceeds_buffer_length packet exceeds getMtu()
+   *
+   *  An error in sending a previous frame is counted in \c Counters::nTxErrors.
+   */
+  ndn_Error
+  send(const uint8_t* pkt, size_t len, uint64_t endpointId) final;
+
+  /** \brief send pending frame if it is due
+   */
+  void
+  loop();
+
+  /** \brief send pending frame
+   */
+  ndn_Error
+  flush();
+
+  /** \brief get frame size, which is inner MTU capped by \c Options::maxFrameSize
+   */
+  size_t
+  getMtu() const final;
+
+  bool
+  isTxReady() final
+  {
+    return inner.isTxReady();
+  }
+
+  const Counters&
+  getCounters() const
+  {
+    return m_cnt;
+  }
+
+  /** \brief determine length of the first packet in a received frame
+   *  \return TLV length of the first element if it is a complete Interest, Data, or LpPacket;
+   *          otherwise zero
+   */
+  static size_t
+  getPacketLength(const uint8_t* frame, size_t len);
+
+public:
+  Transport& inner;
+
+private:
+  ndn_Error
+  sendFrame(uint32_t& reasonCounter);
+
+private:
+  Options m_opts;
+  std::unique_ptr<uint8_t[]> m_buf;
+  uint64_t m_endpointId;
+  unsigned long m_due; ///< when pending frame must be sent, in micros
+  uint16_t m_len;
+  Counters m_cnt;
+};
+
+} // namespace ndn
+
+#endif // ESP8266NDN_BUNDLER_HPP
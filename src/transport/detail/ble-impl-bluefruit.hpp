@@ -1,6 +1,7 @@
 #ifndef ESP8266NDN_BLE_IMPL_BLUEFRUIT_HPP
 #define ESP8266NDN_BLE_IMPL_BLUEFRUIT_HPP
 
+#include "ble-rx-ring.hpp"
 #include "ble-uuid.hpp"
 #include <bluefruit.h>
 #include "../../core/detail/fix-maxmin.hpp"
@@ -67,6 +68,7 @@ public:
     m_rx.setPermission(SECMODE_OPEN, SECMODE_OPEN);
     m_rx.setMaxLen(mtu);
     m_rx.setUserDescriptor("NDN-RX");
+    m_rx.setWriteCallback(&BleServiceImpl::rxWrite);
     VERIFY_STATUS(m_rx.begin(), __LINE__);
 
     m_tx.setProperties(CHR_PROPS_READ | CHR_PROPS_NOTIFY);
@@ -93,9 +95,7 @@ public:
   size_t
   receive(uint8_t* buf, size_t bufSize)
   {
-    uint16_t len = m_rx.read(buf, bufSize);
-    m_rx.write("", 0);
-    return len;
+    return m_rxRing.pop(buf, bufSize);
   }
 
   bool
@@ -106,9 +106,36 @@ public:
     return true;
   }
 
+  /** \brief get negotiated ATT payload size
+   */
+  size_t
+  getMtu() const
+  {
+    BLEConnection* conn = Bluefruit.Connection(Bluefruit.connHandle());
+    if (conn == nullptr) {
+      return BleAtt_DEFAULT_MTU - BleAtt_HDR_SIZE;
+    }
+    return conn->getMtu() - BleAtt_HDR_SIZE;
+  }
+
+  BleRxRing::Counters
+  getRxCounters() const
+  {
+    return m_rxRing.getCounters();
+  }
+
+private:
+  static void
+  rxWrite(uint16_t connHdl, BLECharacteristic* chr, uint8_t* data, uint16_t len)
+  {
+    auto& self = static_cast<BleServiceImpl&>(chr->parentService());
+    self.m_rxRing.push(data, len);
+  }
+
 private:
   BLECharacteristic m_rx;
   BLECharacteristic m_tx;
+  BleRxRing m_rxRing;
 };
 
 class BleClientImpl
@@ -131,6 +158,18 @@ public:
   {
     return false;
   }
+
+  size_t
+  getMtu() const
+  {
+    return 0;
+  }
+
+  BleRxRing::Counters
+  getRxCounters() const
+  {
+    return {};
+  }
 };
 
 } // namespace detail
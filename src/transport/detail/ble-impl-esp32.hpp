@@ -1,8 +1,10 @@
 #ifndef ESP8266NDN_BLE_IMPL_ESP32_HPP
 #define ESP8266NDN_BLE_IMPL_ESP32_HPP
 
+#include "ble-rx-ring.hpp"
 #include "ble-uuid.hpp"
 #include <BLEDevice.h>
+#include <algorithm>
 #include <WString.h>
 
 #define BLEUUID_FROM_ARRAY(array) \
@@ -49,7 +51,7 @@ private:
 
 extern BleDeviceImplClass BleDeviceImpl;
 
-class BleServiceImpl
+class BleServiceImpl : public BLECharacteristicCallbacks
 {
 public:
   int
@@ -61,6 +63,7 @@ public:
            BLECharacteristic::PROPERTY_WRITE | BLECharacteristic::PROPERTY_NOTIFY);
     m_tx = m_svc->createCharacteristic(BLEUUID_FROM_ARRAY(BLE_UUID_TX),
            BLECharacteristic::PROPERTY_READ | BLECharacteristic::PROPERTY_NOTIFY);
+    m_rx->setCallbacks(this);
     m_svc->start();
     return 0;
   }
@@ -75,17 +78,7 @@ public:
   size_t
   receive(uint8_t* buf, size_t bufSize)
   {
-    std::string value = m_rx->getValue();
-    if (value.empty()) {
-      return 0;
-    }
-    m_rx->setValue(buf, 0);
-
-    if (value.size() > bufSize) {
-      return 0;
-    }
-    memcpy(buf, value.data(), value.size());
-    return value.size();
+    return m_rxRing.pop(buf, bufSize);
   }
 
   bool
@@ -96,11 +89,35 @@ public:
     return true;
   }
 
+  /** \brief get negotiated ATT payload size
+   */
+  size_t
+  getMtu() const
+  {
+    uint16_t mtu = m_server->getPeerMTU(m_server->getConnId());
+    return std::max<uint16_t>(mtu, BleAtt_DEFAULT_MTU) - BleAtt_HDR_SIZE;
+  }
+
+  BleRxRing::Counters
+  getRxCounters() const
+  {
+    return m_rxRing.getCounters();
+  }
+
+private:
+  void
+  onWrite(BLECharacteristic* ch) override
+  {
+    std::string value = ch->getValue();
+    m_rxRing.push(reinterpret_cast<const uint8_t*>(value.data()), value.size());
+  }
+
 private:
   BLEServer* m_server = nullptr;
   BLEService* m_svc = nullptr;
   BLECharacteristic* m_rx = nullptr;
   BLECharacteristic* m_tx = nullptr;
+  BleRxRing m_rxRing;
 };
 
 class BleClientImpl
@@ -135,10 +152,7 @@ public:
         return 0;
     }
 
-    uint16_t len = m_rxLen;
-    memcpy(buf, m_rxData, std::min<uint16_t>(bufSize, len));
-    m_rxLen = 0;
-    return len;
+    return m_rxRing.pop(buf, bufSize);
   }
 
   bool
@@ -157,6 +171,23 @@ public:
     return true;
   }
 
+  /** \brief get negotiated ATT payload size
+   */
+  size_t
+  getMtu() const
+  {
+    if (this->state != State::CONNECTED) {
+      return BleAtt_DEFAULT_MTU - BleAtt_HDR_SIZE;
+    }
+    return m_client->getMTU() - BleAtt_HDR_SIZE;
+  }
+
+  BleRxRing::Counters
+  getRxCounters() const
+  {
+    return m_rxRing.getCounters();
+  }
+
 private:
   int
   connect()
@@ -187,8 +218,7 @@ private:
     if (self == nullptr || self->m_rx != ch) {
       return;
     }
-    memcpy(self->m_rxData, data, len);
-    self->m_rxLen = len;
+    self->m_rxRing.push(data, len);
   }
 
 public:
@@ -208,8 +238,7 @@ private:
   BLERemoteService* m_svc = nullptr;
   BLERemoteCharacteristic* m_rx = nullptr;
   BLERemoteCharacteristic* m_tx = nullptr;
-  uint16_t m_rxLen = 0;
-  uint8_t m_rxData[517];
+  BleRxRing m_rxRing;
 };
 
 inline int
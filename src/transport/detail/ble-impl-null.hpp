@@ -1,6 +1,7 @@
 #ifndef ESP8266NDN_BLE_IMPL_NULL_HPP
 #define ESP8266NDN_BLE_IMPL_NULL_HPP
 
+#include "ble-rx-ring.hpp"
 #include <WString.h>
 
 namespace ndn {
@@ -50,7 +51,7 @@ public:
   size_t
   receive(uint8_t* buf, size_t bufSize)
   {
-    return 0;
+    return m_rxRing.pop(buf, bufSize);
   }
 
   bool
@@ -58,6 +59,29 @@ public:
   {
     return false;
   }
+
+  size_t
+  getMtu() const
+  {
+    return 0;
+  }
+
+  BleRxRing::Counters
+  getRxCounters() const
+  {
+    return m_rxRing.getCounters();
+  }
+
+  /** \brief emulate a frame arriving from the BLE stack, for unit testing
+   */
+  bool
+  deliver(const uint8_t* frame, size_t len)
+  {
+    return m_rxRing.push(frame, len);
+  }
+
+private:
+  BleRxRing m_rxRing;
 };
 
 class BleClientImpl
@@ -72,7 +96,7 @@ public:
   size_t
   receive(uint8_t* buf, size_t bufSize)
   {
-    return 0;
+    return m_rxRing.pop(buf, bufSize);
   }
 
   bool
@@ -80,6 +104,29 @@ public:
   {
     return false;
   }
+
+  size_t
+  getMtu() const
+  {
+    return 0;
+  }
+
+  BleRxRing::Counters
+  getRxCounters() const
+  {
+    return m_rxRing.getCounters();
+  }
+
+  /** \brief emulate a frame arriving from the BLE stack, for unit testing
+   */
+  bool
+  deliver(const uint8_t* frame, size_t len)
+  {
+    return m_rxRing.push(frame, len);
+  }
+
+private:
+  BleRxRing m_rxRing;
 };
 
 } // namespace detail
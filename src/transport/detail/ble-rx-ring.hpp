@@ -0,0 +1,28 @@
+#ifndef ESP8266NDN_BLE_RX_RING_HPP
+#define ESP8266NDN_BLE_RX_RING_HPP
+
+#include "frame-ring.hpp"
+
+namespace ndn {
+namespace detail {
+
+/** \brief number of received BLE frames that can await Face::loop()
+ */
+#ifndef BLE_RX_RING_SLOTS
+#define BLE_RX_RING_SLOTS 4
+#endif
+
+/** \brief max BLE frame size, which is the max ATT_MTU
+ */
+#define BLE_RX_RING_SLOT_SIZE 517
+
+/** \brief a bounded ring of received BLE frames
+ *
+ *  push() is invoked from a BLE stack callback, and pop() from the Arduino main loop.
+ */
+using BleRxRing = FrameRing<BLE_RX_RING_SLOTS, BLE_RX_RING_SLOT_SIZE>;
+
+} // namespace detail
+} // namespace ndn
+
+#endif // ESP8266NDN_BLE_RX_RING_HPP
@@ -16,6 +16,11 @@ static const uint8_t BLE_UUID_TX[] = { // server to client
   0xe4, 0xbd, 0x73, 0xfc, 0xb2, 0xb1, 0x5d, 0xb9, 0x61, 0x42, 0x83, 0x0d, 0x27, 0x95, 0x2f, 0x97
 }; // 972f9527-0d83-4261-b95d-b1b2fc73bde4
 
+enum {
+  BleAtt_DEFAULT_MTU = 23, ///< ATT_MTU before negotiation
+  BleAtt_HDR_SIZE = 3,     ///< ATT notification and write header size
+};
+
 } // namespace detail
 } // namespace ndn
 
@@ -0,0 +1,159 @@
+#ifndef ESP8266NDN_FRAME_RING_HPP
+#define ESP8266NDN_FRAME_RING_HPP
+
+#include "queue.hpp"
+
+#include <cstring>
+
+namespace ndn {
+namespace detail {
+
+class FrameRingBase
+{
+public:
+  class Counters
+  {
+  public:
+    uint32_t nFrames = 0;      ///< frames accepted into the ring
+    uint32_t nOverflows = 0;   ///< frames dropped because the ring is full
+    uint32_t nOversized = 0;   ///< frames dropped because they exceed slot size
+    uint32_t nBufTooSmall = 0; ///< frames dropped because they exceed receive buffer size
+  };
+};
+
+/** \brief a bounded ring of received frames
+ *  \tparam N_SLOTS number of frames that can be stored, at most 255
+ *  \tparam SLOT_SIZE max frame size
+ *
+ *  The producer side is a radio callback or interrupt handler, and the consumer side is the
+ *  Arduino main loop. Slot indices travel between the two sides in a pair of SafeQueues, so that
+ *  frame payloads are copied once on each side without locking. Each frame carries a tag, such
+ *  as link quality information.
+ */
+template<int N_SLOTS, int SLOT_SIZE>
+class FrameRing : public FrameRingBase
+{
+public:
+  static_assert(N_SLOTS > 0 && N_SLOTS < 256, "");
+
+  FrameRing()
+  {
+    for (int i = 0; i < N_SLOTS; ++i) {
+      m_free.push(i);
+    }
+  }
+
+  /** \brief store a received frame; producer side
+   *  \return whether success
+   */
+  bool
+  push(const uint8_t* frame, size_t len, uint64_t tag = 0)
+  {
+    if (len > SLOT_SIZE) {
+      ++m_cnt.nOversized;
+      return false;
+    }
+    uint8_t* room = beginPush();
+    if (room == nullptr) {
+      return false;
+    }
+    std::memcpy(room, frame, len);
+    commitPush(len, tag);
+    return true;
+  }
+
+  /** \brief acquire a slot to write a frame in place; producer side
+   *  \return slot buffer of SLOT_SIZE octets, or nullptr if the ring is full
+   *  \post if successful, commitPush() must be invoked before the next beginPush()
+   */
+  uint8_t*
+  beginPush()
+  {
+    bool ok;
+    std::tie(m_pushing, ok) = m_free.pop();
+    if (!ok) {
+      ++m_cnt.nOverflows;
+      return nullptr;
+    }
+    return m_slots[m_pushing].data;
+  }
+
+  /** \brief publish the frame written after beginPush(); producer side
+   */
+  void
+  commitPush(size_t len, uint64_t tag = 0)
+  {
+    Slot& slot = m_slots[m_pushing];
+    slot.len = len;
+    slot.tag = tag;
+    m_filled.push(m_pushing);
+    ++m_cnt.nFrames;
+  }
+
+  /** \brief retrieve the oldest frame; consumer side
+   *  \param[out] tag the frame's tag
+   *  \return frame length, or zero if the ring is empty
+   */
+  size_t
+  pop(uint8_t* buf, size_t bufSize, uint64_t& tag)
+  {
+    while (true) {
+      uint8_t i;
+      bool ok;
+      std::tie(i, ok) = m_filled.pop();
+      if (!ok) {
+        return 0;
+      }
+
+      const Slot& slot = m_slots[i];
+      size_t len = slot.len;
+      bool isFit = len <= bufSize;
+      if (isFit) {
+        std::memcpy(buf, slot.data, len);
+        tag = slot.tag;
+      }
+      else {
+        ++m_consCnt.nBufTooSmall;
+      }
+      m_free.push(i);
+      if (isFit) {
+        return len;
+      }
+    }
+  }
+
+  size_t
+  pop(uint8_t* buf, size_t bufSize)
+  {
+    uint64_t tag;
+    return pop(buf, bufSize, tag);
+  }
+
+  Counters
+  getCounters() const
+  {
+    Counters cnt = m_cnt;
+    cnt.nBufTooSmall = m_consCnt.nBufTooSmall;
+    return cnt;
+  }
+
+private:
+  struct Slot
+  {
+    uint64_t tag;
+    uint16_t len;
+    uint8_t data[SLOT_SIZE];
+  };
+
+  SafeQueue<uint8_t, N_SLOTS> m_free;   ///< consumer to producer
+  SafeQueue<uint8_t, N_SLOTS> m_filled; ///< producer to consumer
+  Slot m_slots[N_SLOTS];
+  uint8_t m_pushing = 0; ///< slot acquired by beginPush()
+  Counters m_cnt;        ///< written by producer
+  Counters m_consCnt;    ///< written by consumer
+};
+
+} // namespace detail
+} // namespace ndn
+
+#endif // ESP8266NDN_FRAME_RING_HPP
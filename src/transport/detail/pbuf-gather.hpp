@@ -0,0 +1,47 @@
+#ifndef ESP8266NDN_PBUF_GATHER_HPP
+#define ESP8266NDN_PBUF_GATHER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace ndn {
+namespace detail {
+
+/** \brief Copy part of a pbuf chain into a contiguous buffer in one pass.
+ *  \tparam Pbuf lwIP pbuf, or any structure with next, payload, len fields
+ *  \param p first pbuf of the chain
+ *  \param offset starting offset within the chain
+ *  \param[out] buf output buffer
+ *  \param len number of octets to copy
+ *  \return number of octets copied, less than \p len if the chain is shorter
+ *
+ *  This is equivalent to lwIP pbuf_copy_partial, but is written as a template so that it
+ *  can be tested without lwIP.
+ */
+template<typename Pbuf>
+size_t
+gatherPbuf(const Pbuf* p, size_t offset, uint8_t* buf, size_t len)
+{
+  size_t copied = 0;
+  for (; p != nullptr && copied < len; p = p->next) {
+    if (offset >= p->len) {
+      offset -= p->len;
+      continue;
+    }
+
+    size_t segLen = p->len - offset;
+    if (segLen > len - copied) {
+      segLen = len - copied;
+    }
+    std::memcpy(buf + copied, reinterpret_cast<const uint8_t*>(p->payload) + offset, segLen);
+    copied += segLen;
+    offset = 0;
+  }
+  return copied;
+}
+
+} // namespace detail
+} // namespace ndn
+
+#endif // ESP8266NDN_PBUF_GATHER_HPP
@@ -2,14 +2,37 @@
 #define ESP8266NDN_QUEUE_HPP
 
 #include <array>
-#ifdef ESP32
-#include <freertos/FreeRTOS.h>
-#include <freertos/queue.h>
-#endif
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
 
 namespace ndn {
 namespace detail {
 
+/** \brief Assumed cache line size, used to keep producer and consumer indices apart.
+ */
+#if defined(ESP32)
+#define ESP8266NDN_CACHELINE_SIZE 32
+#elif defined(ARDUINO)
+#define ESP8266NDN_CACHELINE_SIZE 4
+#else
+#define ESP8266NDN_CACHELINE_SIZE 64
+#endif
+
+/** \brief Padding that fills up the remainder of a cache line after \p USED octets.
+ */
+template<size_t USED, bool NEED = (USED < ESP8266NDN_CACHELINE_SIZE)>
+struct CachelinePad
+{
+  uint8_t pad[ESP8266NDN_CACHELINE_SIZE - USED];
+};
+
+template<size_t USED>
+struct CachelinePad<USED, false>
+{
+};
+
 /** \brief Generic non-thread-safe queue.
  */
 template<typename T, int CAPACITY>
@@ -47,51 +70,96 @@ private:
   int m_tail = 0;
 };
 
-#ifdef ESP32
-
-/** \brief Generic thread-safe queue.
+/** \brief Lock-free single-producer single-consumer queue.
+ *
+ *  push() may be invoked from one thread and pop() from another thread, without locking.
+ *  Each side keeps a private copy of the other side's index, so that the shared index is
+ *  only re-read when the queue appears full or empty.
+ *  Only atomic loads and stores are used, so this works on targets without compare-and-swap.
  */
 template<typename T, int CAPACITY>
-class SafeQueue
+class SpscQueue
 {
 public:
-  SafeQueue()
-  {
-    m_queue = xQueueCreate(CAPACITY, sizeof(T));
-  }
-
-  ~SafeQueue()
-  {
-    vQueueDelete(m_queue);
-  }
+  static_assert(CAPACITY > 0, "");
 
+  /** \brief Append an item; producer side.
+   *  \return whether success; false if queue is full
+   */
   bool
   push(T item)
   {
-    BaseType_t res = xQueueSend(m_queue, &item, 0);
-    return res == pdTRUE;
+    uint32_t tail = m_prod.tail.load(std::memory_order_relaxed);
+    uint32_t newTail = advance(tail);
+    if (newTail == m_prod.headCache) {
+      m_prod.headCache = m_cons.head.load(std::memory_order_acquire);
+      if (newTail == m_prod.headCache) {
+        return false;
+      }
+    }
+
+    m_arr[tail] = item;
+    m_prod.tail.store(newTail, std::memory_order_release);
+    return true;
   }
 
+  /** \brief Remove an item; consumer side.
+   *  \return the item, and whether success
+   */
   std::tuple<T, bool>
   pop()
   {
-    T item;
-    if (!xQueueReceive(m_queue, &item, 0)) {
-      return std::make_tuple(T(), false);
+    uint32_t head = m_cons.head.load(std::memory_order_relaxed);
+    if (head == m_cons.tailCache) {
+      m_cons.tailCache = m_prod.tail.load(std::memory_order_acquire);
+      if (head == m_cons.tailCache) {
+        return std::make_tuple(T(), false);
+      }
     }
+
+    T item = m_arr[head];
+    m_cons.head.store(advance(head), std::memory_order_release);
     return std::make_tuple(item, true);
   }
 
 private:
-  QueueHandle_t m_queue;
-};
+  static uint32_t
+  advance(uint32_t index)
+  {
+    return index + 1 == SIZE ? 0 : index + 1;
+  }
 
-#else // ESP32
+private:
+  /** \brief Number of slots; one slot is always empty to distinguish full from empty.
+   */
+  static constexpr uint32_t SIZE = CAPACITY + 1;
 
-template<typename T, int CAPACITY>
-using SafeQueue = Queue<T, CAPACITY>;
+  struct Producer
+  {
+    std::atomic<uint32_t> tail{0}; ///< written by producer
+    uint32_t headCache = 0;        ///< producer's copy of head
+  };
+
+  struct Consumer
+  {
+    std::atomic<uint32_t> head{0}; ///< written by consumer
+    uint32_t tailCache = 0;        ///< consumer's copy of tail
+  };
+
+  Producer m_prod;
+  CachelinePad<sizeof(Producer)> m_pad0;
+  Consumer m_cons;
+  CachelinePad<sizeof(Consumer)> m_pad1;
+  std::array<T, SIZE> m_arr;
+};
 
-#endif // ESP32
+/** \brief Generic thread-safe queue.
+ *
+ *  This is safe for one producer thread and one consumer thread, such as a network stack
+ *  callback on one CPU and the Arduino main loop on another CPU.
+ */
+template<typename T, int CAPACITY>
+using SafeQueue = SpscQueue<T, CAPACITY>;
 
 } // namespace detail
 } // namespace ndn
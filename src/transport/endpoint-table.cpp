@@ -0,0 +1,182 @@
+#include "endpoint-table.hpp"
+#include "../core/clock.hpp"
+
+namespace ndn {
+
+void
+EndpointTable::Entry::addRttSample(uint32_t rtt)
+{
+  if (srtt == 0) {
+    srtt = rtt;
+    rttvar = rtt / 2;
+    return;
+  }
+  uint32_t delta = srtt > rtt ? srtt - rtt : rtt - srtt;
+  rttvar = rttvar - rttvar / 4 + delta / 4;
+  srtt = srtt - srtt / 8 + rtt / 8;
+}
+
+EndpointTable::EndpointTable(uint16_t capacity)
+  : m_capacity(capacity == 0 ? 1 : capacity < NIL ? capacity : NIL - 1)
+  , m_size(0)
+  , m_head(NIL)
+  , m_tail(NIL)
+  , m_free(NIL)
+  , m_entries(new Entry[m_capacity])
+{
+  // load factor at most 0.5
+  uint32_t nBuckets = 1;
+  while (nBuckets < 2U * m_capacity && nBuckets < 0x8000) {
+    nBuckets <<= 1;
+  }
+  m_bucketMask = nBuckets - 1;
+  m_buckets.reset(new uint16_t[nBuckets]);
+  for (uint32_t b = 0; b < nBuckets; ++b) {
+    m_buckets[b] = NIL;
+  }
+
+  for (uint16_t i = m_capacity; i > 0; --i) {
+    m_entries[i - 1].m_hashNext = m_free;
+    m_free = i - 1;
+  }
+}
+
+EndpointTable::~EndpointTable() = default;
+
+uint16_t&
+EndpointTable::bucketOf(uint64_t endpointId)
+{
+  // MurmurHash3 finalizer
+  uint64_t h = endpointId;
+  h ^= h >> 33;
+  h *= 0xFF51AFD7ED558CCDULL;
+  h ^= h >> 33;
+  return m_buckets[h & m_bucketMask];
+}
+
+EndpointTable::Entry*
+EndpointTable::find(uint64_t endpointId)
+{
+  for (uint16_t i = bucketOf(endpointId); i != NIL; i = m_entries[i].m_hashNext) {
+    if (m_entries[i].endpointId == endpointId) {
+      return &m_entries[i];
+    }
+  }
+  return nullptr;
+}
+
+EndpointTable::Entry&
+EndpointTable::touch(uint64_t endpointId)
+{
+  uint16_t& bucket = bucketOf(endpointId);
+  for (uint16_t i = bucket; i != NIL; i = m_entries[i].m_hashNext) {
+    if (m_entries[i].endpointId == endpointId) {
+      if (i != m_head) {
+        unlinkLru(i);
+        pushFront(i);
+      }
+      return m_entries[i];
+    }
+  }
+
+  uint16_t i = m_free;
+  if (i != NIL) {
+    m_free = m_entries[i].m_hashNext;
+    ++m_size;
+  }
+  else {
+    i = m_tail;
+    unlinkHash(i);
+    unlinkLru(i);
+    ++m_cnt.nEvictions;
+  }
+
+  Entry& entry = m_entries[i];
+  entry = Entry();
+  entry.endpointId = endpointId;
+  entry.m_hashNext = bucket;
+  bucket = i;
+  pushFront(i);
+  ++m_cnt.nInserts;
+  return entry;
+}
+
+bool
+EndpointTable::erase(uint64_t endpointId)
+{
+  Entry* entry = find(endpointId);
+  if (entry == nullptr) {
+    return false;
+  }
+  uint16_t i = entry - &m_entries[0];
+  unlinkHash(i);
+  unlinkLru(i);
+  entry->m_hashNext = m_free;
+  m_free = i;
+  --m_size;
+  return true;
+}
+
+void
+EndpointTable::countRx(uint64_t endpointId, size_t len)
+{
+  Entry& entry = touch(endpointId);
+  ++entry.nRxPkts;
+  entry.nRxOctets += len;
+  entry.lastSeen = getClock().getMillis();
+}
+
+void
+EndpointTable::countTx(uint64_t endpointId, size_t len)
+{
+  Entry* entry = find(endpointId);
+  if (entry != nullptr) {
+    ++entry->nTxPkts;
+    entry->nTxOctets += len;
+  }
+}
+
+void
+EndpointTable::unlinkHash(uint16_t i)
+{
+  uint16_t* p = &bucketOf(m_entries[i].endpointId);
+  while (*p != i) {
+    p = &m_entries[*p].m_hashNext;
+  }
+  *p = m_entries[i].m_hashNext;
+}
+
+void
+EndpointTable::unlinkLru(uint16_t i)
+{
+  Entry& entry = m_entries[i];
+  if (entry.m_prev != NIL) {
+    m_entries[entry.m_prev].m_next = entry.m_next;
+  }
+  else {
+    m_head = entry.m_next;
+  }
+  if (entry.m_next != NIL) {
+    m_entries[entry.m_next].m_prev = entry.m_prev;
+  }
+  else {
+    m_tail = entry.m_prev;
+  }
+}
+
+void
+EndpointTable::pushFront(uint16_t i)
+{
+  Entry& entry = m_entries[i];
+  entry.m_prev = NIL;
+  entry.m_next = m_head;
+  if (m_head != NIL) {
+    m_entries[m_head].m_prev = i;
+  }
+  else {
+    m_tail = i;
+  }
+  m_head = i;
+}
+
+} // namespace ndn
@@ -0,0 +1,154 @@
+#ifndef ESP8266NDN_ENDPOINT_TABLE_HPP
+#define ESP8266NDN_ENDPOINT_TABLE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace ndn {
+
+/** \brief a bounded table of per-endpoint state, keyed by transport endpointId
+ *
+ *  Entries live in a fixed array allocated at construction. Lookup is a hash table walk, and
+ *  recency is kept in an intrusive doubly linked list, so that find, insert, and eviction of the
+ *  least recently seen endpoint all take constant time.
+ */
+class EndpointTable
+{
+public:
+  /** \brief per-endpoint state
+   */
+  class Entry
+  {
+  public:
+    /** \brief add an RTT sample
+     *  \param rtt round-trip time in micros
+     *
+     *  This maintains \c srtt and \c rttvar as in RFC 6298.
+     */
+    void
+    addRttSample(uint32_t rtt);
+
+  public:
+    uint64_t endpointId = 0;
+    unsigned long lastSeen = 0; ///< getClock().getMillis() when last packet was received
+    uint32_t nRxPkts = 0;
+    uint32_t nRxOctets = 0;
+    uint32_t nTxPkts = 0;
+    uint32_t nTxOctets = 0;
+    uint32_t srtt = 0;   ///< smoothed RTT in micros, 0 if there is no sample
+    uint32_t rttvar = 0; ///< RTT variation in micros
+
+  private:
+    uint16_t m_hashNext; ///< next entry in hash chain or free list
+    uint16_t m_prev;     ///< more recently seen entry
+    uint16_t m_next;     ///< less recently seen entry
+
+    friend class EndpointTable;
+  };
+
+  class Counters
+  {
+  public:
+    uint32_t nInserts = 0;   ///< entries created
+    uint32_t nEvictions = 0; ///< entries evicted to make room
+  };
+
+  /** \brief constructor
+   *  \param capacity max number of entries, between 1 and 65534
+   */
+  explicit
+  EndpointTable(uint16_t capacity);
+
+  ~EndpointTable();
+
+  /** \brief find an entry without changing its recency
+   *  \return the entry, or nullptr if not found
+   */
+  Entry*
+  find(uint64_t endpointId);
+
+  /** \brief find or insert an entry, and mark it most recently seen
+   *
+   *  If the table is full, the least recently seen entry is evicted.
+   */
+  Entry&
+  touch(uint64_t endpointId);
+
+  /** \brief erase an entry
+   *  \return whether the entry existed
+   */
+  bool
+  erase(uint64_t endpointId);
+
+  /** \brief record a received packet, for use by transports
+   */
+  void
+  countRx(uint64_t endpointId, size_t len);
+
+  /** \brief record a transmitted packet to a known endpoint, for use by transports
+   *
+   *  This does not create an entry or change recency.
+   */
+  void
+  countTx(uint64_t endpointId, size_t len);
+
+  /** \brief invoke \p f on each entry, from most to least recently seen
+   */
+  template<typename F>
+  void
+  forEach(const F& f) const
+  {
+    for (uint16_t i = m_head; i != NIL; i = m_entries[i].m_next) {
+      f(m_entries[i]);
+    }
+  }
+
+  size_t
+  size() const
+  {
+    return m_size;
+  }
+
+  size_t
+  capacity() const
+  {
+    return m_capacity;
+  }
+
+  const Counters&
+  getCounters() const
+  {
+    return m_cnt;
+  }
+
+private:
+  uint16_t&
+  bucketOf(uint64_t endpointId);
+
+  void
+  unlinkHash(uint16_t i);
+
+  void
+  unlinkLru(uint16_t i);
+
+  void
+  pushFront(uint16_t i);
+
+private:
+  static const uint16_t NIL = 0xFFFF;
+
+  const uint16_t m_capacity;
+  uint16_t m_bucketMask;
+  uint16_t m_size;
+  uint16_t m_head; ///< most recently seen
+  uint16_t m_tail; ///< least recently seen
+  uint16_t m_free; ///< free list, linked by m_hashNext
+  std::unique_ptr<Entry[]> m_entries;
+  std::unique_ptr<uint16_t[]> m_buckets;
+  Counters m_cnt;
+};
+
+} // namespace ndn
+
+#endif // ESP8266NDN_ENDPOINT_TABLE_HPP
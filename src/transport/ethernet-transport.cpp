@@ -1,6 +1,7 @@
 #if defined(ESP8266) || defined(ESP32)
 
 #include "ethernet-transport.hpp"
+#include "detail/pbuf-gather.hpp"
 #include "detail/queue.hpp"
 #include "../core/logger.hpp"
 
@@ -10,6 +11,8 @@
 #include <netif/etharp.h>
 #include <IPAddress.h>
 
+#include <atomic>
+
 #define ETHTRANSPORT_DBG(...) DBG(EthernetTransport, __VA_ARGS__)
 
 namespace ndn {
@@ -19,24 +22,58 @@ static EthernetTransport* g_ethTransport = nullptr;
 class EthernetTransport::Impl
 {
 public:
-  explicit
-  Impl(netif* nif)
+  Impl(netif* nif, const RxQueueOptions& opts)
     : nif(nif)
     , oldInput(nif->input)
   {
+    setOptions(opts);
     nif->input = EthernetTransport::Impl::input;
   }
 
   ~Impl()
   {
     nif->input = this->oldInput;
-    bool ok;
     pbuf* p;
-    while (std::tie(p, ok) = queue.pop(), ok) {
+    while ((p = this->pop()) != nullptr) {
       pbuf_free(p);
     }
   }
 
+  /** \brief publish RX queue limits to the producer side
+   *
+   *  Each limit is a separate atomic variable, because the producer checks them independently.
+   */
+  void
+  setOptions(const RxQueueOptions& opts)
+  {
+    maxPkts.store(std::min<uint32_t>(opts.maxPkts, ETHTRANSPORT_RX_QUEUE_LEN), std::memory_order_relaxed);
+    maxBytes.store(opts.maxBytes, std::memory_order_relaxed);
+  }
+
+  /** \brief get current RX queue length
+   */
+  uint32_t
+  countQueued() const
+  {
+    return nPktsIn.load(std::memory_order_acquire) - nPktsOut.load(std::memory_order_relaxed);
+  }
+
+  /** \brief dequeue a packet; consumer side
+   */
+  pbuf*
+  pop()
+  {
+    pbuf* p;
+    bool ok;
+    std::tie(p, ok) = queue.pop();
+    if (!ok) {
+      return nullptr;
+    }
+    nBytesOut.store(nBytesOut.load(std::memory_order_relaxed) + p->tot_len, std::memory_order_release);
+    nPktsOut.store(nPktsOut.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    return p;
+  }
+
   static err_t
   input(pbuf* p, netif* inp)
   {
@@ -52,14 +89,46 @@ public:
       return self.oldInput(p, inp);
     }
 
-    bool ok = self.queue.push(p);
-    if (!ok) {
+    if (!self.push(p)) {
       ETHTRANSPORT_DBG(F("RX queue is full"));
+      ++self.counters.nDropFull;
       pbuf_free(p);
     }
     return ERR_OK;
   }
 
+private:
+  /** \brief enqueue a packet if RX queue limits permit; producer side
+   *
+   *  Occupancy is derived from producer-written and consumer-written counters, so that
+   *  neither side needs a read-modify-write on shared memory. The consumer's counters
+   *  may be stale, which can only overestimate occupancy.
+   */
+  bool
+  push(pbuf* p)
+  {
+    uint32_t pktsIn = nPktsIn.load(std::memory_order_relaxed);
+    uint32_t bytesIn = nBytesIn.load(std::memory_order_relaxed);
+    uint32_t nPkts = pktsIn - nPktsOut.load(std::memory_order_acquire);
+    uint32_t nBytes = bytesIn - nBytesOut.load(std::memory_order_acquire);
+    if (nPkts >= maxPkts.load(std::memory_order_relaxed) ||
+        nBytes + p->tot_len > maxBytes.load(std::memory_order_relaxed)) {
+      return false;
+    }
+
+    // cannot fail: the consumer updates its counters after popping, so that nPkts is never less
+    // than actual queue occupancy, which is therefore below queue capacity
+    queue.push(p);
+    nBytesIn.store(bytesIn + p->tot_len, std::memory_order_relaxed);
+    nPktsIn.store(pktsIn + 1, std::memory_order_release);
+
+    ++counters.nQueued;
+    if (nPkts + 1 > counters.maxQueuedPkts) {
+      counters.maxQueuedPkts = nPkts + 1;
+    }
+    return true;
+  }
+
 public:
   netif* nif = nullptr;
   netif_input_fn oldInput = nullptr;
@@ -74,6 +143,16 @@ public:
    *      not have to deal with multi-threading.
    */
   detail::SafeQueue<pbuf*, ETHTRANSPORT_RX_QUEUE_LEN> queue;
+
+  RxCounters counters;
+
+private:
+  std::atomic<uint32_t> maxPkts{0};   ///< RxQueueOptions::maxPkts, capped at queue capacity
+  std::atomic<uint32_t> maxBytes{0};  ///< RxQueueOptions::maxBytes
+  std::atomic<uint32_t> nPktsIn{0};   ///< packets pushed, written by producer
+  std::atomic<uint32_t> nBytesIn{0};  ///< octets pushed, written by producer
+  std::atomic<uint32_t> nPktsOut{0};  ///< packets popped, written by consumer
+  std::atomic<uint32_t> nBytesOut{0}; ///< octets popped, written by consumer
 };
 
 void
@@ -137,7 +216,7 @@ EthernetTransport::begin(netif* nif)
   }
 
   g_ethTransport = this;
-  m_impl.reset(new Impl(nif));
+  m_impl.reset(new Impl(nif, m_rxOpts));
   ETHTRANSPORT_DBG(F("enabled on ") << nif->name[0] << nif->name[1] << nif->num);
   return true;
 }
@@ -150,6 +229,24 @@ EthernetTransport::end()
   ETHTRANSPORT_DBG(F("disabled"));
 }
 
+void
+EthernetTransport::setRxQueueOptions(const RxQueueOptions& options)
+{
+  m_rxOpts = options;
+  if (m_impl != nullptr) {
+    m_impl->setOptions(m_rxOpts);
+  }
+}
+
+EthernetTransport::RxCounters
+EthernetTransport::getRxCounters() const
+{
+  if (m_impl == nullptr) {
+    return {};
+  }
+  return m_impl->counters;
+}
+
 size_t
 EthernetTransport::receive(uint8_t* buf, size_t bufSize, uint64_t& endpointId)
 {
@@ -157,30 +254,37 @@ EthernetTransport::receive(uint8_t* buf, size_t bufSize, uint64_t& endpointId)
     return 0;
   }
 
-  size_t pktSize = 0;
-  pbuf* p;
-  bool ok;
-  while (std::tie(p, ok) = m_impl->queue.pop(), ok) {
-    if (p->next != nullptr) {
-      ETHTRANSPORT_DBG(F("unhandled: chained packet"));
-      pbuf_free(p);
-      continue;
+  if (m_rxHighCb != nullptr) {
+    uint32_t nQueued = m_impl->countQueued();
+    if (nQueued >= m_rxOpts.highWatermark) {
+      ++m_impl->counters.nHighWatermark;
+      m_rxHighCb(m_rxHighCbArg, nQueued);
     }
+  }
 
-    if (p->tot_len > bufSize) {
+  size_t pktSize = 0;
+  pbuf* p;
+  while ((p = m_impl->pop()) != nullptr) {
+    pktSize = p->tot_len - sizeof(eth_hdr);
+    if (pktSize > bufSize) {
       ETHTRANSPORT_DBG(F("insufficient receive buffer: tot_len=") << _DEC(p->tot_len));
+      ++m_impl->counters.nDropOversized;
       pbuf_free(p);
+      pktSize = 0;
       continue;
     }
 
+    // Impl::input has checked that Ethernet header is in the first pbuf
     const eth_hdr* eth = reinterpret_cast<const eth_hdr*>(p->payload);
     EndpointId endpoint = {0};
     memcpy(endpoint.addr, &eth->src, 6);
     endpoint.isMulticast = 0x01 & (*reinterpret_cast<const uint8_t*>(&eth->dest));
     endpointId = endpoint.endpointId;
 
-    pktSize = p->tot_len - sizeof(eth_hdr);
-    memcpy(buf, reinterpret_cast<const uint8_t*>(p->payload) + sizeof(eth_hdr), pktSize);
+    if (p->next != nullptr) {
+      ++m_impl->counters.nChained;
+    }
+    detail::gatherPbuf(p, sizeof(eth_hdr), buf, pktSize);
 
     pbuf_free(p);
     break;
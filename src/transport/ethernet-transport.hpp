@@ -13,9 +13,12 @@ class Print;
 
 namespace ndn {
 
-/** \brief Receive queue length of EthernetTransport.
+/** \brief Maximum receive queue length of EthernetTransport.
+ *
+ *  This determines memory allocation. The effective limit is set at runtime via
+ *  \c EthernetTransport::RxQueueOptions.
  */
-static const int ETHTRANSPORT_RX_QUEUE_LEN = 4;
+static const int ETHTRANSPORT_RX_QUEUE_LEN = 16;
 
 /** \brief a transport that communicates over Ethernet
  */
@@ -33,6 +36,49 @@ public:
     };
   };
 
+  /** \brief receive queue limits
+   */
+  class RxQueueOptions
+  {
+  public:
+    /** \brief max number of queued pbufs, capped at ETHTRANSPORT_RX_QUEUE_LEN
+     */
+    uint16_t maxPkts = 4;
+    /** \brief max total length of queued pbufs, in octets
+     */
+    uint32_t maxBytes = 6144;
+    /** \brief queued pbuf count that triggers high-watermark callback
+     */
+    uint16_t highWatermark = 3;
+  };
+
+  /** \brief receive counters
+   */
+  class RxCounters
+  {
+  public:
+    uint32_t nQueued = 0;        ///< packets accepted into RX queue
+    uint32_t nDropFull = 0;      ///< dropped because RX queue reached maxPkts or maxBytes
+    uint32_t nChained = 0;       ///< received as chained pbufs and gathered
+    uint32_t nDropOversized = 0; ///< dropped because packet exceeds receive buffer
+    uint32_t nHighWatermark = 0; ///< times high-watermark callback was invoked
+    uint16_t maxQueuedPkts = 0;  ///< max observed RX queue length
+  };
+
+  /** \brief a high-watermark handler
+   *  \param arg cbarg passed to \p onRxHighWatermark
+   *  \param nQueued number of packets waiting in RX queue
+   *
+   *  A typical handler lets the Face drain the burst:
+   *  \code
+   *  void onRxHigh(void* arg, size_t nQueued) {
+   *    reinterpret_cast<ndn::Face*>(arg)->raisePacketLimit(nQueued);
+   *  }
+   *  transport.onRxHighWatermark(&onRxHigh, &face);
+   *  \endcode
+   */
+  typedef void (*RxHighWatermarkCallback)(void* arg, size_t nQueued);
+
   static void
   listNetifs(Print& os);
 
@@ -55,6 +101,38 @@ public:
   void
   end();
 
+  /** \brief change receive queue limits
+   *
+   *  This may be invoked before or after \p begin(). After \p begin(), new limits are published
+   *  to the network stack thread atomically, and take effect on the next received packet.
+   */
+  void
+  setRxQueueOptions(const RxQueueOptions& options);
+
+  const RxQueueOptions&
+  getRxQueueOptions() const
+  {
+    return m_rxOpts;
+  }
+
+  /** \brief retrieve receive counters
+   */
+  RxCounters
+  getRxCounters() const;
+
+  /** \brief set high-watermark handler
+   *
+   *  The handler is invoked within \c receive() when RX queue length reaches
+   *  \c RxQueueOptions::highWatermark. Only one handler is allowed. This overwrites any
+   *  previous handler setting.
+   */
+  void
+  onRxHighWatermark(RxHighWatermarkCallback cb, void* cbarg)
+  {
+    m_rxHighCb = cb;
+    m_rxHighCbArg = cbarg;
+  }
+
   /** \begin receive a packet
    *  \param[out] endpointId identity of remote endpoint and whether packet was multicast
    */
@@ -67,6 +145,14 @@ public:
   ndn_Error
   send(const uint8_t* pkt, size_t len, uint64_t endpointId) override;
 
+  /** \brief get Ethernet MTU
+   */
+  size_t
+  getMtu() const final
+  {
+    return 1500;
+  }
+
 private:
   bool
   begin(netif* netif);
@@ -74,6 +160,9 @@ private:
 private:
   class Impl;
   std::unique_ptr<Impl> m_impl;
+  RxQueueOptions m_rxOpts;
+  RxHighWatermarkCallback m_rxHighCb = nullptr;
+  void* m_rxHighCbArg = nullptr;
 };
 
 } // namespace ndn
@@ -0,0 +1,792 @@
+#include "header-compressor.hpp"
+#include "../core/logger.hpp"
+
+#include "../ndn-cpp/c/encoding/tlv/tlv.h"
+#include "../ndn-cpp/c/encoding/tlv/tlv-decoder.h"
+#include "../ndn-cpp/c/encoding/tlv/tlv-encoder.h"
+#include "../ndn-cpp/lite/name-lite.hpp"
+#include "../ndn-cpp/lite/util/dynamic-uint8-array-lite.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#define HC_DBG(...) DBG(HeaderCompressor, __VA_ARGS__)
+
+namespace ndn {
+namespace {
+
+enum {
+  TT_KeywordComponent = 0x20,
+  TT_SegmentComponent = 0x32,
+  TT_ByteOffsetComponent = 0x34,
+  TT_VersionComponent = 0x36,
+  TT_TimestampComponent = 0x38,
+  TT_SequenceNumComponent = 0x3A,
+};
+
+enum {
+  HC_I_CAN_BE_PREFIX = 0x01,
+  HC_I_MUST_BE_FRESH = 0x02,
+  HC_I_FORWARDING_HINT = 0x04, ///< followed by VAR-NUMBER length and value
+  HC_I_NONCE = 0x08,           ///< followed by 4-octet value
+  HC_I_LIFETIME_MASK = 0x30,
+  HC_I_LIFETIME_DEFAULT = 0x10, ///< InterestLifetime=4000
+  HC_I_LIFETIME_OTHER = 0x20,   ///< followed by 1-octet length and value
+  HC_I_HOP_LIMIT = 0x40,        ///< followed by 1-octet value
+
+  HC_D_META_MASK = 0x03,
+  HC_D_META_FRESHNESS = 0x01, ///< MetaInfo with only FreshnessPeriod, 1-octet length and value
+  HC_D_META_OTHER = 0x02,     ///< followed by VAR-NUMBER length and value
+  HC_D_CONTENT = 0x04,        ///< followed by VAR-NUMBER length and value
+  HC_D_SIGINFO_MASK = 0x18,
+  HC_D_SIGINFO_OTHER = 0x00,   ///< followed by VAR-NUMBER length and value
+  HC_D_SIGINFO_DIGEST = 0x08,  ///< DigestSha256, followed by 32-octet SignatureValue
+  HC_D_SIGINFO_KEYNAME = 0x10, ///< followed by 1-octet SignatureType and compressed key name
+  HC_D_SIGVALUE = 0x20,        ///< followed by VAR-NUMBER length and value
+
+  HC_COMP_GENERIC_MAX = 0xEF, ///< GenericNameComponent of this length, followed by value
+  HC_COMP_TYPED = 0xF0,       ///< plus index in TYPED_COMPS, followed by 1-octet length and value
+  HC_COMP_VERBATIM = 0xFF,    ///< followed by name component TLV
+};
+
+/** \brief name component types that are encoded as a token
+ */
+const uint8_t TYPED_COMPS[] = {
+  ndn_Tlv_ImplicitSha256DigestComponent,
+  ndn_Tlv_ParametersSha256DigestComponent,
+  TT_KeywordComponent,
+  TT_SegmentComponent,
+  TT_ByteOffsetComponent,
+  TT_VersionComponent,
+  TT_TimestampComponent,
+  TT_SequenceNumComponent,
+};
+
+const uint8_t DIGEST_SIGINFO_VALUE[] = {ndn_Tlv_SignatureType, 0x01, 0x00};
+const uint8_t DIGEST_SIGINFO_TLV[] = {ndn_Tlv_SignatureInfo, 0x03,
+                                      ndn_Tlv_SignatureType, 0x01, 0x00,
+                                      ndn_Tlv_SignatureValue, 0x20};
+
+/** \brief prefix dictionary view
+ */
+class Dict
+{
+public:
+  /** \brief find the longest entry that is a prefix of name TLV-VALUE
+   *  \return entry number starting from 1, or 0 if none
+   *
+   *  Entries consist of whole components, so that a match ends at a component boundary.
+   */
+  uint8_t
+  match(const uint8_t* value, size_t len, size_t& matchLen) const
+  {
+    uint8_t ref = 0;
+    uint8_t i = 0;
+    matchLen = 0;
+    for (size_t pos = 0; pos < size; pos += 1 + buf[pos]) {
+      ++i;
+      size_t entryLen = buf[pos];
+      if (entryLen > matchLen && entryLen <= len &&
+          std::memcmp(&buf[pos + 1], value, entryLen) == 0) {
+        ref = i;
+        matchLen = entryLen;
+      }
+    }
+    return ref;
+  }
+
+  /** \brief retrieve an entry
+   *  \return entry, or nullptr if not found
+   */
+  const uint8_t*
+  get(uint8_t ref, size_t& len) const
+  {
+    uint8_t i = 0;
+    for (size_t pos = 0; pos < size; pos += 1 + buf[pos]) {
+      if (++i == ref) {
+        len = buf[pos];
+        return &buf[pos + 1];
+      }
+    }
+    return nullptr;
+  }
+
+public:
+  const uint8_t* buf;
+  size_t size;
+};
+
+/** \brief read TLV-TYPE and TLV-LENGTH, and ensure TLV-VALUE is within \p end
+ *
+ *  Non-minimal encoding is rejected, because the decompressor would not reproduce it.
+ */
+ndn_Error
+readTl(ndn_TlvDecoder& in, size_t end, uint64_t& type, uint64_t& length)
+{
+  size_t begin = in.offset;
+  ndn_Error e;
+  if ((e = ndn_TlvDecoder_readVarNumber(&in, &type)) ||
+      (e = ndn_TlvDecoder_readVarNumber(&in, &length))) {
+    return e;
+  }
+  if (in.offset - begin != ndn_TlvEncoder_sizeOfVarNumber(type) +
+                          ndn_TlvEncoder_sizeOfVarNumber(length)) {
+    return NDN_ERROR_header_type_is_out_of_range;
+  }
+  if (in.offset + length > end) {
+    return NDN_ERROR_TLV_length_exceeds_buffer_length;
+  }
+  return NDN_ERROR_success;
+}
+
+ndn_Error
+readOctet(ndn_TlvDecoder& in, uint8_t& value)
+{
+  if (in.offset >= in.inputLength) {
+    return NDN_ERROR_read_past_the_end_of_the_input;
+  }
+  value = in.input[in.offset++];
+  return NDN_ERROR_success;
+}
+
+ndn_Error
+writeOctet(ndn_TlvEncoder& out, uint8_t value)
+{
+  return ndn_TlvEncoder_writeArray(&out, &value, 1);
+}
+
+ndn_Error
+copyOctets(ndn_TlvDecoder& in, ndn_TlvEncoder& out, size_t len)
+{
+  if (in.offset + len > in.inputLength) {
+    return NDN_ERROR_read_past_the_end_of_the_input;
+  }
+  ndn_Error e = ndn_TlvEncoder_writeArray(&out, &in.input[in.offset], len);
+  in.offset += len;
+  return e;
+}
+
+/** \brief copy TLV-VALUE of \p length octets, preceded by VAR-NUMBER length
+ */
+ndn_Error
+compressVarLen(ndn_TlvDecoder& in, ndn_TlvEncoder& out, uint64_t length)
+{
+  ndn_Error e = ndn_TlvEncoder_writeVarNumber(&out, length);
+  return e ? e : copyOctets(in, out, length);
+}
+
+/** \brief expand VAR-NUMBER length and value into a TLV element of \p type
+ */
+ndn_Error
+decompressVarLen(ndn_TlvDecoder& in, ndn_TlvEncoder& out, unsigned type)
+{
+  uint64_t length;
+  ndn_Error e;
+  if ((e = ndn_TlvDecoder_readVarNumber(&in, &length)) ||
+      (e = ndn_TlvEncoder_writeTypeAndLength(&out, type, length))) {
+    return e;
+  }
+  return copyOctets(in, out, length);
+}
+
+/** \brief write a TLV element whose TLV-VALUE is produced by \p writeValue
+ *
+ *  \p writeValue is invoked once with output disabled to compute TLV-LENGTH, then again
+ *  to write TLV-VALUE, unless the caller is itself computing a length.
+ */
+template<typename F>
+ndn_Error
+writeNested(ndn_TlvDecoder& in, ndn_TlvEncoder& out, unsigned type, const F& writeValue)
+{
+  size_t inBegin = in.offset;
+  size_t outBegin = out.offset;
+  int enableOutput = out.enableOutput;
+  out.enableOutput = 0;
+  ndn_Error e = writeValue();
+  out.enableOutput = enableOutput;
+  if (e) {
+    return e;
+  }
+  size_t inEnd = in.offset;
+  size_t valueLen = out.offset - outBegin;
+  out.offset = outBegin;
+  if ((e = ndn_TlvEncoder_writeTypeAndLength(&out, type, valueLen))) {
+    return e;
+  }
+  if (!enableOutput) {
+    out.offset += valueLen;
+    return NDN_ERROR_success;
+  }
+  in.offset = inBegin;
+  e = writeValue();
+  return e || in.offset == inEnd ? e : NDN_ERROR_header_type_is_out_of_range;
+}
+
+ndn_Error
+compressName(const Dict& dict, ndn_TlvDecoder& in, size_t end, ndn_TlvEncoder& out)
+{
+  uint64_t type, length;
+  ndn_Error e = readTl(in, end, type, length);
+  if (e) {
+    return e;
+  }
+  if (type != ndn_Tlv_Name) {
+    return NDN_ERROR_did_not_get_the_expected_TLV_type;
+  }
+  size_t nameEnd = in.offset + length;
+
+  size_t prefixLen = 0;
+  uint8_t ref = dict.match(&in.input[in.offset], length, prefixLen);
+  in.offset += prefixLen;
+  if ((e = writeOctet(out, ref)) || (e = writeOctet(out, 0))) {
+    return e;
+  }
+  size_t countPos = out.offset - 1;
+
+  uint8_t nComps = 0;
+  while (in.offset < nameEnd) {
+    if (++nComps == 0) {
+      return NDN_ERROR_TLV_length_exceeds_buffer_length;
+    }
+    size_t compBegin = in.offset;
+    if ((e = readTl(in, nameEnd, type, length))) {
+      return e;
+    }
+
+    const uint8_t* typed = std::find(TYPED_COMPS, TYPED_COMPS + sizeof(TYPED_COMPS), type);
+    if (type == ndn_Tlv_NameComponent && length <= HC_COMP_GENERIC_MAX) {
+      e = writeOctet(out, length);
+    }
+    else if (typed != TYPED_COMPS + sizeof(TYPED_COMPS) && length <= 0xFF) {
+      if (!(e = writeOctet(out, HC_COMP_TYPED + (typed - TYPED_COMPS)))) {
+        e = writeOctet(out, length);
+      }
+    }
+    else {
+      e = writeOctet(out, HC_COMP_VERBATIM);
+      length += in.offset - compBegin;
+      in.offset = compBegin;
+    }
+    if (e || (e = copyOctets(in, out, length))) {
+      return e;
+    }
+  }
+
+  out.output->array[countPos] = nComps;
+  return NDN_ERROR_success;
+}
+
+ndn_Error
+decompressName(const Dict& dict, ndn_TlvDecoder& in, ndn_TlvEncoder& out)
+{
+  return writeNested(in, out, ndn_Tlv_Name, [&] {
+    uint8_t ref, nComps;
+    ndn_Error e;
+    if ((e = readOctet(in, ref)) || (e = readOctet(in, nComps))) {
+      return e;
+    }
+    if (ref > 0) {
+      size_t prefixLen = 0;
+      const uint8_t* prefix = dict.get(ref, prefixLen);
+      if (prefix == nullptr) {
+        return NDN_ERROR_header_type_is_out_of_range;
+      }
+      if ((e = ndn_TlvEncoder_writeArray(&out, prefix, prefixLen))) {
+        return e;
+      }
+    }
+
+    for (uint8_t i = 0; i < nComps; ++i) {
+      uint8_t token, length;
+      if ((e = readOctet(in, token))) {
+        return e;
+      }
+      if (token <= HC_COMP_GENERIC_MAX) {
+        e = ndn_TlvEncoder_writeTypeAndLength(&out, ndn_Tlv_NameComponent, token);
+        length = token;
+      }
+      else if (token < HC_COMP_TYPED + sizeof(TYPED_COMPS)) {
+        if (!(e = readOctet(in, length))) {
+          e = ndn_TlvEncoder_writeTypeAndLength(&out, TYPED_COMPS[token - HC_COMP_TYPED], length);
+        }
+      }
+      else if (token == HC_COMP_VERBATIM) {
+        size_t compBegin = in.offset;
+        uint64_t compType, compLength;
+        if ((e = readTl(in, in.inputLength, compType, compLength))) {
+          return e;
+        }
+        size_t compSize = in.offset - compBegin + compLength;
+        in.offset = compBegin;
+        e = copyOctets(in, out, compSize);
+        length = 0;
+      }
+      else {
+        return NDN_ERROR_header_type_is_out_of_range;
+      }
+      if (e || (e = copyOctets(in, out, length))) {
+        return e;
+      }
+    }
+    return NDN_ERROR_success;
+  });
+}
+
+ndn_Error
+compressInterest(const Dict& dict, ndn_TlvDecoder& in, ndn_TlvEncoder& out)
+{
+  size_t flagsPos = out.offset;
+  ndn_Error e;
+  if ((e = writeOctet(out, 0)) || (e = compressName(dict, in, in.inputLength, out))) {
+    return e;
+  }
+
+  uint8_t flags = 0;
+  uint64_t type = 0, length = 0;
+  size_t pos = 0;
+  bool ok = false;
+  auto next = [&] {
+    pos = in.offset;
+    ok = pos < in.inputLength && readTl(in, in.inputLength, type, length) == NDN_ERROR_success;
+  };
+
+  next();
+  if (ok && type == ndn_Tlv_CanBePrefix && length == 0) {
+    flags |= HC_I_CAN_BE_PREFIX;
+    next();
+  }
+  if (ok && type == ndn_Tlv_MustBeFresh && length == 0) {
+    flags |= HC_I_MUST_BE_FRESH;
+    next();
+  }
+  if (ok && type == ndn_Tlv_ForwardingHint) {
+    flags |= HC_I_FORWARDING_HINT;
+    if ((e = compressVarLen(in, out, length))) {
+      return e;
+    }
+    next();
+  }
+  if (ok && type == ndn_Tlv_Nonce && length == 4) {
+    flags |= HC_I_NONCE;
+    if ((e = copyOctets(in, out, length))) {
+      return e;
+    }
+    next();
+  }
+  if (ok && type == ndn_Tlv_InterestLifetime && length <= 8) {
+    if (length == 2 && in.input[in.offset] == 0x0F && in.input[in.offset + 1] == 0xA0) {
+      flags |= HC_I_LIFETIME_DEFAULT;
+      in.offset += length;
+    }
+    else {
+      flags |= HC_I_LIFETIME_OTHER;
+      if ((e = writeOctet(out, length)) || (e = copyOctets(in, out, length))) {
+        return e;
+      }
+    }
+    next();
+  }
+  if (ok && type == ndn_Tlv_HopLimit && length == 1) {
+    flags |= HC_I_HOP_LIMIT;
+    if ((e = copyOctets(in, out, length))) {
+      return e;
+    }
+    next();
+  }
+
+  in.offset = pos;
+  out.output->array[flagsPos] = flags;
+  return copyOctets(in, out, in.inputLength - in.offset);
+}
+
+ndn_Error
+decompressInterest(const Dict& dict, ndn_TlvDecoder& in, ndn_TlvEncoder& out)
+{
+  uint8_t flags;
+  ndn_Error e;
+  if ((e = readOctet(in, flags)) || (e = decompressName(dict, in, out))) {
+    return e;
+  }
+
+  if ((flags & HC_I_CAN_BE_PREFIX) &&
+      (e = ndn_TlvEncoder_writeTypeAndLength(&out, ndn_Tlv_CanBePrefix, 0))) {
+    return e;
+  }
+  if ((flags & HC_I_MUST_BE_FRESH) &&
+      (e = ndn_TlvEncoder_writeTypeAndLength(&out, ndn_Tlv_MustBeFresh, 0))) {
+    return e;
+  }
+  if ((flags & HC_I_FORWARDING_HINT) &&
+      (e = decompressVarLen(in, out, ndn_Tlv_ForwardingHint))) {
+    return e;
+  }
+  if ((flags & HC_I_NONCE) &&
+      ((e = ndn_TlvEncoder_writeTypeAndLength(&out, ndn_Tlv_Nonce, 4)) ||
+       (e = copyOctets(in, out, 4)))) {
+    return e;
+  }
+  switch (flags & HC_I_LIFETIME_MASK) {
+    case HC_I_LIFETIME_DEFAULT:
+      e = ndn_TlvEncoder_writeNonNegativeIntegerTlv(&out, ndn_Tlv_InterestLifetime, 4000);
+      break;
+    case HC_I_LIFETIME_OTHER: {
+      uint8_t length;
+      if (!(e = readOctet(in, length)) &&
+          !(e = ndn_TlvEncoder_writeTypeAndLength(&out, ndn_Tlv_InterestLifetime, length))) {
+        e = copyOctets(in, out, length);
+      }
+      break;
+    }
+  }
+  if (e) {
+    return e;
+  }
+  if ((flags & HC_I_HOP_LIMIT) &&
+      ((e = ndn_TlvEncoder_writeTypeAndLength(&out, ndn_Tlv_HopLimit, 1)) ||
+       (e = copyOctets(in, out, 1)))) {
+    return e;
+  }
+  return copyOctets(in, out, in.inputLength - in.offset);
+}
+
+/** \brief compress SignatureInfo whose TLV-TYPE and TLV-LENGTH have been read
+ *  \param[inout] flags SignatureInfo mode
+ */
+ndn_Error
+compressSigInfo(const Dict& dict, ndn_TlvDecoder& in, uint64_t length, ndn_TlvEncoder& out,
+                uint8_t& flags)
+{
+  size_t valueBegin = in.offset;
+  size_t valueEnd = valueBegin + length;
+  size_t outBegin = out.offset;
+
+  if (length == sizeof(DIGEST_SIGINFO_VALUE) &&
+      std::memcmp(&in.input[in.offset], DIGEST_SIGINFO_VALUE, length) == 0 &&
+      in.inputLength - valueEnd >= 2 + 32 &&
+      std::memcmp(&in.input[valueEnd], &DIGEST_SIGINFO_TLV[2 + length], 2) == 0) {
+    flags |= HC_D_SIGINFO_DIGEST;
+    in.offset = valueEnd + 2;
+    return copyOctets(in, out, 32);
+  }
+
+  uint64_t type, typeLength, klLength;
+  if (readTl(in, valueEnd, type, typeLength) == NDN_ERROR_success &&
+      type == ndn_Tlv_SignatureType && typeLength == 1) {
+    uint8_t sigType = in.input[in.offset++];
+    if (readTl(in, valueEnd, type, klLength) == NDN_ERROR_success &&
+        type == ndn_Tlv_KeyLocator && in.offset + klLength == valueEnd &&
+        writeOctet(out, sigType) == NDN_ERROR_success &&
+        compressName(dict, in, valueEnd, out) == NDN_ERROR_success && in.offset == valueEnd) {
+      flags |= HC_D_SIGINFO_KEYNAME;
+      return NDN_ERROR_success;
+    }
+  }
+
+  in.offset = valueBegin;
+  out.offset = outBegin;
+  flags |= HC_D_SIGINFO_OTHER;
+  return compressVarLen(in, out, length);
+}
+
+ndn_Error
+compressData(const Dict& dict, ndn_TlvDecoder& in, ndn_TlvEncoder& out)
+{
+  size_t flagsPos = out.offset;
+  ndn_Error e;
+  if ((e = writeOctet(out, 0)) || (e = compressName(dict, in, in.inputLength, out))) {
+    return e;
+  }
+
+  uint8_t flags = 0;
+  uint64_t type = 0, length = 0;
+  size_t pos = 0;
+  bool ok = false;
+  auto next = [&] {
+    pos = in.offset;
+    ok = pos < in.inputLength && readTl(in, in.inputLength, type, length) == NDN_ERROR_success;
+  };
+
+  next();
+  if (ok && type == ndn_Tlv_MetaInfo) {
+    size_t metaEnd = in.offset + length;
+    uint64_t fieldType, fieldLength;
+    if (readTl(in, metaEnd, fieldType, fieldLength) == NDN_ERROR_success &&
+        fieldType == ndn_Tlv_FreshnessPeriod && fieldLength <= 8 &&
+        in.offset + fieldLength == metaEnd) {
+      flags |= HC_D_META_FRESHNESS;
+      e = writeOctet(out, fieldLength);
+      length = fieldLength;
+    }
+    else {
+      flags |= HC_D_META_OTHER;
+      in.offset = metaEnd - length;
+      e = ndn_TlvEncoder_writeVarNumber(&out, length);
+    }
+    if (e || (e = copyOctets(in, out, length))) {
+      return e;
+    }
+    next();
+  }
+  if (ok && type == ndn_Tlv_Content) {
+    flags |= HC_D_CONTENT;
+    if ((e = compressVarLen(in, out, length))) {
+      return e;
+    }
+    next();
+  }
+  if (!ok || type != ndn_Tlv_SignatureInfo) {
+    return NDN_ERROR_did_not_get_the_expected_TLV_type;
+  }
+  if ((e = compressSigInfo(dict, in, length, out, flags))) {
+    return e;
+  }
+  next();
+  if ((flags & HC_D_SIGINFO_MASK) != HC_D_SIGINFO_DIGEST && ok &&
+      type == ndn_Tlv_SignatureValue) {
+    flags |= HC_D_SIGVALUE;
+    if ((e = compressVarLen(in, out, length))) {
+      return e;
+    }
+    next();
+  }
+
+  in.offset = pos;
+  out.output->array[flagsPos] = flags;
+  return copyOctets(in, out, in.inputLength - in.offset);
+}
+
+ndn_Error
+decompressData(const Dict& dict, ndn_TlvDecoder& in, ndn_TlvEncoder& out)
+{
+  uint8_t flags;
+  ndn_Error e;
+  if ((e = readOctet(in, flags)) || (e = decompressName(dict, in, out))) {
+    return e;
+  }
+
+  switch (flags & HC_D_META_MASK) {
+    case HC_D_META_FRESHNESS: {
+      uint8_t length;
+      if (!(e = readOctet(in, length)) &&
+          !(e = ndn_TlvEncoder_writeTypeAndLength(&out, ndn_Tlv_MetaInfo,
+                  1 + ndn_TlvEncoder_sizeOfVarNumber(length) + length)) &&
+          !(e = ndn_TlvEncoder_writeTypeAndLength(&out, ndn_Tlv_FreshnessPeriod, length))) {
+        e = copyOctets(in, out, length);
+      }
+      break;
+    }
+    case HC_D_META_OTHER:
+      e = decompressVarLen(in, out, ndn_Tlv_MetaInfo);
+      break;
+  }
+  if (e) {
+    return e;
+  }
+  if ((flags & HC_D_CONTENT) && (e = decompressVarLen(in, out, ndn_Tlv_Content))) {
+    return e;
+  }
+
+  switch (flags & HC_D_SIGINFO_MASK) {
+    case HC_D_SIGINFO_DIGEST:
+      if (!(e = ndn_TlvEncoder_writeArray(&out, DIGEST_SIGINFO_TLV, sizeof(DIGEST_SIGINFO_TLV)))) {
+        e = copyOctets(in, out, 32);
+      }
+      break;
+    case HC_D_SIGINFO_KEYNAME:
+      e = writeNested(in, out, ndn_Tlv_SignatureInfo, [&] {
+        uint8_t sigType;
+        ndn_Error error;
+        if ((error = readOctet(in, sigType)) ||
+            (error = ndn_TlvEncoder_writeNonNegativeIntegerTlv(&out, ndn_Tlv_SignatureType,
+                                                               sigType))) {
+          return error;
+        }
+        return writeNested(in, out, ndn_Tlv_KeyLocator,
+                           [&] { return decompressName(dict, in, out); });
+      });
+      break;
+    case HC_D_SIGINFO_OTHER:
+      e = decompressVarLen(in, out, ndn_Tlv_SignatureInfo);
+      break;
+    default:
+      e = NDN_ERROR_header_type_is_out_of_range;
+      break;
+  }
+  if (e) {
+    return e;
+  }
+  if ((flags & HC_D_SIGVALUE) && (e = decompressVarLen(in, out, ndn_Tlv_SignatureValue))) {
+    return e;
+  }
+  return copyOctets(in, out, in.inputLength - in.offset);
+}
+
+} // anonymous namespace
+
+HeaderCodec::HeaderCodec(size_t dictCapacity)
+  : m_dict(new uint8_t[dictCapacity])
+  , m_dictCapacity(dictCapacity)
+  , m_dictSize(0)
+  , m_nPrefixes(0)
+{
+}
+
+HeaderCodec::~HeaderCodec() = default;
+
+bool
+HeaderCodec::addPrefix(const NameLite& prefix)
+{
+  if (prefix.size() == 0 || m_nPrefixes == 0xFF || m_dictSize >= m_dictCapacity) {
+    return false;
+  }
+
+  size_t room = std::min(m_dictCapacity - m_dictSize - 1, 0xFF);
+  DynamicUInt8ArrayLite outArr(&m_dict[m_dictSize + 1], room, nullptr);
+  ndn_TlvEncoder encoder;
+  ndn_TlvEncoder_initialize(&encoder, reinterpret_cast<ndn_DynamicUInt8Array*>(&outArr));
+  for (size_t i = 0; i < prefix.size(); ++i) {
+    const NameLite::Component& comp = prefix.get(i);
+    int type = comp.getType() == ndn_NameComponentType_OTHER_CODE ? comp.getOtherTypeCode()
+                                                                   : comp.getType();
+    const BlobLite& value = comp.getValue();
+    if (ndn_TlvEncoder_writeTypeAndLength(&encoder, type, value.size()) ||
+        ndn_TlvEncoder_writeArray(&encoder, value.buf(), value.size())) {
+      return false;
+    }
+  }
+
+  m_dict[m_dictSize] = encoder.offset;
+  m_dictSize += 1 + encoder.offset;
+  ++m_nPrefixes;
+  return true;
+}
+
+size_t
+HeaderCodec::compress(const uint8_t* pkt, size_t len, uint8_t* out, size_t outCap) const
+{
+  // compressed TLV-VALUE is written after headroom, then moved after its TLV-TYPE and TLV-LENGTH
+  static constexpr size_t HEADROOM = 4;
+  ndn_TlvDecoder decoder;
+  ndn_TlvDecoder_initialize(&decoder, pkt, len);
+  uint64_t type, length;
+  if (outCap <= HEADROOM || readTl(decoder, len, type, length) != NDN_ERROR_success ||
+      decoder.offset + length != len) {
+    return 0;
+  }
+
+  DynamicUInt8ArrayLite outArr(out + HEADROOM, std::min<size_t>(outCap - HEADROOM, 0xFFFF),
+                               nullptr);
+  ndn_TlvEncoder encoder;
+  ndn_TlvEncoder_initialize(&encoder, reinterpret_cast<ndn_DynamicUInt8Array*>(&outArr));
+  Dict dict{m_dict.get(), m_dictSize};
+  ndn_Error e;
+  switch (type) {
+    case ndn_Tlv_Interest:
+      type = HeaderCompressor_TT_Interest;
+      e = compressInterest(dict, decoder, encoder);
+      break;
+    case ndn_Tlv_Data:
+      type = HeaderCompressor_TT_Data;
+      e = compressData(dict, decoder, encoder);
+      break;
+    default:
+      return 0;
+  }
+
+  size_t valueLen = encoder.offset;
+  size_t tlSize = 1 + ndn_TlvEncoder_sizeOfVarNumber(valueLen);
+  if (e != NDN_ERROR_success || tlSize + valueLen >= len) {
+    return 0;
+  }
+  std::memmove(out + tlSize, out + HEADROOM, valueLen);
+  DynamicUInt8ArrayLite tlArr(out, tlSize, nullptr);
+  ndn_TlvEncoder_initialize(&encoder, reinterpret_cast<ndn_DynamicUInt8Array*>(&tlArr));
+  ndn_TlvEncoder_writeTypeAndLength(&encoder, type, valueLen);
+  return tlSize + valueLen;
+}
+
+size_t
+HeaderCodec::decompress(const uint8_t* pkt, size_t len, uint8_t* out, size_t outCap) const
+{
+  ndn_TlvDecoder decoder;
+  ndn_TlvDecoder_initialize(&decoder, pkt, len);
+  uint64_t type, length;
+  if (readTl(decoder, len, type, length) != NDN_ERROR_success || decoder.offset + length != len) {
+    return 0;
+  }
+
+  DynamicUInt8ArrayLite outArr(out, outCap, nullptr);
+  ndn_TlvEncoder encoder;
+  ndn_TlvEncoder_initialize(&encoder, reinterpret_cast<ndn_DynamicUInt8Array*>(&outArr));
+  Dict dict{m_dict.get(), m_dictSize};
+  ndn_Error e;
+  switch (type) {
+    case HeaderCompressor_TT_Interest:
+      e = writeNested(decoder, encoder, ndn_Tlv_Interest,
+                      [&] { return decompressInterest(dict, decoder, encoder); });
+      break;
+    case HeaderCompressor_TT_Data:
+      e = writeNested(decoder, encoder, ndn_Tlv_Data,
+                      [&] { return decompressData(dict, decoder, encoder); });
+      break;
+    default:
+      return 0;
+  }
+  return e == NDN_ERROR_success ? encoder.offset : 0;
+}
+
+HeaderCompressor::HeaderCompressor(Transport& inner, const HeaderCodec& codec)
+  : HeaderCompressor(inner, codec, Options())
+{
+}
+
+HeaderCompressor::HeaderCompressor(Transport& inner, const HeaderCodec& codec,
+                                   const Options& options)
+  : inner(inner)
+  , m_codec(codec)
+  , m_opts(options)
+  , m_buf(new uint8_t[options.bufSize])
+{
+}
+
+HeaderCompressor::~HeaderCompressor() = default;
+
+size_t
+HeaderCompressor::receive(uint8_t* buf, size_t bufSize, uint64_t& endpointId)
+{
+  while (true) {
+    size_t len = inner.receive(buf, bufSize, endpointId);
+    if (!HeaderCodec::isCompressed(buf, len)) {
+      if (len > 0) {
+        ++m_cnt.nRxPlain;
+      }
+      return len;
+    }
+
+    if (len <= m_opts.bufSize) {
+      std::memcpy(m_buf.get(), buf, len);
+      size_t pktLen = m_codec.decompress(m_buf.get(), len, buf, bufSize);
+      if (pktLen > 0) {
+        ++m_cnt.nRxCompressed;
+        return pktLen;
+      }
+    }
+    ++m_cnt.nRxErrors;
+    HC_DBG(F("decompress error len=") << len);
+  }
+}
+
+ndn_Error
+HeaderCompressor::send(const uint8_t* pkt, size_t len, uint64_t endpointId)
+{
+  size_t compLen = m_codec.compress(pkt, len, m_buf.get(), m_opts.bufSize);
+  if (compLen == 0) {
+    ++m_cnt.nTxPlain;
+    return inner.send(pkt, len, endpointId);
+  }
+  ++m_cnt.nTxCompressed;
+  m_cnt.nTxSaved += len - compLen;
+  return inner.send(m_buf.get(), compLen, endpointId);
+}
+
+} // namespace ndn
@@ -0,0 +1,154 @@
+#ifndef ESP8266NDN_HEADER_COMPRESSOR_HPP
+#define ESP8266NDN_HEADER_COMPRESSOR_HPP
+
+#include "transport.hpp"
+
+#include <memory>
+
+namespace ndn {
+
+class NameLite;
+
+enum {
+  HeaderCompressor_TT_Interest = 0xE5, ///< TLV-TYPE of compressed Interest
+  HeaderCompressor_TT_Data = 0xE6,     ///< TLV-TYPE of compressed Data
+};
+
+/** \brief a reversible codec that compresses Interest and Data headers
+ *
+ *  A compressed packet is a TLV element of type HeaderCompressor_TT_Interest or
+ *  HeaderCompressor_TT_Data, so that it can be batched and split like any other packet.
+ *  Its TLV-VALUE starts with a flags octet that indicates which fields are present, followed by:
+ *  \li Name, as a reference into the prefix dictionary and the remaining components.
+ *      Each component drops its TLV-TYPE if it is generic or of a common typed kind.
+ *  \li Fixed-size fields, such as Nonce and HopLimit, without TLV-TYPE and TLV-LENGTH.
+ *  \li Default fields, such as CanBePrefix and InterestLifetime=4000, as flag bits only.
+ *  \li Common SignatureInfo patterns: DigestSha256, or SignatureType with KeyLocator Name,
+ *      whose name is compressed against the prefix dictionary too.
+ *  \li Any remaining elements copied verbatim.
+ *
+ *  Decompression reproduces the original packet octet for octet. A packet that does not fit
+ *  the expected layout, such as one with non-minimal TLV-LENGTH, is left uncompressed.
+ *  Both ends must add the same prefixes in the same order.
+ */
+class HeaderCodec
+{
+public:
+  explicit
+  HeaderCodec(size_t dictCapacity = 128);
+
+  ~HeaderCodec();
+
+  /** \brief add a name prefix to the dictionary
+   *  \return whether success; false if dictionary is full or prefix encoding exceeds 255 octets
+   */
+  bool
+  addPrefix(const NameLite& prefix);
+
+  /** \brief compress an Interest or Data
+   *  \return compressed packet length, or zero if the packet is not compressible
+   *          or would not become shorter
+   */
+  size_t
+  compress(const uint8_t* pkt, size_t len, uint8_t* out, size_t outCap) const;
+
+  /** \brief decompress a packet produced by compress()
+   *  \return original packet length, or zero on error
+   */
+  size_t
+  decompress(const uint8_t* pkt, size_t len, uint8_t* out, size_t outCap) const;
+
+  /** \brief determine whether a packet is compressed
+   */
+  static bool
+  isCompressed(const uint8_t* pkt, size_t len)
+  {
+    return len > 0 && (pkt[0] == HeaderCompressor_TT_Interest ||
+                       pkt[0] == HeaderCompressor_TT_Data);
+  }
+
+private:
+  std::unique_ptr<uint8_t[]> m_dict; ///< entries of 1-octet length and encoded components
+  uint16_t m_dictCapacity;
+  uint16_t m_dictSize;
+  uint8_t m_nPrefixes;
+};
+
+/** \brief a transport wrapper that compresses Interest and Data headers
+ *
+ *  It should be placed next to the radio transport, such as over LoraScheduler or under BleLink,
+ *  where every octet costs airtime:
+ *  \code
+ *  ndn::HeaderCodec codec;
+ *  ndn::HeaderCompressor compressor(scheduler, codec);
+ *  ndn::Face face(compressor);
+ *  void setup() {
+ *    codec.addPrefix(..); // same prefixes on every node
+ *  }
+ *  \endcode
+ *  Outgoing packets are compressed if that makes them shorter; others, such as LpPacket,
+ *  are sent unchanged. Incoming packets are decompressed if they are compressed.
+ */
+class HeaderCompressor : public Transport
+{
+public:
+  class Options
+  {
+  public:
+    uint16_t bufSize = 512; ///< scratch buffer size, which limits compressed packet size
+  };
+
+  class Counters
+  {
+  public:
+    uint32_t nTxCompressed = 0; ///< packets sent compressed
+    uint32_t nTxPlain = 0;      ///< packets sent unchanged
+    uint32_t nTxSaved = 0;      ///< octets saved by compression
+    uint32_t nRxCompressed = 0; ///< compressed packets received
+    uint32_t nRxPlain = 0;      ///< uncompressed packets received
+    uint32_t nRxErrors = 0;     ///< compressed packets that cannot be decompressed
+  };
+
+  HeaderCompressor(Transport& inner, const HeaderCodec& codec);
+
+  HeaderCompressor(Transport& inner, const HeaderCodec& codec, const Options& options);
+
+  ~HeaderCompressor();
+
+  size_t
+  receive(uint8_t* buf, size_t bufSize, uint64_t& endpointId) final;
+
+  ndn_Error
+  send(const uint8_t* pkt, size_t len, uint64_t endpointId) final;
+
+  size_t
+  getMtu() const final
+  {
+    return inner.getMtu();
+  }
+
+  bool
+  isTxReady() final
+  {
+    return inner.isTxReady();
+  }
+
+  const Counters&
+  getCounters() const
+  {
+    return m_cnt;
+  }
+
+public:
+  Transport& inner;
+
+private:
+  const HeaderCodec& m_codec;
+  Options m_opts;
+  std::unique_ptr<uint8_t[]> m_buf;
+  Counters m_cnt;
+};
+
+} // namespace ndn
+
+#endif // ESP8266NDN_HEADER_COMPRESSOR_HPP
@@ -5,27 +5,58 @@
 
 namespace ndn {
 
-struct __attribute__((packed)) ReassHdr
-{
-  uint16_t len;
-  uint8_t b0;
-  uint16_t id;
-  uint8_t payload[0];
-};
-
 enum {
   LiteFragHdr_b0_HB = 0x80,
   LiteFragHdr_b0_MF = 0x20,
   LiteFragHdr_b0_SEQ_MASK = 0x1F,
+  LiteFragHdr_SIZE = 3,
+  LiteFrag_MAX_FRAGS = LiteFragHdr_b0_SEQ_MASK + 1,
+};
+
+struct LiteFrag::Context
+{
+  bool
+  isActive() const
+  {
+    return buf != nullptr && bitmap != 0;
+  }
+
+  bool
+  hasLast() const
+  {
+    return lastSeq < LiteFrag_MAX_FRAGS;
+  }
+
+  void
+  reset()
+  {
+    bitmap = 0;
+    fragSize = 0;
+    lastLen = 0;
+    lastSeq = 0xFF;
+    isLastParked = false;
+  }
+
+  uint8_t* buf = nullptr;   ///< reassembly buffer, m_rbufSize octets
+  uint64_t endpointId = 0;
+  unsigned long deadline = 0;
+  uint32_t bitmap = 0;      ///< received fragments; zero means context is unused
+  uint16_t id = 0;
+  uint16_t fragSize = 0;    ///< payload size of non-last fragments; zero if unknown
+  uint16_t lastLen = 0;     ///< payload size of last fragment
+  uint8_t lastSeq = 0xFF;   ///< seq of last fragment; 0xFF if unknown
+  bool isLastParked = false; ///< last fragment is stored at buffer tail because fragSize is unknown
 };
 
 LiteFrag::LiteFrag(Transport& inner)
   : inner(inner)
+  , m_ctx(nullptr)
+  , m_nContexts(0)
   , m_rbuf(nullptr)
   , m_rbufSize(0)
-  , m_offset(0)
-  , m_id(0)
-  , m_nextSeq(0)
+  , m_reassTimeout(0)
+  , m_tbuf(nullptr)
+  , m_tbufSize(0)
 {
 }
 
@@ -35,11 +66,19 @@ LiteFrag::~LiteFrag()
 }
 
 void
-LiteFrag::begin(size_t reassBufSize, size_t txBufSize)
+LiteFrag::begin(size_t reassBufSize, size_t txBufSize, int nContexts, unsigned long reassTimeout)
 {
-  m_rbuf = reinterpret_cast<uint8_t*>(malloc(reassBufSize));
+  end();
+  m_nContexts = std::max(nContexts, 1);
+  m_ctx = new Context[m_nContexts];
+  m_rbuf = reinterpret_cast<uint8_t*>(malloc(reassBufSize * m_nContexts));
   m_rbufSize = reassBufSize;
-  m_offset = 0;
+  m_reassTimeout = reassTimeout;
+  if (m_rbuf != nullptr) {
+    for (int i = 0; i < m_nContexts; ++i) {
+      m_ctx[i].buf = m_rbuf + i * reassBufSize;
+    }
+  }
   m_tbuf = reinterpret_cast<uint8_t*>(malloc(txBufSize));
   m_tbufSize = txBufSize;
 }
@@ -47,6 +86,11 @@ LiteFrag::begin(size_t reassBufSize, size_t txBufSize)
 void
 LiteFrag::end()
 {
+  if (m_ctx != nullptr) {
+    delete[] m_ctx;
+    m_ctx = nullptr;
+    m_nContexts = 0;
+  }
   if (m_rbuf != nullptr) {
     free(m_rbuf);
     m_rbuf = nullptr;
@@ -59,83 +103,179 @@ LiteFrag::end()
 
 size_t
 LiteFrag::receive(uint8_t* buf, size_t bufSize, uint64_t& endpointId)
+{
+  size_t len = 0;
+  const uint8_t* pkt = nullptr;
+  while ((pkt = this->receiveInPlace(buf, bufSize, len, endpointId)) != nullptr) {
+    if (len <= bufSize) {
+      memcpy(buf, pkt, len);
+      return len;
+    }
+    LITEFRAG_DBG(F("receive err=no-room size=") << len);
+  }
+  return 0;
+}
+
+const uint8_t*
+LiteFrag::receiveInPlace(uint8_t* buf, size_t bufSize, size_t& len, uint64_t& endpointId)
 {
   if (m_rbuf == nullptr) {
     LITEFRAG_DBG(F("receive err=no-buffer"));
-    return 0;
+    return nullptr;
   }
 
+  unsigned long now = getClock().getMillis();
+  this->expireContexts(now);
+
   while (true) {
-    ReassHdr* hdr = reinterpret_cast<ReassHdr*>(m_rbuf + m_offset);
-    size_t room = m_rbufSize - m_offset - sizeof(hdr->len);
-    uint8_t* fragBuf = &hdr->b0;
-    uint16_t fragLen = static_cast<uint16_t>(inner.receive(fragBuf, room, endpointId));
+    size_t fragLen = inner.receive(buf, bufSize, endpointId);
     if (fragLen == 0) { // no incoming packet
-      return 0;
+      return nullptr;
     }
-    if ((hdr->b0 & LiteFragHdr_b0_HB) == 0) { // no header bit
+    if (fragLen <= LiteFragHdr_SIZE || (buf[0] & LiteFragHdr_b0_HB) == 0) { // no header bit
       continue;
     }
-    memcpy(&hdr->len, &fragLen, sizeof(hdr->len));
-    uint16_t totalLen = sizeof(hdr->len) + fragLen;
 
+    uint8_t seq = buf[0] & LiteFragHdr_b0_SEQ_MASK;
+    bool isLast = (buf[0] & LiteFragHdr_b0_MF) != 0;
     uint16_t id;
-    memcpy(&id, &hdr->id, sizeof(id));
-    uint8_t seq = hdr->b0 & LiteFragHdr_b0_SEQ_MASK;
-
-    if (seq == 0) {
-      if (m_offset != 0) {
-        LITEFRAG_DBG(F("discard-incomplete id=") << m_id << F(" frags=") << m_nextSeq);
-        memmove(m_rbuf, hdr, totalLen);
-        hdr = reinterpret_cast<ReassHdr*>(m_rbuf);
-        m_offset = 0;
-      }
+    memcpy(&id, &buf[1], sizeof(id));
+
+    Context* ctx = this->findContext(endpointId, id, now);
+    if ((ctx->bitmap & (1UL << seq)) != 0) {
+      ++m_cnt.nDupFrags;
+      continue;
     }
-    else if (id != m_id || seq != m_nextSeq) {
-      LITEFRAG_DBG(F("drop-ooo want=(") << m_id << "," << m_nextSeq <<
-                   F(") got=(") << id << "," << seq << ")");
+    if (!this->placeFragment(*ctx, seq, isLast, buf + LiteFragHdr_SIZE, fragLen - LiteFragHdr_SIZE)) {
+      LITEFRAG_DBG(F("drop-bad id=") << id << F(" seq=") << seq);
+      ++m_cnt.nBadFrags;
+      continue;
+    }
+
+    size_t size = this->getCompleteSize(*ctx);
+    if (size == 0) {
       continue;
     }
 
-    // accept
-    m_offset += totalLen;
-    m_id = id;
-    m_nextSeq = seq + 1;
+    // context is freed, but its buffer is not overwritten until the next fragment arrives
+    ctx->reset();
+    len = size;
+    endpointId = ctx->endpointId;
+    ++m_cnt.nReassembled;
+    LITEFRAG_DBG(F("reassemble id=") << id << F(" size=") << size);
+    return ctx->buf;
+  }
+  return nullptr;
+}
 
-    if ((hdr->b0 & LiteFragHdr_b0_MF) != 0) { // last frag
-      size_t size = reassemble(buf, bufSize);
-      m_offset = 0;
-      return size;
+LiteFrag::Context*
+LiteFrag::findContext(uint64_t endpointId, uint16_t id, unsigned long now)
+{
+  Context* freeCtx = nullptr;
+  Context* oldestCtx = nullptr;
+  for (int i = 0; i < m_nContexts; ++i) {
+    Context& ctx = m_ctx[i];
+    if (!ctx.isActive()) {
+      freeCtx = &ctx;
+      continue;
+    }
+    if (ctx.endpointId == endpointId && ctx.id == id) {
+      return &ctx;
+    }
+    if (oldestCtx == nullptr || static_cast<long>(ctx.deadline - oldestCtx->deadline) < 0) {
+      oldestCtx = &ctx;
     }
   }
-  return 0;
+
+  Context* ctx = freeCtx;
+  if (ctx == nullptr) {
+    LITEFRAG_DBG(F("evict id=") << oldestCtx->id);
+    ++m_cnt.nEvictions;
+    ctx = oldestCtx;
+  }
+  ctx->reset();
+  ctx->endpointId = endpointId;
+  ctx->id = id;
+  ctx->deadline = now + m_reassTimeout;
+  return ctx;
 }
 
-size_t
-LiteFrag::reassemble(uint8_t* buf, size_t bufSize)
+void
+LiteFrag::expireContexts(unsigned long now)
 {
-  int nFrags = 0;
-  size_t size = 0;
-  for (size_t offset = 0; offset < m_offset;) {
-    ReassHdr* hdr = reinterpret_cast<ReassHdr*>(m_rbuf + offset);
-    uint16_t fragLen;
-    memcpy(&fragLen, &hdr->len, sizeof(fragLen));
-    uint16_t payloadLen = fragLen - 3;
-    uint16_t totalLen = sizeof(hdr->len) + fragLen;
+  for (int i = 0; i < m_nContexts; ++i) {
+    Context& ctx = m_ctx[i];
+    if (ctx.isActive() && static_cast<long>(now - ctx.deadline) >= 0) {
+      LITEFRAG_DBG(F("timeout id=") << ctx.id);
+      ++m_cnt.nTimeouts;
+      ctx.reset();
+    }
+  }
+}
 
-    if (payloadLen > size - bufSize) {
-      LITEFRAG_DBG(F("reassemble err=no-room"));
-      return 0;
+bool
+LiteFrag::placeFragment(Context& ctx, uint8_t seq, bool isLast, const uint8_t* payload, uint16_t payloadLen)
+{
+  if (isLast) {
+    if (ctx.hasLast() || (ctx.bitmap >> seq) != 0) { // another last fragment, or fragment after last
+      ctx.reset();
+      return false;
     }
+    ctx.lastSeq = seq;
+    ctx.lastLen = payloadLen;
+    if (seq > 0 && ctx.fragSize == 0) {
+      // offset is unknown until a non-last fragment arrives; park at buffer tail
+      if (payloadLen > m_rbufSize) {
+        ctx.reset();
+        return false;
+      }
+      memcpy(ctx.buf + m_rbufSize - payloadLen, payload, payloadLen);
+      ctx.isLastParked = true;
+      ctx.bitmap |= 1UL << seq;
+      return true;
+    }
+  }
+  else {
+    if (payloadLen == 0 || (ctx.hasLast() && seq >= ctx.lastSeq) ||
+        (ctx.fragSize != 0 && payloadLen != ctx.fragSize)) {
+      ctx.reset();
+      return false;
+    }
+    if (ctx.fragSize == 0) {
+      ctx.fragSize = payloadLen;
+      if (ctx.isLastParked) {
+        size_t lastOffset = static_cast<size_t>(ctx.lastSeq) * ctx.fragSize;
+        if (lastOffset + ctx.lastLen > m_rbufSize) {
+          ctx.reset();
+          return false;
+        }
+        memmove(ctx.buf + lastOffset, ctx.buf + m_rbufSize - ctx.lastLen, ctx.lastLen);
+        ctx.isLastParked = false;
+      }
+    }
+  }
 
-    memcpy(buf + size, hdr->payload, payloadLen);
-    size += payloadLen;
-    offset += totalLen;
-    ++nFrags;
+  size_t offset = static_cast<size_t>(seq) * ctx.fragSize;
+  if (offset + payloadLen > m_rbufSize) {
+    ctx.reset();
+    return false;
   }
+  memcpy(ctx.buf + offset, payload, payloadLen);
+  ctx.bitmap |= 1UL << seq;
+  return true;
+}
 
-  LITEFRAG_DBG(F("reassemble id=") << m_id << F(" frags=") << nFrags);
-  return size;
+size_t
+LiteFrag::getCompleteSize(const Context& ctx) const
+{
+  if (!ctx.hasLast() || ctx.isLastParked) {
+    return 0;
+  }
+  uint32_t want = ctx.lastSeq == LiteFrag_MAX_FRAGS - 1 ? 0xFFFFFFFF : (1UL << (ctx.lastSeq + 1)) - 1;
+  if (ctx.bitmap != want) {
+    return 0;
+  }
+  return static_cast<size_t>(ctx.lastSeq) * ctx.fragSize + ctx.lastLen;
 }
 
 ndn_Error
@@ -146,20 +286,26 @@ LiteFrag::send(const uint8_t* pkt, size_t len, uint64_t endpointId)
     return NDN_ERROR_SocketTransport_cannot_connect_to_socket;
   }
 
+  size_t fragPayload = m_tbufSize - LiteFragHdr_SIZE;
+  if (len > fragPayload * LiteFrag_MAX_FRAGS) {
+    LITEFRAG_DBG(F("send err=too-many-frags len=") << len);
+    return NDN_ERROR_TLV_length_exceeds_buffer_length;
+  }
+
   uint16_t id = random(0xFFFF);
   int seq = 0;
   for (size_t offset = 0; offset < len;) {
-    size_t payloadLen = std::min(len - offset, m_tbufSize - 3);
+    size_t payloadLen = std::min(len - offset, fragPayload);
     m_tbuf[0] = LiteFragHdr_b0_HB | (seq++ & LiteFragHdr_b0_SEQ_MASK);
     memcpy(m_tbuf + 1, &id, sizeof(id));
-    memcpy(m_tbuf + 3, pkt + offset, payloadLen);
+    memcpy(m_tbuf + LiteFragHdr_SIZE, pkt + offset, payloadLen);
 
     offset += payloadLen;
     if (offset == len) {
       m_tbuf[0] |= LiteFragHdr_b0_MF;
     }
 
-    ndn_Error err = inner.send(m_tbuf, 3 + payloadLen, endpointId);
+    ndn_Error err = inner.send(m_tbuf, LiteFragHdr_SIZE + payloadLen, endpointId);
     if (err != NDN_ERROR_success) {
       LITEFRAG_DBG(F("send id=") << id << F(" seq=") << seq << F(" err=") << err);
       return err;
@@ -168,6 +314,7 @@ LiteFrag::send(const uint8_t* pkt, size_t len, uint64_t endpointId)
   }
 
   LITEFRAG_DBG(F("send id=") << id << F(" seqs=") << seq);
+  return NDN_ERROR_success;
 }
 
-} // namespace ndn
\ No newline at end of file
+} // namespace ndn
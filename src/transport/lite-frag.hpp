@@ -11,17 +11,31 @@ namespace ndn {
 class LiteFrag : public Transport
 {
 public:
+  /** \brief reassembly counters
+   */
+  class Counters
+  {
+  public:
+    uint32_t nReassembled = 0; ///< packets reassembled and delivered
+    uint32_t nDupFrags = 0;    ///< duplicate fragments discarded
+    uint32_t nBadFrags = 0;    ///< fragments inconsistent with their context, or too large
+    uint32_t nTimeouts = 0;    ///< partial packets discarded due to timeout
+    uint32_t nEvictions = 0;   ///< partial packets discarded to make room for another packet
+  };
+
   explicit
   LiteFrag(Transport& inner);
 
   ~LiteFrag();
 
   /** \begin allocate buffers
-   *  \param reassBufSize reassembly buffer size to store fragments of a packet
+   *  \param reassBufSize reassembly buffer size, which is the max size of a reassembled packet
    *  \param txBufSize transmission buffer size to store one outgoing fragment
+   *  \param nContexts number of packets that can be reassembled concurrently
+   *  \param reassTimeout partial packet lifetime, in millis
    */
   void
-  begin(size_t reassBufSize, size_t txBufSize);
+  begin(size_t reassBufSize, size_t txBufSize, int nContexts = 1, unsigned long reassTimeout = 5000);
 
   /** \begin release buffers
    */
@@ -30,33 +44,76 @@ public:
 
   /** \begin receive a reassembled packet
    *
-   *  Current implementation only accommodates in-order delivery;
-   *  out-of-order fragments will be dropped.
+   *  Fragments of up to \p nContexts packets, keyed by (endpointId, id), may arrive
+   *  interleaved and in any order. Each fragment is placed at its final offset in the
+   *  reassembly buffer, tracked in a bitmap. A partial packet is discarded upon timeout, or
+   *  when its context is needed by a new packet and it is the oldest.
+   *
+   *  \p buf is used as scratch space to receive fragments. The reassembled packet is copied
+   *  into \p buf; use receiveInPlace() to avoid this copy.
    */
   size_t
   receive(uint8_t* buf, size_t bufSize, uint64_t& endpointId) final;
 
+  /** \begin receive a reassembled packet in place
+   *  \param buf scratch space to receive fragments
+   *  \param bufSize scratch space size, which only needs to fit one fragment
+   *  \param[out] len packet length
+   *  \param[out] endpointId identifier of the remote endpoint
+   *  \return packet in the reassembly buffer, or nullptr if no packet available
+   *
+   *  The packet stays valid until the next receive(), receiveInPlace(), or end() call.
+   *  It can be parsed with PacketBuffer::parse(pkt, len).
+   */
+  const uint8_t*
+  receiveInPlace(uint8_t* buf, size_t bufSize, size_t& len, uint64_t& endpointId);
+
   /** \begin transmit fragments of a packet
    */
   ndn_Error
   send(const uint8_t* pkt, size_t len, uint64_t endpointId) final;
 
+  const Counters&
+  getCounters() const
+  {
+    return m_cnt;
+  }
+
 private:
+  struct Context;
+
+  Context*
+  findContext(uint64_t endpointId, uint16_t id, unsigned long now);
+
+  void
+  expireContexts(unsigned long now);
+
+  /** \brief place a fragment into context
+   *  \return whether fragment is accepted
+   */
+  bool
+  placeFragment(Context& ctx, uint8_t seq, bool isLast, const uint8_t* payload, uint16_t payloadLen);
+
+  /** \brief determine reassembled size if all fragments have arrived
+   *  \return reassembled size, or zero if incomplete
+   */
   size_t
-  reassemble(uint8_t* buf, size_t bufSize);
+  getCompleteSize(const Context& ctx) const;
 
 public:
   Transport& inner;
 
 private:
+  Context* m_ctx;
+  int m_nContexts;
   uint8_t* m_rbuf;
   size_t m_rbufSize;
-  size_t m_offset;
-  uint16_t m_id;
-  uint8_t m_nextSeq;
+  unsigned long m_reassTimeout;
 
   uint8_t* m_tbuf;
   size_t m_tbufSize;
+
+  Counters m_cnt;
 };
 
 } // namespace ndn
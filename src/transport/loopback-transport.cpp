@@ -5,31 +5,107 @@
 
 namespace ndn {
 
+struct LoopbackTransport::Slot
+{
+  uint8_t pkt[LOOPBACKTRANSPORT_PKTSIZE];
+  size_t len = 0; ///< packet size; zero means slot is unused
+  uint64_t endpointId = 0;
+  unsigned long arrival = 0;
+  uint32_t seq = 0;
+};
+
+static bool
+chance(float p)
+{
+  if (p <= 0.0) {
+    return false;
+  }
+  return random(0x10000) < static_cast<long>(p * 0x10000);
+}
+
 LoopbackTransport::LoopbackTransport()
   : m_other(nullptr)
-  , m_len(0)
+  , m_slots(nullptr)
+  , m_isBad(false)
+  , m_linkFreeAt(0)
+  , m_arrivalSeq(0)
 {
 }
 
+LoopbackTransport::~LoopbackTransport()
+{
+  delete[] m_slots;
+}
+
 void
 LoopbackTransport::begin(LoopbackTransport& other)
+{
+  LinkOptions options;
+  options.capacity = 1;
+  begin(other, options);
+}
+
+void
+LoopbackTransport::begin(LoopbackTransport& other, const LinkOptions& options)
 {
   m_other = &other;
   other.m_other = this;
+  setLinkOptions(options);
+  other.setLinkOptions(options);
+}
+
+void
+LoopbackTransport::setLinkOptions(const LinkOptions& options)
+{
+  delete[] m_slots;
+  m_opts = options;
+  if (m_opts.capacity < 1) {
+    m_opts.capacity = 1;
+  }
+  m_slots = new Slot[m_opts.capacity];
+  m_isBad = false;
+  m_linkFreeAt = now();
+}
+
+unsigned long
+LoopbackTransport::now() const
+{
+  return (m_opts.clock == nullptr ? getClock() : *m_opts.clock).getMicros();
 }
 
 size_t
 LoopbackTransport::receive(uint8_t* buf, size_t bufSize, uint64_t& endpointId)
 {
-  if (m_len == 0) {
+  if (m_slots == nullptr) {
     return 0;
   }
 
-  memcpy(buf, m_pkt, min(m_len, bufSize));
-  endpointId = m_endpointId;
+  unsigned long t = now();
+  Slot* next = nullptr;
+  for (int i = 0; i < m_opts.capacity; ++i) {
+    Slot& slot = m_slots[i];
+    if (slot.len == 0 || static_cast<long>(t - slot.arrival) < 0) {
+      continue;
+    }
+    if (next == nullptr) {
+      next = &slot;
+      continue;
+    }
+    long diff = static_cast<long>(slot.arrival - next->arrival);
+    if (diff < 0 || (diff == 0 && static_cast<int32_t>(slot.seq - next->seq) < 0)) {
+      next = &slot;
+    }
+  }
+  if (next == nullptr) {
+    return 0;
+  }
 
-  size_t len = m_len;
-  m_len = 0;
+  memcpy(buf, next->pkt, min(next->len, bufSize));
+  endpointId = next->endpointId;
+
+  size_t len = next->len;
+  next->len = 0;
+  ++m_cnt.nRx;
   return len;
 }
 
@@ -41,15 +117,67 @@ LoopbackTransport::send(const uint8_t* pkt, size_t len, uint64_t endpointId)
     return NDN_ERROR_SocketTransport_socket_is_not_open;
   }
 
-  if (m_other->m_len > 0) {
+  ndn_Error error = m_other->enqueue(pkt, len, endpointId);
+  if (error == NDN_ERROR_success) {
+    ++m_cnt.nTx;
+  }
+  return error;
+}
+
+bool
+LoopbackTransport::shouldLose()
+{
+  if (m_isBad) {
+    m_isBad = !chance(m_opts.pBadToGood);
+  }
+  else {
+    m_isBad = chance(m_opts.pGoodToBad);
+  }
+  return chance(m_isBad ? m_opts.lossBad : m_opts.lossGood);
+}
+
+ndn_Error
+LoopbackTransport::enqueue(const uint8_t* pkt, size_t len, uint64_t endpointId)
+{
+  if (this->shouldLose()) {
+    ++m_cnt.nLost;
+    return NDN_ERROR_success;
+  }
+
+  Slot* slot = nullptr;
+  for (int i = 0; i < m_opts.capacity && slot == nullptr; ++i) {
+    if (m_slots[i].len == 0) {
+      slot = &m_slots[i];
+    }
+  }
+  if (slot == nullptr) {
+    ++m_cnt.nDropFull;
     LOOPBACKTRANSPORT_DBG("receiver is congested");
     return NDN_ERROR_SocketTransport_error_in_send;
   }
 
-  m_other->m_len = min(len, static_cast<size_t>(LOOPBACKTRANSPORT_PKTSIZE));
-  memcpy(m_other->m_pkt, pkt, m_other->m_len);
-  m_other->m_endpointId = endpointId;
+  unsigned long t = now();
+  if (chance(m_opts.reorder)) {
+    ++m_cnt.nReordered;
+    slot->arrival = t;
+  }
+  else {
+    unsigned long depart = static_cast<long>(m_linkFreeAt - t) > 0 ? m_linkFreeAt : t;
+    if (m_opts.bandwidth > 0) {
+      depart += static_cast<unsigned long>(static_cast<uint64_t>(len) * 1000000 / m_opts.bandwidth);
+    }
+    m_linkFreeAt = depart;
+    slot->arrival = depart + m_opts.delay;
+    if (m_opts.jitter > 0) {
+      slot->arrival += random(m_opts.jitter + 1);
+    }
+  }
+
+  slot->len = min(len, static_cast<size_t>(LOOPBACKTRANSPORT_PKTSIZE));
+  memcpy(slot->pkt, pkt, slot->len);
+  slot->endpointId = endpointId;
+  slot->seq = m_arrivalSeq++;
   return NDN_ERROR_success;
 }
 
-} // namespace ndn
\ No newline at end of file
+} // namespace ndn
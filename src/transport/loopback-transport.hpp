@@ -2,6 +2,7 @@
 #define ESP8266NDN_LOOPBACK_TRANSPORT_HPP
 
 #include "transport.hpp"
+#include "../core/clock.hpp"
 
 namespace ndn {
 
@@ -11,28 +12,108 @@ namespace ndn {
 
 /** \brief a transport that talks to another LoopbackTransport
  *
- *  This transport can store one packet. Additional received packets are lost.
+ *  By default, this transport can store one packet, and send() fails if the peer has not
+ *  received the previous packet. With \c LinkOptions, it stores up to \c LinkOptions::capacity
+ *  packets, and can emulate delay, jitter, loss, bandwidth limit, and reordering.
  */
 class LoopbackTransport : public Transport
 {
 public:
+  /** \brief link emulation options, applied to packets received by a LoopbackTransport
+   *
+   *  Loss follows a Gilbert-Elliott model: the link is either in good state or bad state, and
+   *  changes state before each packet with probability \c pGoodToBad or \c pBadToGood.
+   *  Each packet is lost with probability \c lossGood or \c lossBad depending on the state.
+   *  For Bernoulli loss, set \c lossGood to the loss rate and keep \c pGoodToBad at zero.
+   */
+  class LinkOptions
+  {
+  public:
+    uint16_t capacity = 16;  ///< max packets queued toward the receiver
+    uint32_t delay = 0;      ///< fixed one-way delay, in micros
+    uint32_t jitter = 0;     ///< max additional random delay, in micros
+    uint32_t bandwidth = 0;  ///< bandwidth in octets per second, zero means unlimited
+    float lossGood = 0.0;    ///< loss rate in good state
+    float lossBad = 1.0;     ///< loss rate in bad state
+    float pGoodToBad = 0.0;  ///< transition probability from good state to bad state
+    float pBadToGood = 1.0;  ///< transition probability from bad state to good state
+    float reorder = 0.0;     ///< probability that a packet skips delay and overtakes queued packets
+    Clock* clock = nullptr;  ///< time source for delay and bandwidth, nullptr means getClock()
+  };
+
+  class Counters
+  {
+  public:
+    uint32_t nTx = 0;       ///< packets accepted by send()
+    uint32_t nRx = 0;       ///< packets returned by receive()
+    uint32_t nLost = 0;     ///< packets lost due to loss emulation
+    uint32_t nDropFull = 0; ///< packets dropped because receiver queue is full
+    uint32_t nReordered = 0; ///< packets that skipped delay
+  };
+
   LoopbackTransport();
 
+  ~LoopbackTransport();
+
+  /** \brief connect to another LoopbackTransport, storing one packet in each direction
+   */
   void
   begin(LoopbackTransport& other);
 
+  /** \brief connect to another LoopbackTransport, with link emulation in both directions
+   */
+  void
+  begin(LoopbackTransport& other, const LinkOptions& options);
+
+  /** \brief change link emulation for packets received by this transport
+   *
+   *  Queued packets are discarded.
+   */
+  void
+  setLinkOptions(const LinkOptions& options);
+
   size_t
   receive(uint8_t* buf, size_t bufSize, uint64_t& endpointId) final;
 
   ndn_Error
   send(const uint8_t* pkt, size_t len, uint64_t endpointId) final;
 
+  size_t
+  getMtu() const final
+  {
+    return LOOPBACKTRANSPORT_PKTSIZE;
+  }
+
+  const Counters&
+  getCounters() const
+  {
+    return m_cnt;
+  }
+
 private:
-  LoopbackTransport* m_other;
+  struct Slot;
+
+  unsigned long
+  now() const;
+
+  /** \brief decide whether to lose a packet, and advance loss model
+   */
+  bool
+  shouldLose();
 
-  uint8_t m_pkt[LOOPBACKTRANSPORT_PKTSIZE]; ///< received packet
-  size_t m_len; ///< packet size
-  uint64_t m_endpointId; ///< packet endpointId
+  /** \brief enqueue a packet sent by peer
+   */
+  ndn_Error
+  enqueue(const uint8_t* pkt, size_t len, uint64_t endpointId);
+
+private:
+  LoopbackTransport* m_other;
+  LinkOptions m_opts;
+  Slot* m_slots; ///< received packets
+  bool m_isBad; ///< Gilbert-Elliott state
+  unsigned long m_linkFreeAt; ///< when link finishes transmitting queued packets
+  uint32_t m_arrivalSeq; ///< incremented per enqueued packet, to keep FIFO order among equal arrival times
+  Counters m_cnt;
 };
 
 } // namespace ndn
@@ -0,0 +1,208 @@
+#include "lora-scheduler.hpp"
+#include "header-compressor.hpp"
+#include "../core/logger.hpp"
+#include "../ndn-cpp/c/encoding/tlv/tlv.h"
+
+#include <algorithm>
+#include <cstring>
+
+#define LORASCHEDULER_DBG(...) DBG(LoraScheduler, __VA_ARGS__)
+
+namespace ndn {
+
+enum {
+  LoraScheduler_MAX_PKT_SIZE = 255,
+};
+
+uint32_t
+LoraRadioParams::computeAirtime(size_t len) const
+{
+  int sf = spreadingFactor;
+  // low data rate optimization is mandated when symbol duration reaches 16ms
+  bool isLowDataRate = (1000000ULL << sf) / bandwidth >= 16000;
+
+  int num = 8 * static_cast<int>(len) - 4 * sf + 28 + 16 * hasCrc - 20 * isImplicitHeader;
+  int den = 4 * (sf - 2 * isLowDataRate);
+  int nPayloadSymbols = 8 + std::max((num + den - 1) / den, 0) * codingRate;
+
+  // count in quarter symbols, because preamble has 4.25 more symbols than configured
+  uint64_t nQuarterSymbols = 4 * preambleLength + 17 + 4 * nPayloadSymbols;
+  return (nQuarterSymbols * 1000000 << sf) / (4ULL * bandwidth);
+}
+
+uint32_t
+LoraRadioParams::computeSymbolTime() const
+{
+  return (1000000ULL << spreadingFactor) / bandwidth;
+}
+
+DutyCycleBudget::DutyCycleBudget(float dutyCycle, uint32_t burst)
+  : m_dutyCycle(dutyCycle > 0.0 && dutyCycle < 1.0 ? dutyCycle : 1.0)
+  , m_tolerance(burst / m_dutyCycle)
+  , m_tat(0)
+  , m_isActive(false)
+{
+}
+
+unsigned long
+DutyCycleBudget::getWait() const
+{
+  if (!m_isActive) {
+    return 0;
+  }
+  long wait = static_cast<long>(m_tat - m_tolerance - getClock().getMillis());
+  return wait > 0 ? wait : 0;
+}
+
+void
+DutyCycleBudget::consume(uint32_t airtime)
+{
+  unsigned long now = getClock().getMillis();
+  if (!m_isActive || static_cast<long>(m_tat - now) < 0) {
+    m_tat = now;
+    m_isActive = true;
+  }
+  m_tat += static_cast<unsigned long>(airtime / (1000.0 * m_dutyCycle) + 0.999);
+}
+
+struct LoraSchedulerBase::Slot
+{
+  uint8_t pkt[LoraScheduler_MAX_PKT_SIZE];
+  uint8_t len = 0; ///< zero means slot is unused
+  bool isInterest = false;
+  uint32_t seq = 0;
+  uint64_t endpointId = 0;
+};
+
+LoraSchedulerBase::LoraSchedulerBase(Transport& inner, const Options& options)
+  : m_inner(inner)
+  , m_opts(options)
+  , m_budget(options.dutyCycle, options.burst)
+  , m_slots(new Slot[std::max<uint8_t>(options.nSlots, 1)])
+  , m_seq(0)
+  , m_isWaitingBudget(false)
+{
+  m_opts.nSlots = std::max<uint8_t>(m_opts.nSlots, 1);
+}
+
+LoraSchedulerBase::~LoraSchedulerBase() = default;
+
+size_t
+LoraSchedulerBase::receive(uint8_t* buf, size_t bufSize, uint64_t& endpointId)
+{
+  loop();
+  return m_inner.receive(buf, bufSize, endpointId);
+}
+
+ndn_Error
+LoraSchedulerBase::send(const uint8_t* pkt, size_t len, uint64_t endpointId)
+{
+  if (len == 0 || len > LoraScheduler_MAX_PKT_SIZE) {
+    return NDN_ERROR_TLV_length_exceeds_buffer_length;
+  }
+
+  for (uint8_t i = 0; i < m_opts.nSlots; ++i) {
+    Slot& slot = m_slots[i];
+    if (slot.len == 0) {
+      std::memcpy(slot.pkt, pkt, len);
+      slot.len = len;
+      slot.isInterest = pkt[0] == ndn_Tlv_Interest || pkt[0] == HeaderCompressor_TT_Interest;
+      slot.seq = ++m_seq;
+      slot.endpointId = endpointId;
+      return NDN_ERROR_success;
+    }
+  }
+
+  ++m_cnt.nQueueFull;
+  LORASCHEDULER_DBG(F("queue full len=") << len);
+  return NDN_ERROR_SocketTransport_error_in_send;
+}
+
+void
+LoraSchedulerBase::loop()
+{
+  Slot* slot = nextSlot();
+  if (slot == nullptr || !m_inner.isTxReady() || (m_backoff.isSet() && !m_backoff.hasExpired())) {
+    return;
+  }
+  m_backoff.clear();
+
+  if (m_budget.getWait() > 0) {
+    if (!m_isWaitingBudget) {
+      m_isWaitingBudget = true;
+      ++m_cnt.nBudgetWaits;
+    }
+    return;
+  }
+  m_isWaitingBudget = false;
+
+  if (m_opts.lbtThreshold != 0) {
+    if (!m_listen.isSet()) {
+      startListen();
+      // round up, and add one because Deadline has millisecond granularity
+      m_listen = Deadline::in((m_opts.radio.computeSymbolTime() + 999) / 1000 + 1);
+      return;
+    }
+    if (!m_listen.hasExpired()) {
+      return;
+    }
+    m_listen.clear();
+
+    int rssi = readRssi();
+    if (rssi > m_opts.lbtThreshold) {
+      ++m_cnt.nLbtBusy;
+      m_backoff = Deadline::in(random(m_opts.backoffMin, m_opts.backoffMax + 1));
+      LORASCHEDULER_DBG(F("channel busy rssi=") << rssi);
+      return;
+    }
+  }
+
+  ndn_Error e = m_inner.send(slot->pkt, slot->len, slot->endpointId);
+  if (e == NDN_ERROR_success) {
+    uint32_t airtime = m_opts.radio.computeAirtime(slot->len);
+    m_budget.consume(airtime);
+    ++m_cnt.nTxPkts;
+    m_cnt.txAirtime += airtime;
+  }
+  else {
+    ++m_cnt.nTxErrors;
+    LORASCHEDULER_DBG(F("send err=") << e);
+  }
+  slot->len = 0;
+}
+
+bool
+LoraSchedulerBase::isTxReady()
+{
+  for (uint8_t i = 0; i < m_opts.nSlots; ++i) {
+    if (m_slots[i].len == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+size_t
+LoraSchedulerBase::getMtu() const
+{
+  return LoraScheduler_MAX_PKT_SIZE;
+}
+
+LoraSchedulerBase::Slot*
+LoraSchedulerBase::nextSlot()
+{
+  Slot* best = nullptr;
+  for (uint8_t i = 0; i < m_opts.nSlots; ++i) {
+    Slot& slot = m_slots[i];
+    if (slot.len == 0) {
+      continue;
+    }
+    if (best == nullptr || slot.isInterest < best->isInterest ||
+        (slot.isInterest == best->isInterest && static_cast<int32_t>(slot.seq - best->seq) < 0)) {
+      best = &slot;
+    }
+  }
+  return best;
+}
+
+} // namespace ndn
@@ -0,0 +1,233 @@
+#ifndef ESP8266NDN_LORA_SCHEDULER_HPP
+#define ESP8266NDN_LORA_SCHEDULER_HPP
+
+#include "lora-transport.hpp"
+#include "../core/clock.hpp"
+
+#include <memory>
+
+namespace ndn {
+
+/** \brief LoRa modulation parameters that determine time-on-air
+ *
+ *  These should match the settings applied to the radio, such as LoRa.setSpreadingFactor().
+ */
+class LoraRadioParams
+{
+public:
+  /** \brief compute time-on-air of a packet
+   *  \param len payload length
+   *  \return time-on-air in micros
+   *  \sa Semtech AN1200.13 "LoRa Modem Designer's Guide"
+   */
+  uint32_t
+  computeAirtime(size_t len) const;
+
+  /** \brief compute symbol duration
+   *  \return symbol duration in micros
+   */
+  uint32_t
+  computeSymbolTime() const;
+
+public:
+  uint32_t bandwidth = 125000; ///< signal bandwidth in Hz
+  uint8_t spreadingFactor = 7; ///< spreading factor, between 6 and 12
+  uint8_t codingRate = 5;      ///< denominator of coding rate 4/x, between 5 and 8
+  uint16_t preambleLength = 8; ///< preamble length in symbols
+  bool hasCrc = false;         ///< whether payload CRC is enabled
+  bool isImplicitHeader = false;
+};
+
+/** \brief a duty-cycle budget for a sub-band
+ *
+ *  This is a generic cell rate algorithm: a transmission of airtime T occupies the band for T/dc,
+ *  where dc is the duty cycle, so that the band is silent for T/dc - T afterwards, as in LoRaWAN.
+ *  A nonzero burst allowance lets that much airtime be sent ahead of schedule.
+ */
+class DutyCycleBudget
+{
+public:
+  /** \brief constructor
+   *  \param dutyCycle max fraction of time spent transmitting, such as 0.01
+   *  \param burst airtime in millis that may be sent ahead of schedule
+   */
+  explicit
+  DutyCycleBudget(float dutyCycle = 0.01, uint32_t burst = 0);
+
+  /** \brief determine how long until the band may be used
+   *  \return millis to wait, zero if the band may be used now
+   */
+  unsigned long
+  getWait() const;
+
+  /** \brief record a transmission
+   *  \param airtime time-on-air in micros
+   */
+  void
+  consume(uint32_t airtime);
+
+private:
+  float m_dutyCycle;
+  unsigned long m_tolerance; ///< in millis
+  unsigned long m_tat;       ///< theoretical arrival time, in millis
+  bool m_isActive;           ///< m_tat is meaningful
+};
+
+/** \brief a transport wrapper that schedules LoRa transmissions
+ *
+ *  Outgoing packets are queued in slots. Data and other responses are sent before Interests,
+ *  each in arrival order; a HeaderCompressor above the scheduler keeps this distinction.
+ *  Before each transmission, the scheduler waits for the duty-cycle budget of the band to permit
+ *  the packet's time-on-air, and listens before talk: if channel RSSI exceeds a threshold, it
+ *  backs off for a random duration. To listen, the scheduler puts the radio in receive mode,
+ *  which the radio may have left after transmitting, and reads RSSI one symbol later in a
+ *  subsequent loop(), so that the reading reflects the channel.
+ *
+ *  Queued packets are transmitted in receive(), so that Face::loop() drives transmissions, or
+ *  in loop(). Use LoraScheduler template to instantiate.
+ */
+class LoraSchedulerBase : public Transport
+{
+public:
+  class Options
+  {
+  public:
+    LoraRadioParams radio;
+    float dutyCycle = 0.01;     ///< duty cycle of the band, 1.0 disables budget
+    uint32_t burst = 0;         ///< airtime that may be sent ahead of schedule, in millis
+    int lbtThreshold = -90;     ///< channel is busy if RSSI is above this, in dBm; 0 disables LBT
+    uint16_t backoffMin = 20;   ///< min backoff when channel is busy, in millis
+    uint16_t backoffMax = 200;  ///< max backoff when channel is busy, in millis
+    uint8_t nSlots = 8;         ///< max number of queued packets
+  };
+
+  class Counters
+  {
+  public:
+    uint32_t nTxPkts = 0;       ///< packets transmitted
+    uint32_t nTxErrors = 0;     ///< packets rejected by inner transport
+    uint32_t nQueueFull = 0;    ///< packets rejected because all slots are used
+    uint32_t nBudgetWaits = 0;  ///< packets that waited for duty-cycle budget
+    uint32_t nLbtBusy = 0;      ///< backoffs because channel is busy
+    uint64_t txAirtime = 0;     ///< cumulative time-on-air, in micros
+  };
+
+  ~LoraSchedulerBase();
+
+  size_t
+  receive(uint8_t* buf, size_t bufSize, uint64_t& endpointId) final;
+
+  /** \brief queue a packet
+   *  \retval NDN_ERROR_SocketTransport_error_in_send all slots are used
+   */
+  ndn_Error
+  send(const uint8_t* pkt, size_t len, uint64_t endpointId) final;
+
+  /** \brief transmit the next queued packet if radio, budget, and channel permit
+   */
+  void
+  loop();
+
+  /** \brief determine whether a slot is available
+   */
+  bool
+  isTxReady() final;
+
+  /** \brief get max LoRa payload size
+   */
+  size_t
+  getMtu() const final;
+
+  /** \brief determine how long until the band may be used, in millis
+   */
+  unsigned long
+  getBudgetWait() const
+  {
+    return m_budget.getWait();
+  }
+
+  const Counters&
+  getCounters() const
+  {
+    return m_cnt;
+  }
+
+protected:
+  LoraSchedulerBase(Transport& inner, const Options& options);
+
+  /** \brief put the radio in receive mode, so that channel RSSI can be measured
+   */
+  virtual void
+  startListen() = 0;
+
+  /** \brief read current channel RSSI in dBm
+   *  \pre radio has been in receive mode for at least one symbol since startListen()
+   */
+  virtual int
+  readRssi() = 0;
+
+private:
+  struct Slot;
+
+  /** \brief find the oldest non-Interest, or the oldest Interest if there is none
+   */
+  Slot*
+  nextSlot();
+
+private:
+  Transport& m_inner;
+  Options m_opts;
+  DutyCycleBudget m_budget;
+  std::unique_ptr<Slot[]> m_slots;
+  uint32_t m_seq;
+  Deadline m_backoff;
+  Deadline m_listen; ///< when RSSI becomes valid after startListen()
+  bool m_isWaitingBudget;
+  Counters m_cnt;
+};
+
+/** \brief a transport wrapper that schedules LoRa transmissions
+ *  \tparam Lora LoRaClass from Arduino LoRa library
+ *
+ *  LoraTransport should be in async TX mode, so that receive() is not blocked:
+ *  \code
+ *  ndn::LoraTransport<LoRaClass> transport(LoRa);
+ *  ndn::LoraScheduler<LoRaClass> scheduler(transport);
+ *  ndn::Face face(scheduler);
+ *  void setup() {
+ *    LoRa.begin(..);
+ *    transport.enableAsyncTx();
+ *  }
+ *  \endcode
+ */
+template<typename Lora>
+class LoraScheduler : public LoraSchedulerBase
+{
+public:
+  explicit
+  LoraScheduler(LoraTransport<Lora>& inner, const Options& options = Options())
+    : LoraSchedulerBase(inner, options)
+    , m_lora(inner.getLora())
+  {
+  }
+
+private:
+  void
+  startListen() final
+  {
+    m_lora.receive();
+  }
+
+  int
+  readRssi() final
+  {
+    return m_lora.rssi();
+  }
+
+private:
+  Lora& m_lora;
+};
+
+} // namespace ndn
+
+#endif // ESP8266NDN_LORA_SCHEDULER_HPP
@@ -2,9 +2,18 @@
 #define ESP8266NDN_LORA_TRANSPORT_HPP
 
 #include "transport.hpp"
+#include "detail/frame-ring.hpp"
+
+#include <memory>
 
 namespace ndn {
 
+/** \brief number of received LoRa packets that can await Face::loop() in interrupt RX mode
+ */
+#ifndef LORA_RX_QUEUE_SLOTS
+#define LORA_RX_QUEUE_SLOTS 4
+#endif
+
 /** \brief a transport that communicates over LoRa radio
  *  \tparam Lora LoRaClass from Arduino LoRa library
  *
@@ -18,6 +27,15 @@ namespace ndn {
  *    // there is no transport.begin()
  *  }
  *  \endcode
+ *
+ *  By default, send() blocks for the whole airtime. After enableAsyncTx(), send() returns as
+ *  soon as the radio starts transmitting; wrap the transport in a TxQueue so that Face keeps
+ *  running while the radio transmits.
+ *
+ *  By default, receive() polls the radio with parsePacket(), so that a packet arriving while the
+ *  application is busy is overwritten by the next packet. After beginInterruptRx(), the radio
+ *  stays in continuous RX mode, and each packet is copied into a queue from the onReceive
+ *  interrupt callback, along with its RSSI and SNR.
  */
 template<typename Lora>
 class LoraTransport : public Transport
@@ -26,13 +44,104 @@ public:
   explicit
   LoraTransport(Lora& lora)
     : m_lora(lora)
+    , m_isAsyncTx(false)
+    , m_isTransmitting(false)
+    , m_lastRssi(0)
+    , m_lastSnr(0)
+  {
+  }
+
+  ~LoraTransport()
+  {
+    if (s_rxInstance == this) {
+      m_lora.onReceive(nullptr);
+      s_rxInstance = nullptr;
+    }
+  }
+
+  /** \brief receive packets from onReceive interrupt callback
+   *  \return whether success; false if another LoraTransport of the same type is using interrupt
+   *
+   *  LoRa library allows one onReceive callback, so that only one LoraTransport per radio type
+   *  can use this mode.
+   */
+  bool
+  beginInterruptRx()
+  {
+    if (s_rxInstance != nullptr && s_rxInstance != this) {
+      return false;
+    }
+    if (m_rxRing == nullptr) {
+      m_rxRing.reset(new RxRing());
+    }
+    s_rxInstance = this;
+    m_lora.onReceive(&LoraTransport::handleRxInterrupt);
+    m_lora.receive();
+    return true;
+  }
+
+  /** \brief get RX queue counters
+   */
+  detail::FrameRingBase::Counters
+  getRxCounters() const
+  {
+    return m_rxRing == nullptr ? detail::FrameRingBase::Counters() : m_rxRing->getCounters();
+  }
+
+  /** \brief get RSSI of the last packet returned by receive(), in dBm
+   *
+   *  This is only available in interrupt RX mode.
+   */
+  int
+  getLastRssi() const
+  {
+    return m_lastRssi;
+  }
+
+  /** \brief get SNR of the last packet returned by receive(), in dB
+   *
+   *  This is only available in interrupt RX mode.
+   */
+  float
+  getLastSnr() const
+  {
+    return m_lastSnr / 4.0;
+  }
+
+  /** \brief choose whether send() returns before transmission completes
+   */
+  void
+  enableAsyncTx(bool enable = true)
+  {
+    m_isAsyncTx = enable;
+  }
+
+  /** \brief access the underlying LoRa radio
+   */
+  Lora&
+  getLora()
   {
+    return m_lora;
   }
 
   size_t
   receive(uint8_t* buf, size_t bufSize, uint64_t& endpointId) override
   {
-    if (m_lora.parsePacket() <= 0) {
+    endpointId = 0;
+    if (m_rxRing != nullptr) {
+      // resume continuous RX after an async transmission, even if Face does not use TxQueue
+      isTxReady();
+      uint64_t tag = 0;
+      size_t len = m_rxRing->pop(buf, bufSize, tag);
+      if (len > 0) {
+        m_lastRssi = static_cast<int16_t>(tag);
+        m_lastSnr = static_cast<int16_t>(tag >> 16);
+      }
+      return len;
+    }
+
+    // parsePacket() switches the radio to RX mode, which would abort an ongoing transmission
+    if (!isTxReady() || m_lora.parsePacket() <= 0) {
       return 0;
     }
     return m_lora.readBytes(buf, bufSize);
@@ -45,13 +154,89 @@ public:
       return NDN_ERROR_SocketTransport_cannot_connect_to_socket;
     }
     m_lora.write(pkt, len);
-    return m_lora.endPacket() ? NDN_ERROR_success : NDN_ERROR_SocketTransport_error_in_send;
+    if (!m_lora.endPacket(m_isAsyncTx)) {
+      resumeInterruptRx();
+      return NDN_ERROR_SocketTransport_error_in_send;
+    }
+    m_isTransmitting = m_isAsyncTx;
+    if (!m_isTransmitting) {
+      resumeInterruptRx();
+    }
+    return NDN_ERROR_success;
+  }
+
+  /** \brief determine whether the previous async transmission has completed
+   *
+   *  LoRa library does not expose its TX state, but beginPacket() fails while the radio is
+   *  transmitting. Otherwise, it puts the radio in standby mode, which is harmless because
+   *  either send() or receive() follows.
+   */
+  bool
+  isTxReady() override
+  {
+    if (m_isTransmitting && m_lora.beginPacket()) {
+      m_isTransmitting = false;
+      resumeInterruptRx();
+    }
+    return !m_isTransmitting;
   }
 
 private:
+  /** \brief return to continuous RX mode after transmission
+   */
+  void
+  resumeInterruptRx()
+  {
+    if (m_rxRing != nullptr) {
+      m_lora.receive();
+    }
+  }
+
+  static void
+  handleRxInterrupt(int packetSize)
+  {
+    LoraTransport* self = s_rxInstance;
+    if (self == nullptr || self->m_rxRing == nullptr) {
+      return;
+    }
+    Lora& lora = self->m_lora;
+    uint8_t* room = self->m_rxRing->beginPush();
+    if (room == nullptr) {
+      return;
+    }
+
+    size_t len = 0;
+    while (lora.available() && len < LORA_MAX_PKT_SIZE) {
+      room[len++] = lora.read();
+    }
+    // RSSI and SNR registers are overwritten by the next packet, so they are read here, although
+    // each read is an SPI transaction and packetSnr() uses floating point arithmetic.
+    // LoRa library does not expose the raw SNR register.
+    uint16_t rssi = static_cast<int16_t>(lora.packetRssi());
+    uint16_t snr = static_cast<int16_t>(lora.packetSnr() * 4);
+    self->m_rxRing->commitPush(len, rssi | (static_cast<uint32_t>(snr) << 16));
+  }
+
+private:
+  enum {
+    LORA_MAX_PKT_SIZE = 255,
+  };
+
+  using RxRing = detail::FrameRing<LORA_RX_QUEUE_SLOTS, LORA_MAX_PKT_SIZE>;
+
+  static LoraTransport* s_rxInstance;
+
   Lora& m_lora;
+  bool m_isAsyncTx;
+  bool m_isTransmitting;
+  std::unique_ptr<RxRing> m_rxRing;
+  int16_t m_lastRssi;
+  int16_t m_lastSnr; ///< in 0.25 dB
 };
 
+template<typename Lora>
+LoraTransport<Lora>* LoraTransport<Lora>::s_rxInstance = nullptr;
+
 } // namespace ndn
 
 #endif // ESP8266NDN_LORA_TRANSPORT_HPP
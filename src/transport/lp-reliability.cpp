@@ -0,0 +1,396 @@
+#include "lp-reliability.hpp"
+#include "../core/logger.hpp"
+#include "../core/lp-header.hpp"
+
+#include "../ndn-cpp/c/encoding/tlv/tlv.h"
+#include "../ndn-cpp/c/encoding/tlv/tlv-decoder.h"
+#include "../ndn-cpp/c/encoding/tlv/tlv-encoder.h"
+#include "../ndn-cpp/lite/util/dynamic-uint8-array-lite.hpp"
+
+#define LPREL_DBG(...) DBG(LpReliability, __VA_ARGS__)
+
+namespace ndn {
+
+enum {
+  LpReliability_Tlv_Ack = 0x0344,
+  LpReliability_Tlv_TxSequence = 0x0348,
+  LpReliability_FIELD_SIZE = 12, ///< size of Ack or TxSequence field
+  LpReliability_TL_SIZE = 4,     ///< max size of LpPacket or Fragment TLV-TYPE and TLV-LENGTH
+};
+
+struct LpReliability::RetxEntry
+{
+  uint8_t* pkt = nullptr; ///< packet, Options::maxPktSize octets
+  uint16_t len = 0;       ///< packet length; zero means entry is unused
+  uint8_t nRetx = 0;
+  uint64_t endpointId = 0;
+  uint64_t txSeq = 0;
+  unsigned long sentTime = 0;
+  unsigned long deadline = 0;
+};
+
+LpReliability::LpReliability(Transport& inner)
+  : inner(inner)
+  , m_retx(nullptr)
+  , m_retxBuf(nullptr)
+  , m_tbuf(nullptr)
+  , m_tbufSize(0)
+  , m_nAcks(0)
+  , m_ackDeadline(0)
+  , m_txSeq(0)
+  , m_srtt(0)
+  , m_rttvar(0)
+  , m_rto(0)
+{
+}
+
+LpReliability::~LpReliability()
+{
+  end();
+}
+
+void
+LpReliability::begin(const Options& options)
+{
+  end();
+  m_opts = options;
+  m_retx = new RetxEntry[m_opts.nRetxSlots];
+  m_retxBuf = new uint8_t[m_opts.maxPktSize * m_opts.nRetxSlots];
+  for (int i = 0; i < m_opts.nRetxSlots; ++i) {
+    m_retx[i].pkt = m_retxBuf + i * m_opts.maxPktSize;
+  }
+  m_tbufSize = LpReliability_TL_SIZE * 2 + LpReliability_FIELD_SIZE * (1 + m_opts.maxPiggybackAcks) +
+               m_opts.maxPktSize;
+  m_tbuf = new uint8_t[m_tbufSize];
+
+  m_nAcks = 0;
+  m_txSeq = (static_cast<uint64_t>(random(0x7FFFFFFF)) << 32) | random(0x7FFFFFFF);
+  m_srtt = m_rttvar = 0;
+  m_rto = m_opts.initialRto;
+}
+
+void
+LpReliability::end()
+{
+  delete[] m_retx;
+  m_retx = nullptr;
+  delete[] m_retxBuf;
+  m_retxBuf = nullptr;
+  delete[] m_tbuf;
+  m_tbuf = nullptr;
+}
+
+size_t
+LpReliability::getMtu() const
+{
+  size_t mtu = inner.getMtu();
+  if (mtu == 0) {
+    return 0;
+  }
+  size_t overhead = LpReliability_TL_SIZE * 2 + LpReliability_FIELD_SIZE * (1 + m_opts.maxPiggybackAcks);
+  return mtu > overhead ? mtu - overhead : 1;
+}
+
+size_t
+LpReliability::receive(uint8_t* buf, size_t bufSize, uint64_t& endpointId)
+{
+  if (m_tbuf == nullptr) {
+    LPREL_DBG(F("receive err=no-buffer"));
+    return 0;
+  }
+
+  unsigned long now = getClock().getMillis();
+  this->processTimers(now);
+
+  while (true) {
+    size_t len = inner.receive(buf, bufSize, endpointId);
+    if (len == 0 || buf[0] != ndn_Tlv_LpPacket_LpPacket) {
+      return len;
+    }
+    len = this->processLpPacket(buf, len, endpointId, now);
+    if (len > 0) {
+      return len;
+    }
+  }
+}
+
+void
+LpReliability::processTimers(unsigned long now)
+{
+  bool isBackedOff = false;
+  for (int i = 0; i < m_opts.nRetxSlots; ++i) {
+    RetxEntry& entry = m_retx[i];
+    if (entry.len == 0 || static_cast<long>(now - entry.deadline) < 0) {
+      continue;
+    }
+    if (entry.nRetx >= m_opts.maxRetx) {
+      LPREL_DBG(F("give-up txseq=") << entry.txSeq);
+      ++m_cnt.nGiveUp;
+      entry.len = 0;
+      continue;
+    }
+
+    if (!isBackedOff) {
+      // entries expiring together are one loss event, which backs off RTO once
+      m_rto = std::min<unsigned long>(m_rto * 2, m_opts.maxRto);
+      isBackedOff = true;
+    }
+    ++entry.nRetx;
+    entry.txSeq = m_txSeq++;
+    entry.sentTime = now;
+    entry.deadline = now + m_rto;
+    ++m_cnt.nRetx;
+    this->transmit(entry.pkt, entry.len, entry.endpointId, &entry.txSeq);
+  }
+
+  if (m_nAcks > 0 && static_cast<long>(now - m_ackDeadline) >= 0) {
+    while (m_nAcks > 0) {
+      ++m_cnt.nIdleAcks;
+      if (this->transmit(nullptr, 0, m_acks[0].endpointId, nullptr) != NDN_ERROR_success) {
+        break;
+      }
+    }
+  }
+}
+
+size_t
+LpReliability::processLpPacket(uint8_t* buf, size_t len, uint64_t endpointId, unsigned long now)
+{
+  ndn_TlvDecoder decoder;
+  ndn_TlvDecoder_initialize(&decoder, buf, len);
+  size_t endOffset;
+  if (ndn_TlvDecoder_readNestedTlvsStart(&decoder, ndn_Tlv_LpPacket_LpPacket, &endOffset)) {
+    return len; // let Face report the error
+  }
+
+  size_t valueOffset = decoder.offset;
+  size_t writeOffset = valueOffset;
+  bool hasFragment = false;
+  while (decoder.offset < endOffset) {
+    size_t fieldOffset = decoder.offset;
+    uint64_t fieldType, fieldLength;
+    if (ndn_TlvDecoder_readVarNumber(&decoder, &fieldType) ||
+        ndn_TlvDecoder_readVarNumber(&decoder, &fieldLength) ||
+        decoder.offset + fieldLength > endOffset) {
+      return len;
+    }
+
+    uint64_t value = 0;
+    switch (fieldType) {
+      case LpReliability_Tlv_Ack:
+      case LpReliability_Tlv_TxSequence:
+        if (fieldLength < 1 || fieldLength > 8 ||
+            ndn_TlvDecoder_readNonNegativeInteger(&decoder, fieldLength, &value)) {
+          return len;
+        }
+        break;
+      case ndn_Tlv_LpPacket_Fragment:
+        hasFragment = true;
+        // fallthrough
+      default:
+        decoder.offset += fieldLength;
+        memmove(buf + writeOffset, buf + fieldOffset, decoder.offset - fieldOffset);
+        writeOffset += decoder.offset - fieldOffset;
+        continue;
+    }
+
+    if (fieldType == LpReliability_Tlv_Ack) {
+      this->processAck(value, now);
+      continue;
+    }
+
+    if (m_nAcks == LPRELIABILITY_MAX_PENDING_ACKS) {
+      ++m_cnt.nAckDrops;
+      continue;
+    }
+    if (m_nAcks == 0) {
+      m_ackDeadline = now + m_opts.idleAckTimeout;
+    }
+    m_acks[m_nAcks++] = {value, endpointId};
+  }
+
+  if (!hasFragment) {
+    return 0;
+  }
+
+  // re-encode LpPacket TLV-TYPE and TLV-LENGTH at the front of buf
+  size_t lpPacketLen = writeOffset - valueOffset;
+  size_t tlSize = 1 + ndn_TlvEncoder_sizeOfVarNumber(lpPacketLen);
+  memmove(buf + tlSize, buf + valueOffset, lpPacketLen);
+  DynamicUInt8ArrayLite outArr(buf, tlSize, nullptr);
+  ndn_TlvEncoder encoder;
+  ndn_TlvEncoder_initialize(&encoder, reinterpret_cast<ndn_DynamicUInt8Array*>(&outArr));
+  ndn_TlvEncoder_writeTypeAndLength(&encoder, ndn_Tlv_LpPacket_LpPacket, lpPacketLen);
+  return tlSize + lpPacketLen;
+}
+
+void
+LpReliability::processAck(uint64_t txSeq, unsigned long now)
+{
+  for (int i = 0; i < m_opts.nRetxSlots; ++i) {
+    RetxEntry& entry = m_retx[i];
+    if (entry.len == 0 || entry.txSeq != txSeq) {
+      continue;
+    }
+    if (entry.nRetx == 0) { // Karn's algorithm: RTT samples only from packets not retransmitted
+      this->updateRto(now - entry.sentTime);
+    }
+    ++m_cnt.nAcked;
+    entry.len = 0;
+    return;
+  }
+}
+
+void
+LpReliability::updateRto(unsigned long rtt)
+{
+  if (m_srtt == 0 && m_rttvar == 0) {
+    m_srtt = rtt;
+    m_rttvar = rtt / 2;
+  }
+  else {
+    unsigned long delta = m_srtt > rtt ? m_srtt - rtt : rtt - m_srtt;
+    m_rttvar = (3 * m_rttvar + delta) / 4;
+    m_srtt = (7 * m_srtt + rtt) / 8;
+  }
+  m_rto = m_srtt + std::max<unsigned long>(4 * m_rttvar, 1);
+  m_rto = std::min<unsigned long>(std::max<unsigned long>(m_rto, m_opts.minRto), m_opts.maxRto);
+}
+
+ndn_Error
+LpReliability::send(const uint8_t* pkt, size_t len, uint64_t endpointId)
+{
+  if (m_tbuf == nullptr) {
+    LPREL_DBG(F("send err=no-buffer"));
+    return NDN_ERROR_SocketTransport_cannot_connect_to_socket;
+  }
+  if (len == 0 || len > m_opts.maxPktSize) {
+    return NDN_ERROR_TLV_length_exceeds_buffer_length;
+  }
+
+  RetxEntry* entry = nullptr;
+  for (int i = 0; i < m_opts.nRetxSlots && entry == nullptr; ++i) {
+    if (m_retx[i].len == 0) {
+      entry = &m_retx[i];
+    }
+  }
+  if (entry == nullptr) {
+    ++m_cnt.nTxUnreliable;
+    return this->transmit(pkt, len, endpointId, nullptr);
+  }
+
+  unsigned long now = getClock().getMillis();
+  memcpy(entry->pkt, pkt, len);
+  entry->nRetx = 0;
+  entry->endpointId = endpointId;
+  entry->txSeq = m_txSeq++;
+  entry->sentTime = now;
+  entry->deadline = now + m_rto;
+  ndn_Error error = this->transmit(pkt, len, endpointId, &entry->txSeq);
+  if (error) {
+    return error;
+  }
+  entry->len = len;
+  ++m_cnt.nTxReliable;
+  return NDN_ERROR_success;
+}
+
+static void
+writeSeqField(ndn_TlvEncoder* encoder, unsigned int type, uint64_t value)
+{
+  uint8_t seq[8];
+  for (int j = 0; j < 8; ++j) {
+    seq[j] = static_cast<uint8_t>(value >> (56 - 8 * j));
+  }
+  ndn_TlvEncoder_writeTypeAndLength(encoder, type, sizeof(seq));
+  ndn_TlvEncoder_writeArray(encoder, seq, sizeof(seq));
+}
+
+ndn_Error
+LpReliability::transmit(const uint8_t* pkt, size_t len, uint64_t endpointId, const uint64_t* txSeq)
+{
+  // split into header fields preceding Fragment, and Fragment TLV
+  const uint8_t* headers = nullptr;
+  size_t headersLen = 0;
+  const uint8_t* fragment = nullptr;
+  size_t fragmentSize = 0;
+  bool isBare = pkt != nullptr && pkt[0] != ndn_Tlv_LpPacket_LpPacket;
+  if (isBare) {
+    fragmentSize = 1 + ndn_TlvEncoder_sizeOfVarNumber(len) + len;
+  }
+  else if (pkt != nullptr) {
+    LpHeader lpHeader;
+    ndn_Error error = lpHeader.decode(pkt, len);
+    if (error || lpHeader.payload == nullptr) {
+      return error ? error : NDN_ERROR_header_type_is_out_of_range;
+    }
+    // Ack and TxSequence are inserted between existing header fields and Fragment,
+    // because header fields generated by Face have lower TLV-TYPE numbers
+    ndn_TlvDecoder decoder;
+    ndn_TlvDecoder_initialize(&decoder, pkt, len);
+    size_t endOffset;
+    ndn_TlvDecoder_readNestedTlvsStart(&decoder, ndn_Tlv_LpPacket_LpPacket, &endOffset);
+    headers = pkt + decoder.offset;
+    fragment = lpHeader.headers + lpHeader.headersLen;
+    headersLen = fragment - headers;
+    fragmentSize = lpHeader.payload + lpHeader.payloadLen - fragment;
+  }
+
+  int maxAcks = pkt == nullptr ? LPRELIABILITY_MAX_PENDING_ACKS : m_opts.maxPiggybackAcks;
+  int nAcks = 0;
+  for (int i = 0; i < m_nAcks && nAcks < maxAcks; ++i) {
+    nAcks += static_cast<int>(m_acks[i].endpointId == endpointId);
+  }
+
+  size_t lpPacketLen = headersLen + LpReliability_FIELD_SIZE * (nAcks + (txSeq == nullptr ? 0 : 1)) +
+                       fragmentSize;
+  size_t lpPacketSize = 1 + ndn_TlvEncoder_sizeOfVarNumber(lpPacketLen) + lpPacketLen;
+  if (lpPacketSize > m_tbufSize) {
+    LPREL_DBG(F("send err=too-large len=") << len);
+    return NDN_ERROR_TLV_length_exceeds_buffer_length;
+  }
+
+  DynamicUInt8ArrayLite outArr(m_tbuf, m_tbufSize, nullptr);
+  ndn_TlvEncoder encoder;
+  ndn_TlvEncoder_initialize(&encoder, reinterpret_cast<ndn_DynamicUInt8Array*>(&outArr));
+  ndn_TlvEncoder_writeTypeAndLength(&encoder, ndn_Tlv_LpPacket_LpPacket, lpPacketLen);
+  if (headersLen > 0) {
+    ndn_TlvEncoder_writeArray(&encoder, headers, headersLen);
+  }
+  for (int i = 0, j = 0; i < m_nAcks && j < nAcks; ++i) {
+    if (m_acks[i].endpointId == endpointId) {
+      writeSeqField(&encoder, LpReliability_Tlv_Ack, m_acks[i].txSeq);
+      ++j;
+    }
+  }
+  if (txSeq != nullptr) {
+    writeSeqField(&encoder, LpReliability_Tlv_TxSequence, *txSeq);
+  }
+  if (isBare) {
+    ndn_TlvEncoder_writeTypeAndLength(&encoder, ndn_Tlv_LpPacket_Fragment, len);
+    ndn_TlvEncoder_writeArray(&encoder, pkt, len);
+  }
+  else if (fragmentSize > 0) {
+    ndn_TlvEncoder_writeArray(&encoder, fragment, fragmentSize);
+  }
+
+  ndn_Error error = inner.send(m_tbuf, encoder.offset, endpointId);
+  if (error) {
+    LPREL_DBG(F("send err=") << _DEC(error));
+    return error;
+  }
+
+  // remove piggybacked acks from pending queue
+  int nKept = 0;
+  for (int i = 0, j = 0; i < m_nAcks; ++i) {
+    if (j < nAcks && m_acks[i].endpointId == endpointId) {
+      ++j;
+      continue;
+    }
+    m_acks[nKept++] = m_acks[i];
+  }
+  m_nAcks = nKept;
+  return NDN_ERROR_success;
+}
+
+} // namespace ndn
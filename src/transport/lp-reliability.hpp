@@ -0,0 +1,162 @@
+#ifndef ESP8266NDN_LP_RELIABILITY_HPP
+#define ESP8266NDN_LP_RELIABILITY_HPP
+
+#include "transport.hpp"
+
+namespace ndn {
+
+/** \brief max number of received TxSequence numbers awaiting acknowledgement
+ */
+#define LPRELIABILITY_MAX_PENDING_ACKS 16
+
+/** \brief a transport wrapper that provides NDNLPv2 link-layer reliability
+ *  \sa https://redmine.named-data.net/projects/nfd/wiki/NDNLPv2
+ *
+ *  Each outgoing packet is wrapped in an LpPacket with a TxSequence field, and kept in a
+ *  retransmission buffer until the peer acknowledges it. Unacknowledged packets are
+ *  retransmitted with a new TxSequence after a retransmission timeout (RTO), up to a bounded
+ *  number of times. RTO is estimated from round-trip time samples as in RFC 6298.
+ *
+ *  Incoming TxSequence numbers are acknowledged with Ack fields, piggybacked on outgoing packets
+ *  to the same endpoint. If no outgoing packet is available within \c Options::idleAckTimeout,
+ *  an IDLE packet carrying only Ack fields is sent.
+ *
+ *  Timers are processed in receive(), so that Face::loop() drives retransmissions.
+ *  This is intended for point-to-point links, such as LoRa and BLE.
+ */
+class LpReliability : public Transport
+{
+public:
+  class Options
+  {
+  public:
+    uint16_t maxPktSize = 1500;     ///< max size of a packet passed to send()
+    uint8_t nRetxSlots = 4;         ///< max number of unacknowledged packets
+    uint8_t maxRetx = 3;            ///< max retransmissions of a packet
+    uint8_t maxPiggybackAcks = 4;   ///< max Ack fields in an outgoing packet
+    uint16_t idleAckTimeout = 5;    ///< how long to wait for a packet to piggyback acks, in millis
+    uint16_t initialRto = 1000;     ///< RTO before the first RTT sample, in millis
+    uint16_t minRto = 100;          ///< min RTO, in millis
+    uint16_t maxRto = 8000;         ///< max RTO, in millis
+  };
+
+  class Counters
+  {
+  public:
+    uint32_t nTxReliable = 0;   ///< packets sent with TxSequence
+    uint32_t nTxUnreliable = 0; ///< packets sent without TxSequence because retx buffer is full
+    uint32_t nRetx = 0;         ///< retransmissions
+    uint32_t nAcked = 0;        ///< packets acknowledged by peer
+    uint32_t nGiveUp = 0;       ///< packets abandoned after max retransmissions
+    uint32_t nIdleAcks = 0;     ///< IDLE packets sent to carry acks
+    uint32_t nAckDrops = 0;     ///< acks not sent because pending acks queue is full
+  };
+
+  explicit
+  LpReliability(Transport& inner);
+
+  ~LpReliability();
+
+  /** \brief allocate buffers
+   */
+  void
+  begin(const Options& options);
+
+  void
+  begin()
+  {
+    begin(Options());
+  }
+
+  /** \brief release buffers
+   */
+  void
+  end();
+
+  /** \brief receive a packet, after processing and stripping Ack and TxSequence fields
+   *
+   *  This also retransmits packets whose RTO has expired, and sends IDLE packets with acks.
+   */
+  size_t
+  receive(uint8_t* buf, size_t bufSize, uint64_t& endpointId) final;
+
+  /** \brief transmit a packet with TxSequence and piggybacked acks
+   */
+  ndn_Error
+  send(const uint8_t* pkt, size_t len, uint64_t endpointId) final;
+
+  /** \brief get inner MTU minus overhead of Ack and TxSequence fields
+   */
+  size_t
+  getMtu() const final;
+
+  const Counters&
+  getCounters() const
+  {
+    return m_cnt;
+  }
+
+  /** \brief get current retransmission timeout, in millis
+   */
+  unsigned long
+  getRto() const
+  {
+    return m_rto;
+  }
+
+private:
+  struct RetxEntry;
+
+  struct PendingAck
+  {
+    uint64_t txSeq;
+    uint64_t endpointId;
+  };
+
+  void
+  processTimers(unsigned long now);
+
+  /** \brief process Ack and TxSequence fields, and strip them from LpPacket in \p buf
+   *  \return new packet length, or zero if the packet has no Fragment
+   */
+  size_t
+  processLpPacket(uint8_t* buf, size_t len, uint64_t endpointId, unsigned long now);
+
+  void
+  processAck(uint64_t txSeq, unsigned long now);
+
+  void
+  updateRto(unsigned long rtt);
+
+  /** \brief transmit an LpPacket
+   *  \param pkt network layer packet or LpPacket; nullptr to send an IDLE packet
+   *  \param txSeq pointer to TxSequence, nullptr to omit
+   */
+  ndn_Error
+  transmit(const uint8_t* pkt, size_t len, uint64_t endpointId, const uint64_t* txSeq);
+
+public:
+  Transport& inner;
+
+private:
+  Options m_opts;
+  RetxEntry* m_retx;
+  uint8_t* m_retxBuf;
+  uint8_t* m_tbuf;
+  size_t m_tbufSize;
+
+  PendingAck m_acks[LPRELIABILITY_MAX_PENDING_ACKS];
+  int m_nAcks;
+  unsigned long m_ackDeadline;
+
+  uint64_t m_txSeq;
+  unsigned long m_srtt;
+  unsigned long m_rttvar;
+  unsigned long m_rto;
+
+  Counters m_cnt;
+};
+
+} // namespace ndn
+
+#endif // ESP8266NDN_LP_RELIABILITY_HPP
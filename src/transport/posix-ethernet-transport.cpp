@@ -0,0 +1,307 @@
+#if defined(__linux__)
+
+#include "posix-ethernet-transport.hpp"
+#include "../core/logger.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+
+#include <arpa/inet.h>
+#include <linux/if_packet.h>
+#include <net/ethernet.h>
+#include <net/if.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#define POSIXETH_DBG(...) DBG(PosixEthernetTransport, __VA_ARGS__)
+
+namespace ndn {
+
+static_assert(sizeof(PosixEthernetTransport::EndpointId) == sizeof(uint64_t), "");
+
+static const uint16_t NDN_ETHERTYPE = 0x8624;
+static const uint8_t NDN_MCAST_ADDR[6] = {0x01, 0x00, 0x5E, 0x00, 0x17, 0xAA};
+static const size_t FRAME_SIZE = 2048;
+static const size_t TX_DATA_OFFSET = TPACKET_ALIGN(sizeof(tpacket3_hdr));
+static_assert(TX_DATA_OFFSET + sizeof(ether_header) + 1500 <= FRAME_SIZE, "");
+
+static uint32_t
+loadStatus(const volatile uint32_t& status)
+{
+  uint32_t value = status;
+  std::atomic_thread_fence(std::memory_order_acquire);
+  return value;
+}
+
+static void
+storeStatus(volatile uint32_t& status, uint32_t value)
+{
+  std::atomic_thread_fence(std::memory_order_release);
+  status = value;
+}
+
+PosixEthernetTransport::PosixEthernetTransport()
+  : PosixEthernetTransport(Options())
+{
+}
+
+PosixEthernetTransport::PosixEthernetTransport(const Options& options)
+  : m_opts(options)
+  , m_fd(-1)
+  , m_ring(nullptr)
+  , m_ringSize(0)
+  , m_localAddr{0}
+  , m_rxBlock(0)
+  , m_rxRemain(0)
+  , m_rxPos(nullptr)
+  , m_txRing(nullptr)
+  , m_txPos(0)
+  , m_txPending(0)
+{
+  m_opts.txBatch = std::max<uint16_t>(m_opts.txBatch, 1);
+}
+
+PosixEthernetTransport::~PosixEthernetTransport()
+{
+  end();
+}
+
+bool
+PosixEthernetTransport::begin(const char* ifname)
+{
+  end();
+  int ifindex = if_nametoindex(ifname);
+  if (ifindex == 0) {
+    POSIXETH_DBG(F("interface ") << ifname << F(" not found"));
+    return false;
+  }
+
+  // protocol 0 receives nothing until bind(), so that frames from other interfaces are not queued
+  m_fd = socket(AF_PACKET, SOCK_RAW | SOCK_CLOEXEC, 0);
+  if (m_fd < 0) {
+    POSIXETH_DBG(F("socket error ") << errno);
+    return false;
+  }
+
+  ifreq ifr = {};
+  strncpy(ifr.ifr_name, ifname, IFNAMSIZ - 1);
+  if (ioctl(m_fd, SIOCGIFHWADDR, &ifr) != 0) {
+    POSIXETH_DBG(F("SIOCGIFHWADDR error ") << errno);
+    end();
+    return false;
+  }
+  memcpy(m_localAddr, ifr.ifr_hwaddr.sa_data, sizeof(m_localAddr));
+
+  int version = TPACKET_V3;
+  int one = 1;
+  tpacket_req3 rxReq = {};
+  rxReq.tp_block_size = m_opts.rxBlockSize;
+  rxReq.tp_block_nr = m_opts.rxBlocks;
+  rxReq.tp_frame_size = FRAME_SIZE;
+  rxReq.tp_frame_nr = m_opts.rxBlockSize / FRAME_SIZE * m_opts.rxBlocks;
+  rxReq.tp_retire_blk_tov = m_opts.rxBlockTimeout;
+
+  // TX ring has one frame per slot; blocks are only a unit of allocation
+  size_t txBlockSize = std::max<size_t>(getpagesize(), FRAME_SIZE);
+  size_t txFramesPerBlock = txBlockSize / FRAME_SIZE;
+  tpacket_req3 txReq = {};
+  txReq.tp_block_size = txBlockSize;
+  txReq.tp_block_nr = (m_opts.txFrames + txFramesPerBlock - 1) / txFramesPerBlock;
+  txReq.tp_frame_size = FRAME_SIZE;
+  txReq.tp_frame_nr = txReq.tp_block_nr * txFramesPerBlock;
+  m_opts.txFrames = txReq.tp_frame_nr;
+
+  if (setsockopt(m_fd, SOL_PACKET, PACKET_VERSION, &version, sizeof(version)) != 0 ||
+      setsockopt(m_fd, SOL_PACKET, PACKET_RX_RING, &rxReq, sizeof(rxReq)) != 0 ||
+      setsockopt(m_fd, SOL_PACKET, PACKET_TX_RING, &txReq, sizeof(txReq)) != 0) {
+    POSIXETH_DBG(F("TPACKET_V3 ring error ") << errno);
+    end();
+    return false;
+  }
+  setsockopt(m_fd, SOL_PACKET, PACKET_QDISC_BYPASS, &one, sizeof(one));
+
+  size_t rxSize = static_cast<size_t>(rxReq.tp_block_size) * rxReq.tp_block_nr;
+  m_ringSize = rxSize + static_cast<size_t>(txReq.tp_block_size) * txReq.tp_block_nr;
+  void* ring = mmap(nullptr, m_ringSize, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+  if (ring == MAP_FAILED) {
+    POSIXETH_DBG(F("mmap error ") << errno);
+    m_ringSize = 0;
+    end();
+    return false;
+  }
+  m_ring = reinterpret_cast<uint8_t*>(ring);
+  m_txRing = m_ring + rxSize;
+
+  sockaddr_ll sll = {};
+  sll.sll_family = AF_PACKET;
+  sll.sll_protocol = htons(NDN_ETHERTYPE);
+  sll.sll_ifindex = ifindex;
+  packet_mreq mreq = {};
+  mreq.mr_ifindex = ifindex;
+  mreq.mr_type = PACKET_MR_MULTICAST;
+  mreq.mr_alen = sizeof(NDN_MCAST_ADDR);
+  memcpy(mreq.mr_address, NDN_MCAST_ADDR, sizeof(NDN_MCAST_ADDR));
+  if (bind(m_fd, reinterpret_cast<sockaddr*>(&sll), sizeof(sll)) != 0 ||
+      setsockopt(m_fd, SOL_PACKET, PACKET_ADD_MEMBERSHIP, &mreq, sizeof(mreq)) != 0) {
+    POSIXETH_DBG(F("bind error ") << errno);
+    end();
+    return false;
+  }
+
+  POSIXETH_DBG(F("enabled on ") << ifname);
+  return true;
+}
+
+void
+PosixEthernetTransport::end()
+{
+  if (m_fd >= 0 && m_ring != nullptr) {
+    flush();
+  }
+  if (m_ring != nullptr) {
+    munmap(m_ring, m_ringSize);
+  }
+  if (m_fd >= 0) {
+    ::close(m_fd);
+  }
+  m_fd = -1;
+  m_ring = m_txRing = nullptr;
+  m_ringSize = 0;
+  m_rxBlock = 0;
+  m_rxRemain = 0;
+  m_rxPos = nullptr;
+  m_txPos = m_txPending = 0;
+}
+
+const uint8_t*
+PosixEthernetTransport::nextRxFrame()
+{
+  while (m_rxRemain == 0) {
+    auto block = reinterpret_cast<tpacket_block_desc*>(m_ring + m_rxBlock * m_opts.rxBlockSize);
+    if ((loadStatus(block->hdr.bh1.block_status) & TP_STATUS_USER) == 0) {
+      return nullptr;
+    }
+    ++m_cnt.nRxBlocks;
+    m_rxRemain = block->hdr.bh1.num_pkts;
+    m_rxPos = reinterpret_cast<const uint8_t*>(block) + block->hdr.bh1.offset_to_first_pkt;
+    if (m_rxRemain == 0) {
+      storeStatus(block->hdr.bh1.block_status, TP_STATUS_KERNEL);
+      m_rxBlock = (m_rxBlock + 1) % m_opts.rxBlocks;
+    }
+  }
+  return m_rxPos;
+}
+
+size_t
+PosixEthernetTransport::receive(uint8_t* buf, size_t bufSize, uint64_t& endpointId)
+{
+  if (m_ring == nullptr) {
+    return 0;
+  }
+
+  const uint8_t* frame;
+  while ((frame = nextRxFrame()) != nullptr) {
+    auto hdr = reinterpret_cast<const tpacket3_hdr*>(frame);
+    auto sll = reinterpret_cast<const sockaddr_ll*>(frame + TPACKET_ALIGN(sizeof(tpacket3_hdr)));
+    auto eth = reinterpret_cast<const ether_header*>(frame + hdr->tp_mac);
+    size_t len = hdr->tp_snaplen;
+
+    bool isAccepted = sll->sll_pkttype != PACKET_OUTGOING && sll->sll_pkttype != PACKET_OTHERHOST &&
+                      len > sizeof(ether_header) && len - sizeof(ether_header) <= bufSize;
+    if (isAccepted) {
+      len -= sizeof(ether_header);
+      memcpy(buf, frame + hdr->tp_mac + sizeof(ether_header), len);
+      EndpointId endpoint = {0};
+      memcpy(endpoint.addr, eth->ether_shost, sizeof(endpoint.addr));
+      endpoint.isMulticast = 0x01 & eth->ether_dhost[0];
+      endpointId = endpoint.endpointId;
+      ++m_cnt.nRxPkts;
+    }
+
+    if (--m_rxRemain == 0) {
+      auto block = reinterpret_cast<tpacket_block_desc*>(m_ring + m_rxBlock * m_opts.rxBlockSize);
+      storeStatus(block->hdr.bh1.block_status, TP_STATUS_KERNEL);
+      m_rxBlock = (m_rxBlock + 1) % m_opts.rxBlocks;
+    }
+    else {
+      m_rxPos += hdr->tp_next_offset;
+    }
+
+    if (isAccepted) {
+      return len;
+    }
+  }
+
+  if (m_txPending > 0) {
+    flush();
+  }
+  return 0;
+}
+
+ndn_Error
+PosixEthernetTransport::send(const uint8_t* pkt, size_t len, uint64_t endpointId)
+{
+  if (m_ring == nullptr) {
+    return NDN_ERROR_SocketTransport_socket_is_not_open;
+  }
+  if (len > getMtu()) {
+    return NDN_ERROR_SocketTransport_error_in_send;
+  }
+
+  uint8_t* slot = m_txRing + m_txPos * FRAME_SIZE;
+  auto hdr = reinterpret_cast<tpacket3_hdr*>(slot);
+  if ((loadStatus(hdr->tp_status) & (TP_STATUS_SEND_REQUEST | TP_STATUS_SENDING)) != 0) {
+    flush();
+    ++m_cnt.nTxFull;
+    return NDN_ERROR_SocketTransport_error_in_send;
+  }
+
+  auto eth = reinterpret_cast<ether_header*>(slot + TX_DATA_OFFSET);
+  if (endpointId == 0) {
+    memcpy(eth->ether_dhost, NDN_MCAST_ADDR, sizeof(eth->ether_dhost));
+  }
+  else {
+    EndpointId endpoint;
+    endpoint.endpointId = endpointId;
+    memcpy(eth->ether_dhost, endpoint.addr, sizeof(eth->ether_dhost));
+  }
+  memcpy(eth->ether_shost, m_localAddr, sizeof(eth->ether_shost));
+  eth->ether_type = htons(NDN_ETHERTYPE);
+  memcpy(slot + TX_DATA_OFFSET + sizeof(ether_header), pkt, len);
+  size_t payloadLen = std::max<size_t>(len, 46);
+  memset(slot + TX_DATA_OFFSET + sizeof(ether_header) + len, 0, payloadLen - len);
+
+  hdr->tp_len = sizeof(ether_header) + payloadLen;
+  hdr->tp_next_offset = 0;
+  storeStatus(hdr->tp_status, TP_STATUS_SEND_REQUEST);
+  m_txPos = (m_txPos + 1) % m_opts.txFrames;
+  ++m_cnt.nTxPkts;
+
+  if (++m_txPending < m_opts.txBatch) {
+    return NDN_ERROR_success;
+  }
+  return flush();
+}
+
+ndn_Error
+PosixEthernetTransport::flush()
+{
+  if (m_txPending == 0) {
+    return NDN_ERROR_success;
+  }
+  m_txPending = 0;
+  ++m_cnt.nTxSyscalls;
+  if (::send(m_fd, nullptr, 0, MSG_DONTWAIT) < 0 && errno != EAGAIN && errno != ENOBUFS) {
+    POSIXETH_DBG(F("send error ") << errno);
+    return NDN_ERROR_SocketTransport_error_in_send;
+  }
+  return NDN_ERROR_success;
+}
+
+} // namespace ndn
+
+#endif // defined(__linux__)
@@ -0,0 +1,151 @@
+#ifndef ESP8266NDN_POSIX_ETHERNET_TRANSPORT_HPP
+#define ESP8266NDN_POSIX_ETHERNET_TRANSPORT_HPP
+
+#if defined(__linux__)
+
+#include "transport.hpp"
+
+namespace ndn {
+
+/** \brief a transport that communicates over Ethernet on a Linux host
+ *
+ *  This has the same EtherType, multicast group, and EndpointId layout as EthernetTransport,
+ *  so that Ethernet multicast behavior can be reproduced on Linux, such as on a veth pair.
+ *  It requires CAP_NET_RAW.
+ *
+ *  Frames are exchanged through TPACKET_V3 mmap rings on an AF_PACKET socket. receive() walks
+ *  RX blocks handed over by the kernel without syscalls; a block is handed over when it is full
+ *  or after \c Options::rxBlockTimeout. send() writes frames into TX ring slots; a single send
+ *  syscall transmits all written frames when \c Options::txBatch frames are pending, when
+ *  receive() finds no more frames, or when flush() is invoked.
+ */
+class PosixEthernetTransport : public Transport
+{
+public:
+  /** \brief interpretation of endpointId, same as EthernetTransport::EndpointId
+   */
+  union EndpointId {
+    uint64_t endpointId;
+    struct {
+      uint8_t addr[6];
+      bool isMulticast : 1; ///< RX only, ignored on TX
+      uint16_t _a : 15;
+    };
+  };
+
+  class Options
+  {
+  public:
+    uint32_t rxBlockSize = 1 << 16; ///< RX block size, multiple of page size
+    uint16_t rxBlocks = 16;         ///< number of RX blocks
+    uint16_t rxBlockTimeout = 1;    ///< RX block retire timeout, in millis
+    uint16_t txFrames = 256;        ///< number of TX ring slots
+    uint16_t txBatch = 16;          ///< max frames per send syscall, 1 disables TX queuing
+  };
+
+  class Counters
+  {
+  public:
+    uint32_t nRxBlocks = 0;    ///< RX blocks consumed
+    uint32_t nRxPkts = 0;      ///< frames received
+    uint32_t nTxSyscalls = 0;  ///< send syscalls that kick TX ring
+    uint32_t nTxPkts = 0;      ///< frames placed in TX ring
+    uint32_t nTxFull = 0;      ///< frames dropped because TX ring is full
+  };
+
+  PosixEthernetTransport();
+
+  explicit
+  PosixEthernetTransport(const Options& options);
+
+  ~PosixEthernetTransport();
+
+  /** \brief start sending and receiving NDN frames on a network interface
+   *  \param ifname interface name, such as "eth0"
+   *  \return whether success
+   */
+  bool
+  begin(const char* ifname);
+
+  void
+  end();
+
+  /** \brief receive a packet
+   *  \param[out] endpointId identity of remote endpoint and whether packet was multicast
+   */
+  size_t
+  receive(uint8_t* buf, size_t bufSize, uint64_t& endpointId) final;
+
+  /** \brief transmit a packet
+   *  \param endpointId identity of remote endpoint, zero for sending to multicast group
+   */
+  ndn_Error
+  send(const uint8_t* pkt, size_t len, uint64_t endpointId) final;
+
+  /** \brief transmit frames pending in TX ring
+   */
+  ndn_Error
+  flush();
+
+  /** \brief get Ethernet MTU
+   */
+  size_t
+  getMtu() const final
+  {
+    return 1500;
+  }
+
+  /** \brief get MAC address of the network interface
+   */
+  const uint8_t*
+  getLocalAddr() const
+  {
+    return m_localAddr;
+  }
+
+  /** \brief get socket file descriptor, -1 if closed
+   *
+   *  This may be used with poll() to wait for RX blocks.
+   */
+  int
+  getFd() const
+  {
+    return m_fd;
+  }
+
+  const Counters&
+  getCounters() const
+  {
+    return m_cnt;
+  }
+
+private:
+  /** \brief find next frame in RX ring
+   *  \return frame header, or nullptr if no block is ready
+   */
+  const uint8_t*
+  nextRxFrame();
+
+private:
+  Options m_opts;
+  int m_fd;
+  uint8_t* m_ring;
+  size_t m_ringSize;
+  uint8_t m_localAddr[6];
+
+  uint16_t m_rxBlock;     ///< current RX block
+  uint32_t m_rxRemain;    ///< unread frames in current RX block, 0 if block is not acquired
+  const uint8_t* m_rxPos; ///< next frame in current RX block
+
+  uint8_t* m_txRing;
+  uint16_t m_txPos;       ///< next TX slot
+  uint16_t m_txPending;   ///< frames written since last send syscall
+
+  Counters m_cnt;
+};
+
+} // namespace ndn
+
+#endif // defined(__linux__)
+
+#endif // ESP8266NDN_POSIX_ETHERNET_TRANSPORT_HPP
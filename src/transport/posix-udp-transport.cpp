@@ -0,0 +1,298 @@
+#if defined(__linux__)
+
+#include "posix-udp-transport.hpp"
+#include "../core/logger.hpp"
+
+#include <cerrno>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#define POSIXUDP_DBG(...) DBG(PosixUdpTransport, __VA_ARGS__)
+
+namespace ndn {
+
+static_assert(sizeof(PosixUdpTransport::EndpointId) == sizeof(uint64_t), "");
+
+const IPAddress PosixUdpTransport::MCAST_GROUP(224, 0, 23, 170);
+
+/** \brief buffers for one recvmmsg or sendmmsg call
+ */
+struct PosixUdpTransport::Batch
+{
+  Batch(int size, size_t pktSize)
+    : buf(size * pktSize)
+    , addr(size)
+    , iov(size)
+    , msg(size)
+  {
+    for (int i = 0; i < size; ++i) {
+      iov[i].iov_base = &buf[i * pktSize];
+      iov[i].iov_len = pktSize;
+      msg[i].msg_hdr.msg_name = &addr[i];
+      msg[i].msg_hdr.msg_namelen = sizeof(addr[i]);
+      msg[i].msg_hdr.msg_iov = &iov[i];
+      msg[i].msg_hdr.msg_iovlen = 1;
+    }
+  }
+
+  std::vector<uint8_t> buf;
+  std::vector<sockaddr_in> addr;
+  std::vector<iovec> iov;
+  std::vector<mmsghdr> msg;
+};
+
+PosixUdpTransport::PosixUdpTransport()
+  : PosixUdpTransport(Options())
+{
+}
+
+PosixUdpTransport::PosixUdpTransport(const Options& options)
+  : m_opts(options)
+  , m_fd(-1)
+  , m_mode(Mode::NONE)
+  , m_port(0)
+  , m_rxCount(0)
+  , m_rxPos(0)
+  , m_txCount(0)
+{
+  m_opts.rxBatch = std::max<uint16_t>(m_opts.rxBatch, 1);
+  m_opts.txBatch = std::max<uint16_t>(m_opts.txBatch, 1);
+}
+
+PosixUdpTransport::~PosixUdpTransport()
+{
+  end();
+}
+
+bool
+PosixUdpTransport::openSocket(IPAddress localIp, uint16_t localPort, bool reuseAddr)
+{
+  m_fd = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  if (m_fd < 0) {
+    POSIXUDP_DBG(F("socket error ") << errno);
+    return false;
+  }
+
+  int one = 1;
+  if (reuseAddr && setsockopt(m_fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one)) != 0) {
+    POSIXUDP_DBG(F("SO_REUSEADDR error ") << errno);
+  }
+
+  sockaddr_in addr = {};
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = static_cast<uint32_t>(localIp);
+  addr.sin_port = htons(localPort);
+  if (bind(m_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+    POSIXUDP_DBG(F("bind error ") << errno);
+    ::close(m_fd);
+    m_fd = -1;
+    return false;
+  }
+
+  m_rx.reset(new Batch(m_opts.rxBatch, m_opts.maxPktSize));
+  m_tx.reset(new Batch(m_opts.txBatch, m_opts.maxPktSize));
+  m_rxCount = m_rxPos = m_txCount = 0;
+  return true;
+}
+
+bool
+PosixUdpTransport::beginListen(uint16_t localPort, IPAddress localIp)
+{
+  end();
+  POSIXUDP_DBG(F("listening on ") << localIp << ':' << _DEC(localPort));
+  if (!openSocket(localIp, localPort, false)) {
+    return false;
+  }
+  m_mode = Mode::LISTEN;
+  return true;
+}
+
+bool
+PosixUdpTransport::beginTunnel(IPAddress remoteIp, uint16_t remotePort, uint16_t localPort)
+{
+  end();
+  POSIXUDP_DBG(F("connecting to ") << remoteIp << ':' << remotePort <<
+               F(" from :") << _DEC(localPort));
+  if (!openSocket(IPAddress(), localPort, false)) {
+    return false;
+  }
+  m_mode = Mode::TUNNEL;
+  m_ip = remoteIp;
+  m_port = remotePort;
+  return true;
+}
+
+bool
+PosixUdpTransport::beginMulticast(IPAddress localIp, uint16_t groupPort)
+{
+  end();
+  POSIXUDP_DBG(F("joining group ") << MCAST_GROUP << ':' << _DEC(groupPort) <<
+               F(" on ") << localIp);
+  if (!openSocket(IPAddress(), groupPort, true)) {
+    return false;
+  }
+
+  ip_mreq mreq = {};
+  mreq.imr_multiaddr.s_addr = static_cast<uint32_t>(MCAST_GROUP);
+  mreq.imr_interface.s_addr = static_cast<uint32_t>(localIp);
+  in_addr ifAddr = mreq.imr_interface;
+  if (setsockopt(m_fd, IPPROTO_IP, IP_ADD_MEMBERSHIP, &mreq, sizeof(mreq)) != 0 ||
+      setsockopt(m_fd, IPPROTO_IP, IP_MULTICAST_IF, &ifAddr, sizeof(ifAddr)) != 0) {
+    POSIXUDP_DBG(F("IP_ADD_MEMBERSHIP error ") << errno);
+    end();
+    return false;
+  }
+
+  m_mode = Mode::MULTICAST;
+  m_ip = MCAST_GROUP;
+  m_port = groupPort;
+  return true;
+}
+
+void
+PosixUdpTransport::end()
+{
+  if (m_fd >= 0) {
+    flush();
+    ::close(m_fd);
+    m_fd = -1;
+  }
+  m_mode = Mode::NONE;
+  m_ip = IPAddress();
+  m_port = 0;
+}
+
+void
+PosixUdpTransport::enableEndpointTable(uint16_t capacity)
+{
+  m_endpoints.reset(capacity == 0 ? nullptr : new EndpointTable(capacity));
+}
+
+size_t
+PosixUdpTransport::receive(uint8_t* buf, size_t bufSize, uint64_t& endpointId)
+{
+  if (m_mode == Mode::NONE) {
+    return 0;
+  }
+  while (true) {
+    if (m_rxPos == m_rxCount) {
+      // responses to the previous receive batch are transmitted together
+      if (m_txCount > 0) {
+        flush();
+      }
+      for (int i = 0; i < m_opts.rxBatch; ++i) {
+        m_rx->msg[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+      }
+      int n = recvmmsg(m_fd, m_rx->msg.data(), m_opts.rxBatch, MSG_DONTWAIT, nullptr);
+      if (n <= 0) {
+        m_rxCount = m_rxPos = 0;
+        return 0;
+      }
+      ++m_cnt.nRxSyscalls;
+      m_cnt.nRxPkts += n;
+      m_rxCount = n;
+      m_rxPos = 0;
+    }
+
+    int i = m_rxPos++;
+    const sockaddr_in& addr = m_rx->addr[i];
+    size_t len = m_rx->msg[i].msg_len;
+    if (m_mode == Mode::TUNNEL) {
+      if (addr.sin_addr.s_addr != static_cast<uint32_t>(m_ip) || ntohs(addr.sin_port) != m_port) {
+        ++m_cnt.nRxFiltered;
+        continue;
+      }
+      endpointId = 0;
+    }
+    else {
+      EndpointId endpoint = {0};
+      endpoint.ip = addr.sin_addr.s_addr;
+      endpoint.port = ntohs(addr.sin_port);
+      endpointId = endpoint.endpointId;
+    }
+
+    if ((m_rx->msg[i].msg_hdr.msg_flags & MSG_TRUNC) != 0 || len > bufSize) {
+      POSIXUDP_DBG(F("drop oversized len=") << len);
+      continue;
+    }
+    memcpy(buf, m_rx->iov[i].iov_base, len);
+    if (m_endpoints != nullptr && endpointId != 0) {
+      m_endpoints->countRx(endpointId, len);
+    }
+    return len;
+  }
+}
+
+ndn_Error
+PosixUdpTransport::send(const uint8_t* pkt, size_t len, uint64_t endpointId)
+{
+  if (m_mode == Mode::NONE) {
+    return NDN_ERROR_SocketTransport_socket_is_not_open;
+  }
+  if (len > m_opts.maxPktSize) {
+    return NDN_ERROR_SocketTransport_error_in_send;
+  }
+
+  sockaddr_in& addr = m_tx->addr[m_txCount];
+  addr = {};
+  addr.sin_family = AF_INET;
+  if (endpointId == 0) {
+    if (m_mode == Mode::LISTEN) {
+      POSIXUDP_DBG(F("remote endpoint not specified"));
+      return NDN_ERROR_SocketTransport_error_in_getaddrinfo;
+    }
+    addr.sin_addr.s_addr = static_cast<uint32_t>(m_ip);
+    addr.sin_port = htons(m_port);
+  }
+  else {
+    EndpointId endpoint;
+    endpoint.endpointId = endpointId;
+    addr.sin_addr.s_addr = endpoint.ip;
+    addr.sin_port = htons(endpoint.port);
+  }
+
+  if (m_endpoints != nullptr && endpointId != 0) {
+    m_endpoints->countTx(endpointId, len);
+  }
+  memcpy(m_tx->iov[m_txCount].iov_base, pkt, len);
+  m_tx->iov[m_txCount].iov_len = len;
+  if (++m_txCount < m_opts.txBatch) {
+    return NDN_ERROR_success;
+  }
+  return flush();
+}
+
+ndn_Error
+PosixUdpTransport::flush()
+{
+  ndn_Error e = NDN_ERROR_success;
+  int pos = 0;
+  while (pos < m_txCount) {
+    int n = sendmmsg(m_fd, &m_tx->msg[pos], m_txCount - pos, 0);
+    ++m_cnt.nTxSyscalls;
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      // skip the datagram that failed; sendmmsg reports errors only for the first datagram
+      POSIXUDP_DBG(F("sendmmsg error ") << errno);
+      ++m_cnt.nTxErrors;
+      e = NDN_ERROR_SocketTransport_error_in_send;
+      n = 1;
+    }
+    else {
+      m_cnt.nTxPkts += n;
+    }
+    pos += n;
+  }
+  m_txCount = 0;
+  return e;
+}
+
+} // namespace ndn
+
+#endif // defined(__linux__)
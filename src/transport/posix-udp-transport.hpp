@@ -0,0 +1,191 @@
+#ifndef ESP8266NDN_POSIX_UDP_TRANSPORT_HPP
+#define ESP8266NDN_POSIX_UDP_TRANSPORT_HPP
+
+#if defined(__linux__)
+
+#include "endpoint-table.hpp"
+#include "transport.hpp"
+
+#include <IPAddress.h>
+#include <memory>
+
+namespace ndn {
+
+/** \brief a transport that communicates over UDP on a Linux host
+ *
+ *  This has the same modes and EndpointId layout as UdpTransport, so that Face code and load
+ *  tests can run on Linux against a real forwarder.
+ *
+ *  The socket is non-blocking. receive() fetches up to \c Options::rxBatch datagrams per
+ *  recvmmsg syscall and returns them one at a time. send() queues up to \c Options::txBatch
+ *  datagrams and transmits them with one sendmmsg syscall when the queue is full, when
+ *  receive() has returned every datagram of the previous batch and is about to call recvmmsg,
+ *  or when flush() is invoked. Thus, Data sent in response to a burst of Interests within
+ *  Face::loop() leave in one syscall.
+ */
+class PosixUdpTransport : public Transport
+{
+public:
+  /** \brief interpretation of endpointId, same as UdpTransport::EndpointId
+   */
+  union EndpointId {
+    uint64_t endpointId;
+    struct {
+      uint32_t ip;
+      uint16_t port;
+      char _a[2];
+    };
+  };
+
+  class Options
+  {
+  public:
+    uint16_t rxBatch = 16;      ///< max datagrams per recvmmsg
+    uint16_t txBatch = 16;      ///< max datagrams per sendmmsg, 1 disables TX queuing
+    uint16_t maxPktSize = 8800; ///< receive and send buffer size per datagram
+  };
+
+  class Counters
+  {
+  public:
+    uint32_t nRxSyscalls = 0;  ///< recvmmsg calls that returned at least one datagram
+    uint32_t nRxPkts = 0;      ///< datagrams received
+    uint32_t nRxFiltered = 0;  ///< datagrams from unexpected remote in TUNNEL mode
+    uint32_t nTxSyscalls = 0;  ///< sendmmsg calls
+    uint32_t nTxPkts = 0;      ///< datagrams sent
+    uint32_t nTxErrors = 0;    ///< datagrams not sent due to socket errors
+  };
+
+  PosixUdpTransport();
+
+  explicit
+  PosixUdpTransport(const Options& options);
+
+  ~PosixUdpTransport();
+
+  /** \brief listen on a UDP port for packets from any remote endpoint
+   *  \param localPort local port
+   *  \param localIp local interface address, default is any
+   */
+  bool
+  beginListen(uint16_t localPort = 6363, IPAddress localIp = IPAddress());
+
+  /** \brief establish a UDP tunnel to a remote endpoint
+   *  \param remoteIp remote address
+   *  \param remotePort remote port
+   *  \param localPort listening port
+   */
+  bool
+  beginTunnel(IPAddress remoteIp, uint16_t remotePort = 6363, uint16_t localPort = 6363);
+
+  /** \brief join a UDP multicast group
+   *  \param localIp local interface address, default is chosen by the kernel
+   *  \param groupPort multicast group port
+   */
+  bool
+  beginMulticast(IPAddress localIp = IPAddress(), uint16_t groupPort = 56363);
+
+  /** \brief close the socket
+   */
+  void
+  end();
+
+  /** \brief enable per-endpoint state in LISTEN and MULTICAST modes
+   *  \param capacity max number of tracked endpoints, 0 disables the table
+   *  \sa UdpTransport::enableEndpointTable
+   */
+  void
+  enableEndpointTable(uint16_t capacity);
+
+  /** \brief access the endpoint table
+   *  \return the table, or nullptr if disabled
+   */
+  EndpointTable*
+  getEndpointTable()
+  {
+    return m_endpoints.get();
+  }
+
+  /** \brief receive a packet
+   *  \param[out] endpointId identity of remote endpoint
+   */
+  size_t
+  receive(uint8_t* buf, size_t bufSize, uint64_t& endpointId) final;
+
+  /** \brief queue a packet for transmission
+   *  \param endpointId identity of remote endpoint
+   *
+   *  If \p endpointId is zero: sending fails in LISTEN mode, send to remote endpoint in
+   *  TUNNEL mode, send to multicast group in MULTICAST mode.
+   */
+  ndn_Error
+  send(const uint8_t* pkt, size_t len, uint64_t endpointId) final;
+
+  /** \brief transmit queued packets
+   */
+  ndn_Error
+  flush();
+
+  /** \brief get max UDP payload that avoids IPv4 fragmentation over Ethernet
+   */
+  size_t
+  getMtu() const final
+  {
+    return 1472;
+  }
+
+  /** \brief get socket file descriptor, -1 if closed
+   *
+   *  This may be used with poll() to wait for incoming packets.
+   */
+  int
+  getFd() const
+  {
+    return m_fd;
+  }
+
+  const Counters&
+  getCounters() const
+  {
+    return m_cnt;
+  }
+
+public:
+  static const IPAddress MCAST_GROUP;
+
+private:
+  bool
+  openSocket(IPAddress localIp, uint16_t localPort, bool reuseAddr);
+
+  struct Batch;
+
+private:
+  Options m_opts;
+  int m_fd;
+
+  enum class Mode {
+    NONE,
+    LISTEN,
+    TUNNEL,
+    MULTICAST,
+  };
+  Mode m_mode;
+
+  IPAddress m_ip;  ///< remote IP in TUNNEL mode, group IP in MULTICAST mode
+  uint16_t m_port; ///< remote port in TUNNEL mode, group port in MULTICAST mode
+
+  std::unique_ptr<Batch> m_rx;
+  int m_rxCount; ///< number of datagrams in m_rx
+  int m_rxPos;   ///< next datagram to return from m_rx
+  std::unique_ptr<Batch> m_tx;
+  int m_txCount; ///< number of datagrams queued in m_tx
+
+  std::unique_ptr<EndpointTable> m_endpoints;
+  Counters m_cnt;
+};
+
+} // namespace ndn
+
+#endif // defined(__linux__)
+
+#endif // ESP8266NDN_POSIX_UDP_TRANSPORT_HPP
@@ -0,0 +1,316 @@
+#if defined(__linux__)
+
+#include "shm-transport.hpp"
+#include "../core/logger.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#define SHM_DBG(...) DBG(ShmTransport, __VA_ARGS__)
+
+namespace ndn {
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "futex word must be 32 bits");
+
+static const uint32_t SHM_MAGIC = 0x4E444E31; // "NDN1"
+static const size_t SHM_LEN_FIELD = sizeof(uint32_t);
+static const int SHM_SPIN_COUNT = 4096;
+
+struct ShmTransport::Ring
+{
+  alignas(64) std::atomic<uint32_t> head; ///< written by sender, futex word
+  std::atomic<uint32_t> isWaiting;        ///< receiver is blocked on head
+  alignas(64) std::atomic<uint32_t> tail; ///< written by receiver
+};
+
+struct ShmTransport::Region
+{
+  std::atomic<uint32_t> magic;
+  uint32_t nSlots;
+  uint32_t slotSize;
+  Ring rings[2]; ///< [0] is sent by creator, [1] is sent by attacher
+};
+
+static const size_t SHM_SLOTS_OFFSET = 512; ///< region header size
+
+static long
+futex(std::atomic<uint32_t>& word, int op, uint32_t val, const timespec* timeout)
+{
+  return syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), op, val, timeout, nullptr, 0);
+}
+
+ShmTransport::ShmTransport()
+  : m_region(nullptr)
+  , m_regionSize(0)
+  , m_nSlots(0)
+  , m_slotSize(0)
+  , m_rx(nullptr)
+  , m_tx(nullptr)
+  , m_rxSlots(nullptr)
+  , m_txSlots(nullptr)
+{
+  m_name[0] = '\0';
+}
+
+ShmTransport::~ShmTransport()
+{
+  end();
+}
+
+bool
+ShmTransport::beginCreate(const char* name, const Options& options)
+{
+  end();
+  if (strlen(name) >= sizeof(m_name) || options.slotSize <= SHM_LEN_FIELD) {
+    return false;
+  }
+
+  uint32_t nSlots = 1;
+  while (nSlots < options.nSlots) {
+    nSlots <<= 1;
+  }
+  size_t size = SHM_SLOTS_OFFSET + 2 * nSlots * options.slotSize;
+
+  shm_unlink(name);
+  int fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600);
+  if (fd < 0) {
+    SHM_DBG(F("shm_open error ") << errno);
+    return false;
+  }
+  if (ftruncate(fd, size) != 0) {
+    SHM_DBG(F("ftruncate error ") << errno);
+    ::close(fd);
+    shm_unlink(name);
+    return false;
+  }
+  strcpy(m_name, name);
+
+  // ftruncate zero-fills the region, so that both rings are empty
+  m_nSlots = nSlots;
+  m_slotSize = options.slotSize;
+  if (!mapRegion(fd, size, true)) {
+    end();
+    return false;
+  }
+  m_region->nSlots = m_nSlots;
+  m_region->slotSize = m_slotSize;
+  m_region->magic.store(SHM_MAGIC, std::memory_order_release);
+  return true;
+}
+
+bool
+ShmTransport::beginAttach(const char* name)
+{
+  end();
+  int fd = shm_open(name, O_RDWR, 0);
+  if (fd < 0) {
+    SHM_DBG(F("shm_open error ") << errno);
+    return false;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < SHM_SLOTS_OFFSET) {
+    ::close(fd);
+    return false;
+  }
+
+  const Region* header = reinterpret_cast<const Region*>(
+    mmap(nullptr, SHM_SLOTS_OFFSET, PROT_READ, MAP_SHARED, fd, 0));
+  if (header == MAP_FAILED) {
+    ::close(fd);
+    return false;
+  }
+  bool isReady = header->magic.load(std::memory_order_acquire) == SHM_MAGIC;
+  m_nSlots = header->nSlots;
+  m_slotSize = header->slotSize;
+  munmap(const_cast<Region*>(header), SHM_SLOTS_OFFSET);
+
+  size_t size = SHM_SLOTS_OFFSET + 2 * m_nSlots * m_slotSize;
+  if (!isReady || m_nSlots == 0 || (m_nSlots & (m_nSlots - 1)) != 0 ||
+      m_slotSize <= SHM_LEN_FIELD || static_cast<size_t>(st.st_size) != size) {
+    SHM_DBG(F("region not ready"));
+    ::close(fd);
+    return false;
+  }
+  return mapRegion(fd, size, false);
+}
+
+bool
+ShmTransport::mapRegion(int fd, size_t size, bool isCreator)
+{
+  static_assert(sizeof(Region) <= SHM_SLOTS_OFFSET, "");
+  void* addr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (addr == MAP_FAILED) {
+    SHM_DBG(F("mmap error ") << errno);
+    return false;
+  }
+  m_region = reinterpret_cast<Region*>(addr);
+  m_regionSize = size;
+
+  uint8_t* slots = reinterpret_cast<uint8_t*>(addr) + SHM_SLOTS_OFFSET;
+  size_t ringSize = m_nSlots * m_slotSize;
+  int txIndex = isCreator ? 0 : 1;
+  m_tx = &m_region->rings[txIndex];
+  m_rx = &m_region->rings[1 - txIndex];
+  m_txSlots = slots + txIndex * ringSize;
+  m_rxSlots = slots + (1 - txIndex) * ringSize;
+  return true;
+}
+
+void
+ShmTransport::end()
+{
+  if (m_region != nullptr) {
+    munmap(m_region, m_regionSize);
+  }
+  if (m_name[0] != '\0') {
+    shm_unlink(m_name);
+  }
+  m_region = nullptr;
+  m_regionSize = 0;
+  m_nSlots = m_slotSize = 0;
+  m_rx = m_tx = nullptr;
+  m_rxSlots = m_txSlots = nullptr;
+  m_name[0] = '\0';
+}
+
+size_t
+ShmTransport::receive(uint8_t* buf, size_t bufSize, uint64_t& endpointId)
+{
+  size_t len;
+  const uint8_t* pkt;
+  while ((pkt = peek(len)) != nullptr) {
+    if (len <= bufSize) {
+      memcpy(buf, pkt, len);
+      endpointId = 0;
+      release();
+      return len;
+    }
+    SHM_DBG(F("drop oversized len=") << len);
+    release();
+  }
+  return 0;
+}
+
+ndn_Error
+ShmTransport::send(const uint8_t* pkt, size_t len, uint64_t endpointId)
+{
+  if (m_region == nullptr) {
+    return NDN_ERROR_SocketTransport_socket_is_not_open;
+  }
+  size_t room;
+  uint8_t* slot = beginSend(room);
+  if (slot == nullptr) {
+    ++m_cnt.nTxFull;
+    return NDN_ERROR_SocketTransport_error_in_send;
+  }
+  if (len > room) {
+    return NDN_ERROR_SocketTransport_error_in_send;
+  }
+  memcpy(slot, pkt, len);
+  commitSend(len);
+  return NDN_ERROR_success;
+}
+
+size_t
+ShmTransport::getMtu() const
+{
+  return m_slotSize == 0 ? 0 : m_slotSize - SHM_LEN_FIELD;
+}
+
+const uint8_t*
+ShmTransport::peek(size_t& len) const
+{
+  if (m_region == nullptr) {
+    return nullptr;
+  }
+  uint32_t tail = m_rx->tail.load(std::memory_order_relaxed);
+  if (m_rx->head.load(std::memory_order_acquire) == tail) {
+    return nullptr;
+  }
+  const uint8_t* slot = getSlot(m_rxSlots, tail);
+  uint32_t slotLen;
+  memcpy(&slotLen, slot, SHM_LEN_FIELD);
+  len = std::min<size_t>(slotLen, m_slotSize - SHM_LEN_FIELD);
+  return slot + SHM_LEN_FIELD;
+}
+
+void
+ShmTransport::release()
+{
+  uint32_t tail = m_rx->tail.load(std::memory_order_relaxed);
+  m_rx->tail.store(tail + 1, std::memory_order_release);
+  ++m_cnt.nRxPkts;
+}
+
+uint8_t*
+ShmTransport::beginSend(size_t& room)
+{
+  if (m_region == nullptr) {
+    return nullptr;
+  }
+  uint32_t head = m_tx->head.load(std::memory_order_relaxed);
+  if (head - m_tx->tail.load(std::memory_order_acquire) >= m_nSlots) {
+    return nullptr;
+  }
+  room = m_slotSize - SHM_LEN_FIELD;
+  return getSlot(m_txSlots, head) + SHM_LEN_FIELD;
+}
+
+void
+ShmTransport::commitSend(size_t len)
+{
+  uint32_t head = m_tx->head.load(std::memory_order_relaxed);
+  uint32_t slotLen = len;
+  memcpy(getSlot(m_txSlots, head), &slotLen, SHM_LEN_FIELD);
+  // seq_cst store and load pair with those in wait(), so that a blocked receiver is always woken
+  m_tx->head.store(head + 1);
+  ++m_cnt.nTxPkts;
+  if (m_tx->isWaiting.load() != 0) {
+    futex(m_tx->head, FUTEX_WAKE, 1, nullptr);
+    ++m_cnt.nWakes;
+  }
+}
+
+bool
+ShmTransport::wait(int timeoutMs)
+{
+  if (m_region == nullptr) {
+    return false;
+  }
+  // on a multiprocessor, the peer usually answers within microseconds, and spinning briefly
+  // avoids two syscalls; on a uniprocessor, spinning only delays the peer
+  static const int spinCount = sysconf(_SC_NPROCESSORS_ONLN) > 1 ? SHM_SPIN_COUNT : 0;
+  uint32_t tail = m_rx->tail.load(std::memory_order_relaxed);
+  for (int i = 0; i < spinCount; ++i) {
+    if (m_rx->head.load(std::memory_order_acquire) != tail) {
+      return true;
+    }
+  }
+
+  m_rx->isWaiting.store(1);
+  uint32_t head = m_rx->head.load();
+  if (head == tail) {
+    timespec timeout;
+    timeout.tv_sec = timeoutMs / 1000;
+    timeout.tv_nsec = timeoutMs % 1000 * 1000000L;
+    futex(m_rx->head, FUTEX_WAIT, head, &timeout);
+    ++m_cnt.nWaits;
+    head = m_rx->head.load();
+  }
+  m_rx->isWaiting.store(0);
+  return head != tail;
+}
+
+} // namespace ndn
+
+#endif // defined(__linux__)
@@ -0,0 +1,156 @@
+#ifndef ESP8266NDN_SHM_TRANSPORT_HPP
+#define ESP8266NDN_SHM_TRANSPORT_HPP
+
+#if defined(__linux__)
+
+#include "transport.hpp"
+
+namespace ndn {
+
+/** \brief a transport that connects two processes on a Linux host through shared memory
+ *
+ *  The shared memory region contains two single-producer single-consumer rings of fixed-size
+ *  slots, one per direction. Sending and receiving do not make syscalls, except a futex wake
+ *  when the peer is blocked in wait(). This gives an upper bound of Face and codec throughput
+ *  that does not depend on the network stack.
+ *
+ *  Besides copying send() and receive(), slots may be accessed in place: peek() and release()
+ *  on the receive side, beginSend() and commitSend() on the send side.
+ */
+class ShmTransport : public Transport
+{
+public:
+  class Options
+  {
+  public:
+    uint32_t nSlots = 256;    ///< slots per direction, rounded up to a power of two
+    uint32_t slotSize = 9000; ///< slot size, including 4-octet length field
+  };
+
+  class Counters
+  {
+  public:
+    uint32_t nRxPkts = 0;  ///< packets received
+    uint32_t nTxPkts = 0;  ///< packets sent
+    uint32_t nTxFull = 0;  ///< packets dropped because send ring is full
+    uint32_t nWaits = 0;   ///< futex waits in wait()
+    uint32_t nWakes = 0;   ///< futex wakes toward a blocked peer
+  };
+
+  ShmTransport();
+
+  ~ShmTransport();
+
+  /** \brief create a shared memory region and become its first endpoint
+   *  \param name POSIX shared memory object name, such as "/ndn-bench"
+   */
+  bool
+  beginCreate(const char* name, const Options& options);
+
+  bool
+  beginCreate(const char* name)
+  {
+    return beginCreate(name, Options());
+  }
+
+  /** \brief attach to a shared memory region created by another ShmTransport
+   *
+   *  This fails if the region does not exist or has not been initialized yet.
+   */
+  bool
+  beginAttach(const char* name);
+
+  /** \brief detach from the shared memory region
+   *
+   *  The creator also unlinks the shared memory object.
+   */
+  void
+  end();
+
+  /** \brief receive a packet
+   *  \param[out] endpointId always zero
+   */
+  size_t
+  receive(uint8_t* buf, size_t bufSize, uint64_t& endpointId) final;
+
+  /** \brief send a packet
+   *  \param endpointId ignored
+   */
+  ndn_Error
+  send(const uint8_t* pkt, size_t len, uint64_t endpointId) final;
+
+  /** \brief get max packet size that fits in a slot
+   */
+  size_t
+  getMtu() const final;
+
+  /** \brief access the oldest received packet in place
+   *  \param[out] len packet length
+   *  \return packet, or nullptr if none available
+   *
+   *  The packet stays valid until release().
+   */
+  const uint8_t*
+  peek(size_t& len) const;
+
+  /** \brief return the slot obtained from peek() to the sender
+   */
+  void
+  release();
+
+  /** \brief obtain a free slot for encoding a packet in place
+   *  \param[out] room slot capacity
+   *  \return slot buffer, or nullptr if send ring is full
+   */
+  uint8_t*
+  beginSend(size_t& room);
+
+  /** \brief publish the packet encoded in the slot from beginSend()
+   *  \param len packet length
+   */
+  void
+  commitSend(size_t len);
+
+  /** \brief block until a packet is available to receive, or \p timeoutMs has elapsed
+   *  \return whether a packet is available
+   */
+  bool
+  wait(int timeoutMs);
+
+  const Counters&
+  getCounters() const
+  {
+    return m_cnt;
+  }
+
+private:
+  struct Ring;
+  struct Region;
+
+  bool
+  mapRegion(int fd, size_t size, bool isCreator);
+
+  uint8_t*
+  getSlot(uint8_t* slots, uint32_t index) const
+  {
+    return &slots[(index & (m_nSlots - 1)) * m_slotSize];
+  }
+
+private:
+  Region* m_region;
+  size_t m_regionSize;
+  uint32_t m_nSlots;   ///< copied from region, so that the peer cannot alter it
+  uint32_t m_slotSize;
+  Ring* m_rx;
+  Ring* m_tx;
+  uint8_t* m_rxSlots;
+  uint8_t* m_txSlots;
+  char m_name[64]; ///< shared memory object name, non-empty if this is the creator
+  Counters m_cnt;
+};
+
+} // namespace ndn
+
+#endif // defined(__linux__)
+
+#endif // ESP8266NDN_SHM_TRANSPORT_HPP
@@ -0,0 +1,255 @@
+#if defined(__linux__) || defined(ESP32)
+
+#include "stream-transport.hpp"
+#include "../core/logger.hpp"
+#include "../ndn-cpp/c/encoding/tlv/tlv-structure-decoder.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <unistd.h>
+
+#if defined(ESP32)
+#include <lwip/sockets.h>
+#else
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#endif
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+#define STREAM_DBG(...) DBG(StreamTransport, __VA_ARGS__)
+
+namespace ndn {
+
+StreamTransport::StreamTransport()
+  : StreamTransport(Options())
+{
+}
+
+StreamTransport::StreamTransport(const Options& options)
+  : m_opts(options)
+  , m_fd(-1)
+  , m_rxStart(0)
+  , m_rxEnd(0)
+  , m_txHead(0)
+  , m_txLen(0)
+{
+  ndn_TlvStructureDecoder_initialize(&m_decoder);
+}
+
+StreamTransport::~StreamTransport()
+{
+  end();
+}
+
+bool
+StreamTransport::beginTcp(IPAddress remoteIp, uint16_t remotePort)
+{
+  STREAM_DBG(F("connecting to ") << remoteIp << ':' << _DEC(remotePort));
+  sockaddr_in addr = {};
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = static_cast<uint32_t>(remoteIp);
+  addr.sin_port = htons(remotePort);
+  return openSocket(AF_INET, &addr, sizeof(addr));
+}
+
+#if defined(__linux__)
+bool
+StreamTransport::beginUnix(const char* path)
+{
+  STREAM_DBG(F("connecting to ") << path);
+  sockaddr_un addr = {};
+  addr.sun_family = AF_UNIX;
+  if (strlen(path) >= sizeof(addr.sun_path)) {
+    return false;
+  }
+  strcpy(addr.sun_path, path);
+  return openSocket(AF_UNIX, &addr, sizeof(addr));
+}
+#endif // defined(__linux__)
+
+bool
+StreamTransport::openSocket(int domain, const void* addr, size_t addrLen)
+{
+  end();
+  int fd = socket(domain, SOCK_STREAM, 0);
+  if (fd < 0) {
+    STREAM_DBG(F("socket error ") << errno);
+    return false;
+  }
+  if (connect(fd, reinterpret_cast<const sockaddr*>(addr), addrLen) != 0) {
+    STREAM_DBG(F("connect error ") << errno);
+    ::close(fd);
+    return false;
+  }
+  return begin(fd);
+}
+
+bool
+StreamTransport::begin(int fd)
+{
+  end();
+  if (fd < 0) {
+    return false;
+  }
+
+  // fails harmlessly on Unix sockets
+  int one = 1;
+  setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+  if (m_rxBuf == nullptr) {
+    m_rxBuf.reset(new uint8_t[m_opts.rxBufSize]);
+    m_txBuf.reset(new uint8_t[m_opts.txBufSize]);
+  }
+  m_fd = fd;
+  return true;
+}
+
+void
+StreamTransport::end()
+{
+  if (m_fd >= 0) {
+    ::close(m_fd);
+    m_fd = -1;
+  }
+  m_rxStart = m_rxEnd = 0;
+  ndn_TlvStructureDecoder_reset(&m_decoder);
+  m_txHead = m_txLen = 0;
+}
+
+void
+StreamTransport::fail()
+{
+  STREAM_DBG(F("connection closed, errno=") << errno);
+  end();
+}
+
+size_t
+StreamTransport::receive(uint8_t* buf, size_t bufSize, uint64_t& endpointId)
+{
+  if (m_fd < 0 || (m_txLen > 0 && !flushTx())) {
+    return 0;
+  }
+  endpointId = 0;
+
+  while (true) {
+    if (m_rxEnd > m_rxStart) {
+      ndn_Error e = ndn_TlvStructureDecoder_findElementEnd(&m_decoder, &m_rxBuf[m_rxStart],
+                                                           m_rxEnd - m_rxStart);
+      if (e != NDN_ERROR_success) {
+        ++m_cnt.nRxErrors;
+        STREAM_DBG(F("framing error ") << ndn_getErrorString(e));
+        fail();
+        return 0;
+      }
+      if (m_decoder.gotElementEnd) {
+        const uint8_t* element = &m_rxBuf[m_rxStart];
+        size_t len = m_decoder.offset;
+        m_rxStart += len;
+        ndn_TlvStructureDecoder_reset(&m_decoder);
+        ++m_cnt.nRxPkts;
+        if (len > bufSize) {
+          STREAM_DBG(F("drop oversized len=") << len);
+          continue;
+        }
+        memcpy(buf, element, len);
+        return len;
+      }
+    }
+
+    // only an incomplete element remains; move it to the front, so that it stays contiguous
+    if (m_rxStart > 0) {
+      memmove(&m_rxBuf[0], &m_rxBuf[m_rxStart], m_rxEnd - m_rxStart);
+      m_rxEnd -= m_rxStart;
+      m_rxStart = 0;
+    }
+    if (m_rxEnd == m_opts.rxBufSize) {
+      ++m_cnt.nRxErrors;
+      STREAM_DBG(F("element exceeds receive buffer"));
+      fail();
+      return 0;
+    }
+
+    ssize_t n = recv(m_fd, &m_rxBuf[m_rxEnd], m_opts.rxBufSize - m_rxEnd, MSG_DONTWAIT);
+    if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) {
+      return 0;
+    }
+    if (n <= 0) {
+      fail();
+      return 0;
+    }
+    ++m_cnt.nRxSyscalls;
+    m_rxEnd += n;
+  }
+}
+
+ndn_Error
+StreamTransport::send(const uint8_t* pkt, size_t len, uint64_t endpointId)
+{
+  if (m_fd < 0) {
+    return NDN_ERROR_SocketTransport_socket_is_not_open;
+  }
+  if (len > m_opts.txBufSize - m_txLen && (!flushTx() || len > m_opts.txBufSize - m_txLen)) {
+    ++m_cnt.nTxFull;
+    return NDN_ERROR_SocketTransport_error_in_send;
+  }
+
+  size_t tail = (m_txHead + m_txLen) % m_opts.txBufSize;
+  size_t first = std::min(len, m_opts.txBufSize - tail);
+  memcpy(&m_txBuf[tail], pkt, first);
+  memcpy(&m_txBuf[0], pkt + first, len - first);
+  m_txLen += len;
+  ++m_cnt.nTxPkts;
+
+  if (!flushTx()) {
+    return NDN_ERROR_SocketTransport_error_in_send;
+  }
+  return NDN_ERROR_success;
+}
+
+bool
+StreamTransport::flushTx()
+{
+  while (m_txLen > 0) {
+    iovec iov[2];
+    size_t first = std::min(m_txLen, m_opts.txBufSize - m_txHead);
+    iov[0].iov_base = &m_txBuf[m_txHead];
+    iov[0].iov_len = first;
+    iov[1].iov_base = &m_txBuf[0];
+    iov[1].iov_len = m_txLen - first;
+    msghdr msg = {};
+    msg.msg_iov = iov;
+    msg.msg_iovlen = iov[1].iov_len > 0 ? 2 : 1;
+
+    ssize_t n = sendmsg(m_fd, &msg, MSG_DONTWAIT | MSG_NOSIGNAL);
+    ++m_cnt.nTxSyscalls;
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      if (errno == EAGAIN || errno == EWOULDBLOCK) {
+        return true;
+      }
+      fail();
+      return false;
+    }
+
+    m_txHead = (m_txHead + n) % m_opts.txBufSize;
+    m_txLen -= n;
+    if (m_txLen > 0) {
+      // socket buffer is full, retry in next send() or receive()
+      return true;
+    }
+  }
+  m_txHead = 0;
+  return true;
+}
+
+} // namespace ndn
+
+#endif // defined(__linux__) || defined(ESP32)
@@ -0,0 +1,161 @@
+#ifndef ESP8266NDN_STREAM_TRANSPORT_HPP
+#define ESP8266NDN_STREAM_TRANSPORT_HPP
+
+#if defined(__linux__) || defined(ESP32)
+
+#include "transport.hpp"
+#include "../ndn-cpp/c/encoding/element-reader-types.h"
+
+#include <IPAddress.h>
+#include <memory>
+
+namespace ndn {
+
+/** \brief a transport that communicates over a stream socket, such as a TCP connection to NFD
+ *
+ *  Incoming octets are appended to a receive buffer and framed into TLV elements with
+ *  ndn_TlvStructureDecoder, the decoder behind ndn_ElementReader. The decoder keeps its
+ *  position across receive() calls, so a partially received element is never scanned twice,
+ *  and the value octets of a large element are skipped without inspection.
+ *
+ *  Outgoing packets are appended to a ring buffer and written with one gather syscall per
+ *  send(), covering both segments when the ring wraps around. The socket never blocks:
+ *  if the peer is slow, packets accumulate in the ring until it is full.
+ *
+ *  This transport is available on Linux and ESP32, which both provide BSD sockets.
+ */
+class StreamTransport : public Transport
+{
+public:
+  class Options
+  {
+  public:
+    size_t rxBufSize = 2 * 8800; ///< receive buffer size, must exceed max packet size
+    size_t txBufSize = 4 * 8800; ///< transmit ring buffer size
+  };
+
+  class Counters
+  {
+  public:
+    uint32_t nRxSyscalls = 0;  ///< recv calls that returned data
+    uint32_t nRxPkts = 0;      ///< TLV elements received
+    uint32_t nRxErrors = 0;    ///< framing errors, each closes the connection
+    uint32_t nTxSyscalls = 0;  ///< sendmsg calls
+    uint32_t nTxPkts = 0;      ///< packets accepted into transmit buffer
+    uint32_t nTxFull = 0;      ///< packets dropped because transmit buffer is full
+  };
+
+  StreamTransport();
+
+  explicit
+  StreamTransport(const Options& options);
+
+  ~StreamTransport();
+
+  /** \brief connect to a TCP server
+   *  \param remoteIp remote address
+   *  \param remotePort remote port
+   *
+   *  This blocks until the connection is established or refused.
+   */
+  bool
+  beginTcp(IPAddress remoteIp, uint16_t remotePort = 6363);
+
+#if defined(__linux__)
+  /** \brief connect to a Unix stream socket
+   *  \param path socket path
+   */
+  bool
+  beginUnix(const char* path = "/run/nfd/nfd.sock");
+#endif // defined(__linux__)
+
+  /** \brief use an already connected stream socket
+   *
+   *  StreamTransport takes ownership of \p fd, and closes it in end().
+   */
+  bool
+  begin(int fd);
+
+  /** \brief close the connection
+   */
+  void
+  end();
+
+  /** \brief determine whether the connection is open
+   *
+   *  The connection is closed when the peer closes it, on socket errors, and on framing errors.
+   */
+  bool
+  isConnected() const
+  {
+    return m_fd >= 0;
+  }
+
+  /** \brief receive a packet
+   *  \param[out] endpointId always zero
+   */
+  size_t
+  receive(uint8_t* buf, size_t bufSize, uint64_t& endpointId) final;
+
+  /** \brief send a packet
+   *  \param endpointId ignored
+   */
+  ndn_Error
+  send(const uint8_t* pkt, size_t len, uint64_t endpointId) final;
+
+  /** \brief get number of octets waiting in transmit buffer
+   */
+  size_t
+  getTxPending() const
+  {
+    return m_txLen;
+  }
+
+  /** \brief get socket file descriptor, -1 if closed
+   */
+  int
+  getFd() const
+  {
+    return m_fd;
+  }
+
+  const Counters&
+  getCounters() const
+  {
+    return m_cnt;
+  }
+
+private:
+  bool
+  openSocket(int domain, const void* addr, size_t addrLen);
+
+  /** \brief write pending octets of transmit ring
+   *  \return false if the connection has failed
+   */
+  bool
+  flushTx();
+
+  void
+  fail();
+
+private:
+  Options m_opts;
+  int m_fd;
+
+  std::unique_ptr<uint8_t[]> m_rxBuf;
+  size_t m_rxStart; ///< start of current element in m_rxBuf
+  size_t m_rxEnd;   ///< end of received octets in m_rxBuf
+  ndn_TlvStructureDecoder m_decoder; ///< offset is relative to m_rxStart
+
+  std::unique_ptr<uint8_t[]> m_txBuf;
+  size_t m_txHead; ///< first pending octet in m_txBuf
+  size_t m_txLen;  ///< number of pending octets
+
+  Counters m_cnt;
+};
+
+} // namespace ndn
+
+#endif // defined(__linux__) || defined(ESP32)
+
+#endif // ESP8266NDN_STREAM_TRANSPORT_HPP
@@ -28,6 +28,28 @@ public:
    */
   virtual ndn_Error
   send(const uint8_t* pkt, size_t len, uint64_t endpointId) = 0;
+
+  /** \brief get maximum packet size accepted by send()
+   *  \return MTU in octets, or zero if unlimited
+   *
+   *  Face fragments packets larger than MTU with NDNLPv2.
+   */
+  virtual size_t
+  getMtu() const
+  {
+    return 0;
+  }
+
+  /** \brief determine whether send() can be invoked without waiting for a transmission
+   *
+   *  A transport whose send() returns before transmission completes returns false until the
+   *  previous transmission has completed. TxQueue uses this to schedule queued packets.
+   */
+  virtual bool
+  isTxReady()
+  {
+    return true;
+  }
 };
 
 } // namespace ndn
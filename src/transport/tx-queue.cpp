@@ -0,0 +1,125 @@
+#include "tx-queue.hpp"
+#include "../core/logger.hpp"
+
+#include <cstring>
+
+#define TXQUEUE_DBG(...) DBG(TxQueue, __VA_ARGS__)
+
+namespace ndn {
+
+TxQueue::TxQueue(Transport& inner)
+  : TxQueue(inner, Options())
+{
+}
+
+TxQueue::TxQueue(Transport& inner, const Options& options)
+  : inner(inner)
+  , m_opts(options)
+  , m_head(0)
+  , m_count(0)
+  , m_isInFlight(false)
+  , m_cb(nullptr)
+  , m_cbArg(nullptr)
+{
+  if (m_opts.maxPkts == 0) {
+    m_opts.maxPkts = 1;
+  }
+  m_items.reset(new Item[m_opts.maxPkts]);
+  m_buf.reset(new uint8_t[m_opts.bufSize]);
+}
+
+TxQueue::~TxQueue() = default;
+
+size_t
+TxQueue::receive(uint8_t* buf, size_t bufSize, uint64_t& endpointId)
+{
+  loop();
+  return inner.receive(buf, bufSize, endpointId);
+}
+
+ndn_Error
+TxQueue::send(const uint8_t* pkt, size_t len, uint64_t endpointId)
+{
+  return sendAsync(pkt, len, endpointId, m_cb, m_cbArg);
+}
+
+ndn_Error
+TxQueue::sendAsync(const uint8_t* pkt, size_t len, uint64_t endpointId, TxCallback cb, void* arg)
+{
+  if (len == 0 || len > m_opts.bufSize) {
+    return NDN_ERROR_TLV_length_exceeds_buffer_length;
+  }
+
+  // packet storage is a ring; a packet never wraps, so the tail room is skipped if too small
+  size_t offset = 0;
+  bool hasRoom = m_count < m_opts.maxPkts;
+  if (hasRoom && m_count > 0) {
+    const Item& front = m_items[m_head];
+    const Item& back = m_items[(m_head + m_count - 1) % m_opts.maxPkts];
+    size_t end = back.offset + back.len;
+    if (back.offset >= front.offset) {
+      if (m_opts.bufSize - end >= len) {
+        offset = end;
+      }
+      else {
+        hasRoom = front.offset >= len;
+      }
+    }
+    else {
+      offset = end;
+      hasRoom = front.offset - end >= len;
+    }
+  }
+  if (!hasRoom) {
+    ++m_cnt.nFull;
+    TXQUEUE_DBG(F("full len=") << len << F(" count=") << m_count);
+    return NDN_ERROR_SocketTransport_error_in_send;
+  }
+
+  Item& item = m_items[(m_head + m_count) % m_opts.maxPkts];
+  item.endpointId = endpointId;
+  item.cb = cb;
+  item.arg = arg;
+  item.offset = offset;
+  item.len = len;
+  std::memcpy(&m_buf[offset], pkt, len);
+  ++m_count;
+  ++m_cnt.nQueued;
+  return NDN_ERROR_success;
+}
+
+void
+TxQueue::loop()
+{
+  while (m_count > 0 && inner.isTxReady()) {
+    if (m_isInFlight) {
+      m_isInFlight = false;
+      complete(NDN_ERROR_success);
+      continue;
+    }
+
+    const Item& item = m_items[m_head];
+    ndn_Error e = inner.send(&m_buf[item.offset], item.len, item.endpointId);
+    if (e != NDN_ERROR_success) {
+      ++m_cnt.nErrors;
+      TXQUEUE_DBG(F("send err=") << e);
+      complete(e);
+      continue;
+    }
+    ++m_cnt.nSent;
+    m_isInFlight = true;
+  }
+}
+
+void
+TxQueue::complete(ndn_Error error)
+{
+  Item item = m_items[m_head];
+  m_head = (m_head + 1) % m_opts.maxPkts;
+  --m_count;
+  if (item.cb != nullptr) {
+    item.cb(item.arg, error);
+  }
+}
+
+} // namespace ndn
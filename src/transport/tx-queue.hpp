@@ -0,0 +1,149 @@
+#ifndef ESP8266NDN_TX_QUEUE_HPP
+#define ESP8266NDN_TX_QUEUE_HPP
+
+#include "transport.hpp"
+
+#include <memory>
+
+namespace ndn {
+
+/** \brief a transport wrapper that queues outgoing packets until the inner transport is ready
+ *
+ *  send() copies the packet into a bounded queue and returns immediately. Queued packets are
+ *  passed to the inner transport whenever inner.isTxReady() returns true, which happens in
+ *  receive() so that Face::loop() drives transmissions, or in loop(). If the inner transport
+ *  starts a transmission and returns before it completes, such as LoraTransport in async mode,
+ *  Face keeps processing received packets while the radio transmits.
+ *
+ *  Each packet may carry a completion callback, invoked with NDN_ERROR_success after the inner
+ *  transport has finished transmitting it, or with the error code returned by inner.send().
+ *  The callback may queue another packet.
+ *
+ *  TxQueue should be placed directly over the transport whose readiness it follows. Wrappers
+ *  that send several packets at once, such as LiteFrag and LpReliability, go above TxQueue.
+ */
+class TxQueue : public Transport
+{
+public:
+  /** \brief completion callback
+   *  \param arg argument passed to sendAsync() or setTxCallback()
+   *  \param error transmission result
+   */
+  typedef void (*TxCallback)(void* arg, ndn_Error error);
+
+  class Options
+  {
+  public:
+    uint16_t maxPkts = 8;     ///< max number of queued packets
+    uint16_t bufSize = 4096;  ///< octets of packet storage
+  };
+
+  class Counters
+  {
+  public:
+    uint32_t nQueued = 0;   ///< packets accepted into the queue
+    uint32_t nFull = 0;     ///< packets rejected because the queue is full
+    uint32_t nSent = 0;     ///< packets transmitted by inner transport
+    uint32_t nErrors = 0;   ///< packets rejected by inner transport
+  };
+
+  explicit
+  TxQueue(Transport& inner);
+
+  TxQueue(Transport& inner, const Options& options);
+
+  ~TxQueue();
+
+  /** \brief receive a packet from inner transport, after transmitting queued packets
+   */
+  size_t
+  receive(uint8_t* buf, size_t bufSize, uint64_t& endpointId) final;
+
+  /** \brief queue a packet, to be completed with the callback set by setTxCallback()
+   *  \retval NDN_ERROR_SocketTransport_error_in_send the queue is full
+   */
+  ndn_Error
+  send(const uint8_t* pkt, size_t len, uint64_t endpointId) final;
+
+  /** \brief queue a packet with a completion callback
+   *  \param cb completion callback, nullptr to skip notification
+   *  \retval NDN_ERROR_SocketTransport_error_in_send the queue is full; \p cb is not invoked
+   */
+  ndn_Error
+  sendAsync(const uint8_t* pkt, size_t len, uint64_t endpointId, TxCallback cb, void* arg);
+
+  /** \brief set completion callback for packets queued with send()
+   */
+  void
+  setTxCallback(TxCallback cb, void* arg)
+  {
+    m_cb = cb;
+    m_cbArg = arg;
+  }
+
+  /** \brief transmit queued packets while inner transport is ready
+   */
+  void
+  loop();
+
+  /** \brief determine whether the queue can accept another packet
+   */
+  bool
+  isTxReady() final
+  {
+    return m_count < m_opts.maxPkts;
+  }
+
+  size_t
+  getMtu() const final
+  {
+    return inner.getMtu();
+  }
+
+  /** \brief get number of queued packets, including the one being transmitted
+   */
+  size_t
+  size() const
+  {
+    return m_count;
+  }
+
+  const Counters&
+  getCounters() const
+  {
+    return m_cnt;
+  }
+
+private:
+  struct Item
+  {
+    uint64_t endpointId;
+    TxCallback cb;
+    void* arg;
+    uint16_t offset;
+    uint16_t len;
+  };
+
+  /** \brief remove the front item and invoke its callback
+   */
+  void
+  complete(ndn_Error error);
+
+public:
+  Transport& inner;
+
+private:
+  Options m_opts;
+  std::unique_ptr<Item[]> m_items;
+  std::unique_ptr<uint8_t[]> m_buf;
+  uint16_t m_head;        ///< index of front item
+  uint16_t m_count;       ///< number of items
+  bool m_isInFlight;      ///< front item has been passed to inner transport
+  TxCallback m_cb;
+  void* m_cbArg;
+  Counters m_cnt;
+};
+
+} // namespace ndn
+
+#endif // ESP8266NDN_TX_QUEUE_HPP
@@ -78,6 +78,12 @@ UdpTransport::end()
   m_udp.stop();
 }
 
+void
+UdpTransport::enableEndpointTable(uint16_t capacity)
+{
+  m_endpoints.reset(capacity == 0 ? nullptr : new EndpointTable(capacity));
+}
+
 size_t
 UdpTransport::receive(uint8_t* buf, size_t bufSize, uint64_t& endpointId)
 {
@@ -104,6 +110,9 @@ UdpTransport::receive(uint8_t* buf, size_t bufSize, uint64_t& endpointId)
     if (len <= 0) {
       continue;
     }
+    if (m_endpoints != nullptr && endpointId != 0) {
+      m_endpoints->countRx(endpointId, len);
+    }
     return static_cast<size_t>(len);
   }
   return 0;
@@ -153,6 +162,9 @@ UdpTransport::send(const uint8_t* pkt, size_t len, uint64_t endpointId)
     return NDN_ERROR_SocketTransport_error_in_send;
   }
 
+  if (m_endpoints != nullptr && endpointId != 0) {
+    m_endpoints->countTx(endpointId, len);
+  }
   return NDN_ERROR_success;
 }
 
@@ -3,6 +3,7 @@
 
 #if defined(ESP8266) || defined(ESP32)
 
+#include "endpoint-table.hpp"
 #include "transport.hpp"
 
 #if defined(ESP8266)
@@ -59,6 +60,24 @@ public:
   void
   end();
 
+  /** \brief enable per-endpoint state in LISTEN and MULTICAST modes
+   *  \param capacity max number of tracked endpoints, 0 disables the table
+   *
+   *  Each received packet refreshes its sender's entry, evicting the least recently seen
+   *  endpoint if the table is full. Sending to a tracked endpoint updates its TX counters.
+   */
+  void
+  enableEndpointTable(uint16_t capacity);
+
+  /** \brief access the endpoint table
+   *  \return the table, or nullptr if disabled
+   */
+  EndpointTable*
+  getEndpointTable()
+  {
+    return m_endpoints.get();
+  }
+
   /** \begin receive a packet
    *  \param[out] endpointId identity of remote endpoint
    */
@@ -74,6 +93,14 @@ public:
   ndn_Error
   send(const uint8_t* pkt, size_t len, uint64_t endpointId) final;
 
+  /** \brief get max UDP payload that avoids IPv4 fragmentation over Ethernet or WiFi
+   */
+  size_t
+  getMtu() const final
+  {
+    return 1472;
+  }
+
 public:
   static const IPAddress MCAST_GROUP;
 
@@ -90,6 +117,8 @@ private:
 
   IPAddress m_ip;  ///< remote IP in TUNNEL mode, local IP in MULTICAST mode
   uint16_t m_port; ///< remote port in TUNNEL mode, group port in MULTICAST mode
+
+  std::unique_ptr<EndpointTable> m_endpoints;
 };
 
 } // namespace ndn
@@ -48,7 +48,7 @@ sed -i '/#define round/ d' c/common.h
 sed -i '/#ifdef ARDUINO/ c\#if 0' lite/util/crypto-lite.cpp
 
 # fix time library
-sed -i -e '1 i\#include <Arduino.h>\nextern "C" {\n#define NDN_CPP_HAVE_TIME_H 1\n#define NDN_CPP_HAVE_GMTIME_SUPPORT 1' -e '/^ndn_getNowMilliseconds/ p' -e '/^ndn_getNowMilliseconds/ a\{\n  return millis();\n}' -e '/^ndn_getNowMilliseconds/,/}/ d' -e 's/timegm/mktime/' -e '$ a} // extern "C"' c/util/time.c
+sed -i -e '1 i\#include <Arduino.h>\n#include "../../../core/clock.hpp"\nextern "C" {\n#define NDN_CPP_HAVE_TIME_H 1\n#define NDN_CPP_HAVE_GMTIME_SUPPORT 1' -e '/^ndn_getNowMilliseconds/ p' -e '/^ndn_getNowMilliseconds/ a\{\n  return ::ndn::getClock().getMillis();\n}' -e '/^ndn_getNowMilliseconds/,/}/ d' -e 's/timegm/mktime/' -e '$ a} // extern "C"' c/util/time.c
 mv c/util/time.c c/util/time.cpp
 
 # fix keyLocator->type